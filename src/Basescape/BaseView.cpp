@@ -114,7 +114,7 @@ void BaseView::setBase(Base *base)
 		}
 	}
 
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -240,6 +240,7 @@ void CraftEquipmentState::init()
 	State::init();
 
 	_game->getSavedGame()->setBattleGame(0);
+	_game->getMod()->unloadBattlescapeScope();
 
 	Craft *c = _base->getCrafts()->at(_craft);
 	c->setInBattlescape(false);
@@ -831,7 +832,7 @@ void CraftEquipmentState::btnClearClick(Action *)
 	if (_game->getSavedGame()->getMonthsPassed() == -1)
 	{
 		Craft* c = _base->getCrafts()->at(_craft);
-		c->getItems()->getContents()->clear();
+		c->getItems()->clear();
 	}
 }
 
@@ -864,7 +865,7 @@ void CraftEquipmentState::saveGlobalLoadout(int index)
 {
 	// clear the template
 	ItemContainer *tmpl = _game->getSavedGame()->getGlobalCraftLoadout(index);
-	tmpl->getContents()->clear();
+	tmpl->clear();
 
 	Craft *c = _base->getCrafts()->at(_craft);
 	// save only what is visible on the screen (can be DIFFERENT than what's really in the craft for various reasons)
@@ -913,30 +914,27 @@ void CraftEquipmentState::loadGlobalLoadout(int index)
 	Craft *c = _base->getCrafts()->at(_craft);
 	std::string craftName = c->getName(_game->getLanguage());
 	std::vector<ReequipStat> _missingItems;
-	for (auto& templateItem : *tmpl->getContents())
+	for (auto& templateItem : tmpl->getContents())
 	{
-		RuleItem *item = _game->getMod()->getItem(templateItem.first, false);
-		if (item)
+		RuleItem *item = templateItem.first;
+		int tQty = templateItem.second;
+		int cQty = 0;
+		if (item->getVehicleUnit())
 		{
-			int tQty = templateItem.second;
-			int cQty = 0;
-			if (item->getVehicleUnit())
-			{
-				// Note: we will also report HWPs as missing:
-				// - if there is not enough ammo to arm them
-				// - if there is not enough cargo space in the craft
-				cQty = c->getVehicleCount(item->getName());
-			}
-			else
-			{
-				cQty = c->getItems()->getItem(item->getName());
-			}
-			int missing = tQty - cQty;
-			if (missing > 0)
-			{
-				ReequipStat stat = { item->getName(), missing, craftName, item->getListOrder() };
-				_missingItems.push_back(stat);
-			}
+			// Note: we will also report HWPs as missing:
+			// - if there is not enough ammo to arm them
+			// - if there is not enough cargo space in the craft
+			cQty = c->getVehicleCount(item->getName());
+		}
+		else
+		{
+			cQty = c->getItems()->getItem(item);
+		}
+		int missing = tQty - cQty;
+		if (missing > 0)
+		{
+			ReequipStat stat = { item->getName(), missing, craftName, item->getListOrder() };
+			_missingItems.push_back(stat);
 		}
 	}
 
@@ -52,7 +52,7 @@ MiniBaseView::~MiniBaseView()
 void MiniBaseView::setBases(std::vector<Base*> *bases)
 {
 	_bases = bases;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -82,7 +82,7 @@ size_t MiniBaseView::getHoveredBase() const
 void MiniBaseView::setSelectedBase(size_t base)
 {
 	_base = base;
-	_redraw = true;
+	invalidate();
 }
 
 /**
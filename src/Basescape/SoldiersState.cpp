@@ -327,6 +327,7 @@ void SoldiersState::init()
 
 	// resets the savegame when coming back from the inventory
 	_game->getSavedGame()->setBattleGame(0);
+	_game->getMod()->unloadBattlescapeScope();
 	_base->setInBattlescape(false);
 
 	_base->prepareSoldierStatsWithBonuses(); // refresh stats for sorting
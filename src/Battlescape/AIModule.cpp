@@ -28,8 +28,10 @@
 #include "BattlescapeState.h"
 #include "../Savegame/Tile.h"
 #include "Pathfinding.h"
+#include "PathfindingCostField.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Logger.h"
+#include "../Engine/FrameProfiler.h"
 #include "../Engine/Game.h"
 #include "../Mod/Armor.h"
 #include "../Mod/Mod.h"
@@ -79,6 +81,34 @@ AIModule::~AIModule()
 	delete _psiAction;
 }
 
+/**
+ * Finds the tiles the unit can reach and keeps them for the AI cycle.
+ * @param reachable Where to keep them.
+ * @param cost The cost of the action the unit wants to keep TUs and energy for.
+ */
+void AIModule::setReachable(ReachableTiles &reachable, const BattleActionCost &cost)
+{
+	reachable.cost = cost;
+	reachable.field = &_save->getPathfinding()->findReachable(_unit, cost);
+	reachable.generation = reachable.field->getGeneration();
+}
+
+/**
+ * Gets the tiles the unit can reach, finding them again if Pathfinding
+ * dropped them since (eg. a door opened) or reused their storage.
+ * @param reachable Tiles kept by setReachable().
+ * @return The cost field, or null if none was kept.
+ */
+const PathfindingCostField *AIModule::getReachable(ReachableTiles &reachable) const
+{
+	if (reachable.field && reachable.field->getGeneration() != reachable.generation)
+	{
+		reachable.field = &_save->getPathfinding()->findReachable(_unit, reachable.cost);
+		reachable.generation = reachable.field->getGeneration();
+	}
+	return reachable.field;
+}
+
 /**
  * Resets the unsaved AI state.
  */
@@ -200,6 +230,7 @@ void AIModule::dont_think(BattleAction *action)
  */
 void AIModule::think(BattleAction *action)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_AI, _unit->getId());
 	action->type = BA_RETHINK;
 	action->actor = _unit;
 	action->weapon = _unit->getMainHandWeapon(false);
@@ -214,7 +245,8 @@ void AIModule::think(BattleAction *action)
 	_melee = (_unit->getUtilityWeapon(BT_MELEE) != 0);
 	_rifle = false;
 	_blaster = false;
-	_reachable = _save->getPathfinding()->findReachable(_unit, BattleActionCost());
+	setReachable(_reachable, BattleActionCost());
+	_reachableWithAttack.field = 0;
 	_wasHitBy.clear();
 	_foundBaseModuleToDestroy = false;
 
@@ -269,18 +301,18 @@ void AIModule::think(BattleAction *action)
 				if (action->weapon->getCurrentWaypoints() != 0)
 				{
 					_blaster = true;
-					_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, BattleActionCost(BA_AIMEDSHOT, _unit, action->weapon));
+					setReachable(_reachableWithAttack, BattleActionCost(BA_AIMEDSHOT, _unit, action->weapon));
 				}
 				else
 				{
 					_rifle = true;
-					_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, BattleActionCost(BA_SNAPSHOT, _unit, action->weapon));
+					setReachable(_reachableWithAttack, BattleActionCost(BA_SNAPSHOT, _unit, action->weapon));
 				}
 			}
 			else if (rule->getBattleType() == BT_MELEE)
 			{
 				_melee = true;
-				_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, BattleActionCost(BA_HIT, _unit, action->weapon));
+				setReachable(_reachableWithAttack, BattleActionCost(BA_HIT, _unit, action->weapon));
 			}
 		}
 		else
@@ -698,7 +730,7 @@ void AIModule::setupAmbush()
 			Position pos = (*i)->getPosition();
 			Tile *tile = _save->getTile(pos);
 			if (tile == 0 || Position::distance2d(pos, _unit->getPosition()) > 10 || pos.z != _unit->getPosition().z || tile->getDangerous() ||
-				std::find(_reachableWithAttack.begin(), _reachableWithAttack.end(), _save->getTileIndex(pos))  == _reachableWithAttack.end())
+				!_reachableWithAttack.field || !getReachable(_reachableWithAttack)->isReachable(pos))
 				continue; // just ignore unreachable tiles
 
 			if (_traceAI)
@@ -712,10 +744,9 @@ void AIModule::setupAmbush()
 			Position target;
 			if (!_save->getTileEngine()->canTargetUnit(&origin, tile, &target, _aggroTarget, false, _unit) && !getSpottingUnits(pos))
 			{
-				_save->getPathfinding()->calculate(_unit, pos);
-				int ambushTUs = _save->getPathfinding()->getTotalTUCost();
+				int ambushTUs = getReachable(_reachableWithAttack)->getTUCost(pos);
 				// make sure we can move here
-				if (_save->getPathfinding()->getStartDirection() != -1)
+				if (getReachable(_reachableWithAttack)->hasPath(pos))
 				{
 					int score = BASE_SYSTEMATIC_SUCCESS;
 					score -= ambushTUs;
@@ -997,7 +1028,7 @@ void AIModule::setupEscape()
 		else
 		{
 			spotters = getSpottingUnits(_escapeAction->target);
-			if (std::find(_reachable.begin(), _reachable.end(), _save->getTileIndex(_escapeAction->target))  == _reachable.end())
+			if (!getReachable(_reachable)->isReachable(_escapeAction->target))
 				continue; // just ignore unreachable tiles
 
 			if (_spottingEnemies || spotters)
@@ -1031,13 +1062,12 @@ void AIModule::setupEscape()
 
 		if (tile && score > bestTileScore)
 		{
-			// calculate TUs to tile; we could be getting this from findReachable() somehow but that would break something for sure...
-			_save->getPathfinding()->calculate(_unit, _escapeAction->target);
-			if (_escapeAction->target == _unit->getPosition() || _save->getPathfinding()->getStartDirection() != -1)
+			// TUs to tile are already known from findReachable()
+			if (_escapeAction->target == _unit->getPosition() || getReachable(_reachable)->hasPath(_escapeAction->target))
 			{
 				bestTileScore = score;
 				bestTile = _escapeAction->target;
-				_escapeTUs = _save->getPathfinding()->getTotalTUCost();
+				_escapeTUs = getReachable(_reachable)->getTUCost(_escapeAction->target);
 				if (_escapeAction->target == _unit->getPosition())
 				{
 					_escapeTUs = 1;
@@ -1049,7 +1079,6 @@ void AIModule::setupEscape()
 					tile->setTUMarker(score);
 				}
 			}
-			_save->getPathfinding()->abortPath();
 			if (bestTileScore > FAST_PASS_THRESHOLD) coverFound = true; // good enough, gogogo
 		}
 	}
@@ -1295,6 +1324,7 @@ bool AIModule::selectPointNearTarget(BattleUnit *target, int maxTUs) const
 	float dodgeChanceDiff = target->getArmor()->getMeleeDodge(target) * target->getArmor()->getMeleeDodgeBackPenalty() * _attackAction->diff / 160.0f;
 	bool returnValue = false;
 	int distance = 1000;
+	std::vector<int> path;
 	for (int z = -1; z <= 1; ++z)
 	{
 		for (int x = -size; x <= sizeTarget; ++x)
@@ -1304,7 +1334,7 @@ bool AIModule::selectPointNearTarget(BattleUnit *target, int maxTUs) const
 				if (x || y) // skip the unit itself
 				{
 					Position checkPath = target->getPosition() + Position (x, y, z);
-					if (_save->getTile(checkPath) == 0 || std::find(_reachable.begin(), _reachable.end(), _save->getTileIndex(checkPath))  == _reachable.end())
+					if (_save->getTile(checkPath) == 0 || !getReachable(_reachable)->isReachable(checkPath))
 						continue;
 					int dir = _save->getTileEngine()->getDirectionTo(checkPath, target->getPosition());
 					bool valid = _save->getTileEngine()->validMeleeRange(checkPath, dir, _unit, target, 0);
@@ -1312,17 +1342,16 @@ bool AIModule::selectPointNearTarget(BattleUnit *target, int maxTUs) const
 
 					if (valid && fitHere && !_save->getTile(checkPath)->getDangerous())
 					{
-						_save->getPathfinding()->calculate(_unit, checkPath, 0, maxTUs);
+						getReachable(_reachable)->getPath(checkPath, path);
 
 						//for 100% dodge diff and on 4th difficulty it will allow aliens to move 10 squares around to made attack from behind.
-						int distanceCurrent = _save->getPathfinding()->getPath().size() - dodgeChanceDiff * _save->getTileEngine()->getArcDirection(dir - 4, dirTarget);
-						if (_save->getPathfinding()->getStartDirection() != -1 && distanceCurrent < distance)
+						int distanceCurrent = path.size() - dodgeChanceDiff * _save->getTileEngine()->getArcDirection(dir - 4, dirTarget);
+						if (getReachable(_reachable)->hasPath(checkPath) && getReachable(_reachable)->getTUCost(checkPath) <= maxTUs && distanceCurrent < distance)
 						{
 							_attackAction->target = checkPath;
 							returnValue = true;
 							distance = distanceCurrent;
 						}
-						_save->getPathfinding()->abortPath();
 					}
 				}
 			}
@@ -1355,7 +1384,7 @@ bool AIModule::selectPointNearTargetLeeroy(BattleUnit *target) const
 				if (x || y) // skip the unit itself
 				{
 					Position checkPath = target->getPosition() + Position(x, y, z);
-					if (_save->getTile(checkPath) == 0 || std::find(_reachable.begin(), _reachable.end(), _save->getTileIndex(checkPath)) == _reachable.end())
+					if (_save->getTile(checkPath) == 0 || !getReachable(_reachable)->isReachable(checkPath))
 						continue;
 					int dir = _save->getTileEngine()->getDirectionTo(checkPath, target->getPosition());
 					bool valid = _save->getTileEngine()->validMeleeRange(checkPath, dir, _unit, target, 0);
@@ -1826,7 +1855,7 @@ bool AIModule::findFirePoint()
 		Position pos = _unit->getPosition() + *i;
 		Tile *tile = _save->getTile(pos);
 		if (tile == 0  ||
-			std::find(_reachableWithAttack.begin(), _reachableWithAttack.end(), _save->getTileIndex(pos))  == _reachableWithAttack.end())
+			!_reachableWithAttack.field || !getReachable(_reachableWithAttack)->isReachable(pos))
 			continue;
 		int score = 0;
 		// i should really make a function for this
@@ -1836,12 +1865,11 @@ bool AIModule::findFirePoint()
 
 		if (_save->getTileEngine()->canTargetUnit(&origin, _aggroTarget->getTile(), &target, _unit, false))
 		{
-			_save->getPathfinding()->calculate(_unit, pos);
 			// can move here
-			if (_save->getPathfinding()->getStartDirection() != -1)
+			if (getReachable(_reachableWithAttack)->hasPath(pos))
 			{
 				score = BASE_SYSTEMATIC_SUCCESS - getSpottingUnits(pos) * 10;
-				score += _unit->getTimeUnits() - _save->getPathfinding()->getTotalTUCost();
+				score += _unit->getTimeUnits() - getReachable(_reachableWithAttack)->getTUCost(pos);
 				if (!_aggroTarget->checkViewSector(pos))
 				{
 					score += 10;
@@ -2742,7 +2770,7 @@ void AIModule::selectMeleeOrRanged()
 		{
 			_rifle = false;
 			_attackAction->weapon = melee;
-			_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, BattleActionCost(BA_HIT, _unit, melee));
+			setReachable(_reachableWithAttack, BattleActionCost(BA_HIT, _unit, melee));
 			return;
 		}
 	}
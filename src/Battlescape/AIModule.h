@@ -32,6 +32,7 @@ class BattleUnit;
 struct BattleAction;
 class BattlescapeState;
 class Node;
+class PathfindingCostField;
 
 enum AIMode { AI_PATROL, AI_AMBUSH, AI_COMBAT, AI_ESCAPE };
 /**
@@ -52,10 +53,22 @@ private:
 	int _AIMode, _intelligence, _closestDist;
 	Node *_fromNode, *_toNode;
 	bool _foundBaseModuleToDestroy;
-	std::vector<int> _reachable, _reachableWithAttack, _wasHitBy;
+	/// A findReachable result, with what's needed to tell if Pathfinding reused it.
+	struct ReachableTiles
+	{
+		BattleActionCost cost;
+		const PathfindingCostField *field = nullptr;
+		Uint32 generation = 0;
+	};
+	mutable ReachableTiles _reachable, _reachableWithAttack;
+	std::vector<int> _wasHitBy;
 	BattleActionType _reserve;
 	UnitFaction _targetFaction;
 
+	/// Finds the tiles the unit can reach and keeps them.
+	void setReachable(ReachableTiles &reachable, const BattleActionCost &cost);
+	/// Gets the kept tiles the unit can reach, finding them again if needed.
+	const PathfindingCostField *getReachable(ReachableTiles &reachable) const;
 	bool selectPointNearTargetLeeroy(BattleUnit *target) const;
 	int selectNearestTargetLeeroy();
 	void meleeActionLeeroy();
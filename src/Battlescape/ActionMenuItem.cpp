@@ -94,7 +94,7 @@ void ActionMenuItem::setAction(BattleActionType action, const std::string &descr
 	_txtAcc->setText(accuracy);
 	_txtTU->setText(timeunits);
 	_tu = tu;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -109,6 +109,7 @@ void AlienInventory::draw()
  */
 void AlienInventory::drawGrid()
 {
+	damage();
 	_grid->clear();
 	RuleInterface *rule = _game->getMod()->getInterface("inventory");
 	Uint8 color = rule->getElement("grid")->color;
@@ -148,6 +149,7 @@ void AlienInventory::drawGrid()
  */
 void AlienInventory::drawItems()
 {
+	damage();
 	_items->clear();
 	if (_selUnit != 0)
 	{
@@ -199,9 +201,10 @@ RuleInventory *AlienInventory::getSlotInPosition(int *x, int *y) const
  */
 void AlienInventory::blit(SDL_Surface *surface)
 {
-	clear();
-	_grid->blitNShade(this, 0, 0);
-	_items->blitNShade(this, 0, 0);
+	// the layers damage the inventory when they change, composing them doesn't
+	CleanSdlSurface(_surface.get());
+	_grid->blitNShade(_surface.get(), 0, 0);
+	_items->blitNShade(_surface.get(), 0, 0);
 	Surface::blit(surface);
 }
 
@@ -44,6 +44,7 @@
 #include "../Geoscape/SelectMusicTrackState.h"
 #include "../Engine/Game.h"
 #include "../Engine/Options.h"
+#include "../Engine/FrameProfiler.h"
 #include "../Engine/LocalizedText.h"
 #include "../Engine/Palette.h"
 #include "../Engine/Surface.h"
@@ -102,6 +103,7 @@ BattlescapeState::BattlescapeState() :
 	_numberOfDirectlyVisibleUnits(0), _numberOfEnemiesTotal(0), _numberOfEnemiesTotalPlusWounded(0)
 {
 	std::fill_n(_visibleUnit, 10, (BattleUnit*)(0));
+	_game->getMod()->loadBattlescapeScope();
 
 	const int screenWidth = Options::baseXResolution;
 	const int screenHeight = Options::baseYResolution;
@@ -223,6 +225,7 @@ BattlescapeState::BattlescapeState() :
 	}
 
 	_txtDebug = new Text(300, 10, 20, 0);
+	_txtPerf = new Text(300, 30, 20, 10);
 	_txtTooltip = new Text(300, 10, x + 2, y - 10);
 
 	// Palette transformations
@@ -349,6 +352,7 @@ BattlescapeState::BattlescapeState() :
 	add(_btnTogglePL);
 	add(_warning, "warning", "battlescape", _icons);
 	add(_txtDebug);
+	add(_txtPerf);
 	add(_txtTooltip, "textTooltip", "battlescape", _icons);
 	add(_btnLaunch);
 	_game->getMod()->getSurfaceSet("SPICONS.DAT")->getFrame(0)->blitNShade(_btnLaunch, 0, 0);
@@ -361,6 +365,7 @@ BattlescapeState::BattlescapeState() :
 
 	// Set up objects
 	_save = _game->getSavedGame()->getSavedBattle();
+	_game->getMod()->preloadBattleSounds(_save);
 	_map->init();
 	_map->onMouseOver((ActionHandler)&BattlescapeState::mapOver);
 	_map->onMousePress((ActionHandler)&BattlescapeState::mapPress);
@@ -625,6 +630,9 @@ BattlescapeState::BattlescapeState() :
 
 	_txtDebug->setColor(Palette::blockOffset(8));
 	_txtDebug->setHighContrast(true);
+	_txtPerf->setColor(Palette::blockOffset(8));
+	_txtPerf->setHighContrast(true);
+	_txtPerf->setVisible(false);
 
 	_txtTooltip->setHighContrast(true);
 
@@ -790,6 +798,12 @@ void BattlescapeState::think()
 {
 	static bool popped = false;
 
+	if (FrameProfiler::isEnabled() && _txtPerf->getText() != FrameProfiler::getOverlayText())
+	{
+		_txtPerf->setText(FrameProfiler::getOverlayText());
+	}
+	_txtPerf->setVisible(FrameProfiler::isEnabled());
+
 	if (_gameTimer->isRunning())
 	{
 		if (_popups.empty())
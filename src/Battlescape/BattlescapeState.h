@@ -76,7 +76,7 @@ private:
 	bool _manaBarVisible;
 	Timer *_animTimer, *_gameTimer;
 	SavedBattleGame *_save;
-	Text *_txtDebug, *_txtTooltip;
+	Text *_txtDebug, *_txtPerf, *_txtTooltip;
 	Uint8 _tooltipDefaultColor;
 	Uint8 _medikitRed, _medikitGreen, _medikitBlue, _medikitOrange;
 	std::vector<State*> _popups;
@@ -0,0 +1,713 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BenchmarkState.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <yaml-cpp/yaml.h>
+#include "BattlescapeState.h"
+#include "BattlescapeGame.h"
+#include "BattlescapeGenerator.h"
+#include "NextTurnState.h"
+#include "Pathfinding.h"
+#include "TileEngine.h"
+#include "../Engine/Game.h"
+#include "../Engine/Exception.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/FrameProfiler.h"
+#include "../Engine/Options.h"
+#include "../Engine/Logger.h"
+#include "../Engine/RNG.h"
+#include "../Mod/Mod.h"
+#include "../Mod/AlienDeployment.h"
+#include "../Mod/RuleDamageType.h"
+#include "../Mod/RuleItem.h"
+#include "../Mod/MapData.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/BattleUnit.h"
+#include "../Savegame/Base.h"
+#include "../Savegame/Craft.h"
+#include "../Savegame/Ufo.h"
+#include "../Savegame/MissionSite.h"
+#include "../Savegame/AlienBase.h"
+#include "../Savegame/Tile.h"
+#include "../Savegame/BattleItem.h"
+#include "../fmath.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Battle steps on one side before the benchmark gives up on the turn.
+const int MAX_STEPS_PER_SIDE = 1000000;
+
+/// Seed used for the explosion positions and the battle's random numbers.
+const Uint32 EXPLOSION_SEED = 12345;
+
+/// Seed used for the pathfinding targets.
+const Uint32 PATHFINDING_SEED = 12345;
+
+/// Sections that don't depend on drawing.
+const FrameProfiler::Section SECTIONS[] = { FrameProfiler::SECTION_AI, FrameProfiler::SECTION_PATHFINDING, FrameProfiler::SECTION_FOV, FrameProfiler::SECTION_LIGHTING };
+const int SECTION_COUNT = sizeof(SECTIONS) / sizeof(SECTIONS[0]);
+
+std::string formatMs(Uint64 time)
+{
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(1) << time / 1000.0;
+	return ss.str();
+}
+
+/**
+ * Prints a line of results to the console and the log.
+ * @param line Text to print.
+ */
+void report(const std::string &line)
+{
+	std::cout << line << std::endl;
+	Log(LOG_INFO) << line;
+}
+
+/**
+ * Handles an explosion without an attacker the way TileEngine::explode
+ * did before its rays were tabulated: every ray computes its own sines
+ * and cosines, affected tiles are tracked in a map and detonated in
+ * pointer order. Kept to check the current code against it.
+ * @param save Battle to explode in.
+ * @param center Center of the explosion in voxelspace.
+ * @param power Power of the explosion.
+ * @param type The damage type of the explosion.
+ * @param maxRadius The maximum radius of the explosion.
+ */
+void referenceExplode(SavedBattleGame *save, Position center, int power, const RuleDamageType *type, int maxRadius)
+{
+	TileEngine *tileEngine = save->getTileEngine();
+	const BattleActionAttack attack = { };
+	const Position centetTile = center.toTile();
+	int hitSide = 0;
+	int diagonalWall = 0;
+	int power_;
+	std::map<Tile*, int> tilesAffected;
+	std::vector<BattleItem*> toRemove;
+	std::pair<std::map<Tile*, int>::iterator, bool> ret;
+
+	if (type->FireBlastCalc)
+	{
+		power /= 2;
+	}
+
+	int exHeight = Clamp(Options::battleExplosionHeight, 0, 3);
+	int vertdec = 1000; //default flat explosion
+
+	switch (exHeight)
+	{
+	case 1:
+		vertdec = 3.0f * type->RadiusReduction;
+		break;
+	case 2:
+		vertdec = 1.0f * type->RadiusReduction;
+		break;
+	case 3:
+		vertdec = 0.5f * type->RadiusReduction;
+	}
+
+	Tile *origin = save->getTile(Position(centetTile));
+	Tile *dest = nullptr;
+	if (origin->isBigWall()) //pre-calculations for bigwall deflection
+	{
+		diagonalWall = origin->getMapData(O_OBJECT)->getBigWall();
+		if (diagonalWall == Pathfinding::BIGWALLNWSE) //  3 |
+			hitSide = (center.x % 16 - center.y % 16) > 0 ? 1 : -1;
+		if (diagonalWall == Pathfinding::BIGWALLNESW) //  2 --
+			hitSide = (center.x % 16 + center.y % 16 - 15) > 0 ? 1 : -1;
+	}
+
+	for (int fi = -90; fi <= 90; fi += 5)
+	{
+		for (int te = 0; te <= 360; te += 3)
+		{
+			double cos_te = cos(Deg2Rad(te));
+			double sin_te = sin(Deg2Rad(te));
+			double sin_fi = sin(Deg2Rad(fi));
+			double cos_fi = cos(Deg2Rad(fi));
+
+			origin = save->getTile(centetTile);
+			dest = origin;
+			double l = 0;
+			int tileX, tileY, tileZ;
+			power_ = power;
+			while (power_ > 0 && l <= maxRadius)
+			{
+				ret = tilesAffected.insert(std::make_pair(dest, 0)); // check if we had this tile already affected
+
+				const int tileDmg = type->getTileFinalDamage(power_);
+				if (tileDmg > ret.first->second)
+				{
+					ret.first->second = tileDmg;
+				}
+				if (ret.second)
+				{
+					const int damage = type->getRandomDamage(power_);
+					BattleUnit *bu = dest->getOverlappingUnit(save);
+
+					toRemove.clear();
+					if (bu)
+					{
+						if (Position::distance2d(dest->getPosition(), centetTile) < 2)
+						{
+							tileEngine->hitUnit(attack, bu, Position(0, 0, 0), damage, type);
+						}
+						else
+						{
+							tileEngine->hitUnit(attack, bu, centetTile + Position(0, 0, 5) - dest->getPosition(), damage, type);
+						}
+
+						const int itemDamage = bu->getOverKillDamage();
+						if (itemDamage > 0)
+						{
+							for (auto *item : *bu->getInventory())
+							{
+								if (!tileEngine->hitUnit(attack, item->getUnit(), Position(0, 0, 0), itemDamage, type) && type->getItemFinalDamage(itemDamage) > item->getRules()->getArmor())
+								{
+									toRemove.push_back(item);
+								}
+							}
+						}
+					}
+					for (auto *item : *dest->getInventory())
+					{
+						if (!tileEngine->hitUnit(attack, item->getUnit(), Position(0, 0, 0), damage, type) && type->getItemFinalDamage(damage) > item->getRules()->getArmor())
+						{
+							toRemove.push_back(item);
+						}
+					}
+					for (auto *item : toRemove)
+					{
+						save->removeItem(item);
+					}
+
+					tileEngine->hitTile(dest, damage, type);
+				}
+
+				l += 1.0;
+
+				tileX = int(floor(centetTile.x + 0.5 + l * sin_te * cos_fi));
+				tileY = int(floor(centetTile.y + 0.5 + l * cos_te * cos_fi));
+				tileZ = int(floor(centetTile.z + 0.5 + l * sin_fi));
+
+				origin = dest;
+				dest = save->getTile(Position(tileX, tileY, tileZ));
+
+				if (!dest) break; // out of map!
+
+				power_ -= type->RadiusReduction;
+				if (origin->getPosition().z != tileZ)
+					power_ -= vertdec;
+
+				if (type->FireBlastCalc)
+				{
+					int dir;
+					Pathfinding::vectorToDirection(origin->getPosition() - dest->getPosition(), dir);
+					if (dir != -1 && dir %2) power_ -= 0.5f * type->RadiusReduction;
+				}
+				if (l > 0.5) {
+					bool skipObject = false;
+					if (l <= 1.5)
+					{
+						skipObject = diagonalWall == 0;
+						if (diagonalWall == Pathfinding::BIGWALLNESW) // --
+						{
+							if (hitSide<0 && te >= 135 && te < 315)
+								skipObject = true;
+							if (hitSide>0 && ( te < 135 || te > 315))
+								skipObject = true;
+						}
+						if (diagonalWall == Pathfinding::BIGWALLNWSE) // |
+						{
+							if (hitSide>0 && te >= 45 && te < 225)
+								skipObject = true;
+							if (hitSide<0 && ( te < 45 || te > 225))
+								skipObject = true;
+						}
+					}
+					power_ -= tileEngine->verticalBlockage(origin, dest, type->ResistType, skipObject) * 2;
+					power_ -= tileEngine->horizontalBlockage(origin, dest, type->ResistType, skipObject) * 2;
+				}
+			}
+		}
+	}
+
+	if (type->ToTile > 0.0f)
+	{
+		for (auto &i : tilesAffected)
+		{
+			if (tileEngine->detonate(i.first, i.second))
+			{
+				save->addDestroyedObjective();
+			}
+			tileEngine->applyGravity(i.first);
+			Tile *j = save->getTile(i.first->getPosition() + Position(0,0,1));
+			if (j)
+				tileEngine->applyGravity(j);
+		}
+	}
+	tileEngine->calculateLighting(LL_AMBIENT, centetTile, maxRadius + 1, true);
+	tileEngine->calculateFOV(centetTile, maxRadius + 1, true, true);
+}
+
+}
+
+/**
+ * Checks if "-benchmark SAVE TURNS", "-benchmarkBattle
+ * DEPLOYMENT TERRAIN SEED TURNS", "-benchmarkExplosions
+ * SAVE COUNT" or "-benchmarkPathfinding SAVE SEARCHES"
+ * was passed on the command-line.
+ * @return True if a benchmark was requested.
+ */
+bool BenchmarkState::isRequested()
+{
+	std::vector<std::string> params;
+	return CrossPlatform::findArgs("benchmark", 2, params) || CrossPlatform::findArgs("benchmarkbattle", 4, params) || CrossPlatform::findArgs("benchmarkexplosions", 2, params) || CrossPlatform::findArgs("benchmarkpathfinding", 2, params);
+}
+
+/**
+ * Initializes the benchmark from the command-line.
+ */
+BenchmarkState::BenchmarkState() : _generate(false), _explosions(false), _pathfinding(false), _turns(0)
+{
+	if (!CrossPlatform::findArgs("benchmark", 2, _args))
+	{
+		_generate = CrossPlatform::findArgs("benchmarkbattle", 4, _args);
+		if (!_generate)
+		{
+			_explosions = CrossPlatform::findArgs("benchmarkexplosions", 2, _args);
+			if (!_explosions)
+			{
+				_pathfinding = CrossPlatform::findArgs("benchmarkpathfinding", 2, _args);
+			}
+		}
+	}
+	if (!_args.empty())
+	{
+		_turns = std::max(1, atoi(_args.back().c_str()));
+	}
+}
+
+/**
+ *
+ */
+BenchmarkState::~BenchmarkState()
+{
+
+}
+
+/**
+ * Loads the battle to benchmark from a saved game in the user folder.
+ * The random seed stored in the save is always used, so runs repeat.
+ */
+void BenchmarkState::loadBattle()
+{
+	SavedGame *save = new SavedGame(_game->getMod());
+	bool newSeedOnLoad = Options::newSeedOnLoad;
+	Options::newSeedOnLoad = false;
+	try
+	{
+		save->load(_args[0], _game->getMod(), _game->getLanguage());
+	}
+	catch (...)
+	{
+		Options::newSeedOnLoad = newSeedOnLoad;
+		delete save;
+		throw;
+	}
+	Options::newSeedOnLoad = newSeedOnLoad;
+	_game->setSavedGame(save);
+	// never write the save back when quitting
+	save->setIronman(false);
+	if (save->getSavedBattle() == 0)
+	{
+		throw Exception(_args[0] + " is not a saved battle");
+	}
+	save->getSavedBattle()->loadMapResources(_game->getMod());
+}
+
+/**
+ * Generates the battle to benchmark like the New Battle screen does,
+ * with the first craft of a new game's starting base.
+ * The deployment can be a mission or a UFO type (ground assault).
+ */
+void BenchmarkState::generateBattle()
+{
+	const std::string &type = _args[0];
+	if (type == "STR_BASE_DEFENSE")
+	{
+		throw Exception("Base defense can't be benchmarked");
+	}
+	RNG::setSeed(std::stoull(_args[2]));
+
+	Mod *mod = _game->getMod();
+	SavedGame *save = mod->newSave(DIFF_BEGINNER);
+	_game->setSavedGame(save);
+	Craft *craft = 0;
+	for (auto *c : *save->getBases()->front()->getCrafts())
+	{
+		if (c->getNumSoldiers() > 0)
+		{
+			craft = c;
+			break;
+		}
+	}
+	if (craft == 0)
+	{
+		throw Exception("The starting base has no craft with soldiers");
+	}
+	RuleTerrain *terrain = mod->getTerrain(_args[1], true);
+	const std::string &race = mod->getAlienRacesList().front();
+
+	SavedBattleGame *bgame = new SavedBattleGame(mod, _game->getLanguage());
+	save->setBattleGame(bgame);
+	bgame->setMissionType(type);
+	BattlescapeGenerator bgen = BattlescapeGenerator(_game);
+	bgen.setTerrain(terrain);
+
+	if (mod->getUfo(type))
+	{
+		Ufo *u = new Ufo(mod->getUfo(type), 1);
+		u->setId(1);
+		u->setStatus(Ufo::LANDED);
+		craft->setDestination(u);
+		bgen.setUfo(u);
+		bgame->setMissionType("STR_UFO_GROUND_ASSAULT");
+		save->getUfos()->push_back(u);
+	}
+	else if (mod->getDeployment(type, true)->isAlienBase())
+	{
+		AlienBase *b = new AlienBase(mod->getDeployment(type), -1);
+		b->setId(1);
+		b->setAlienRace(race);
+		craft->setDestination(b);
+		bgen.setAlienBase(b);
+		save->getAlienBases()->push_back(b);
+	}
+	else
+	{
+		const RuleAlienMission *mission = mod->getAlienMission(mod->getAlienMissionList().front()); // doesn't matter
+		MissionSite *m = new MissionSite(mission, mod->getDeployment(type), nullptr);
+		m->setId(1);
+		m->setAlienRace(race);
+		craft->setDestination(m);
+		bgen.setMissionSite(m);
+		save->getMissionSites()->push_back(m);
+	}
+
+	craft->setSpeed(0);
+	bgen.setCraft(craft);
+	bgen.setWorldShade(0);
+	bgen.setAlienRace(race);
+	bgen.setAlienItemlevel(0);
+	bgen.run();
+}
+
+/**
+ * Removes the screens the battle opened over the battlescape
+ * (next turn, messages, etc.) as if they were closed right away.
+ * @param bs Battlescape state.
+ * @return True if anything was closed.
+ */
+bool BenchmarkState::closePopups(BattlescapeState *bs)
+{
+	bool closed = false;
+	while (!_game->isState(bs) && !_game->isState(this))
+	{
+		_game->popState();
+		closed = true;
+	}
+	if (closed && _game->isState(bs))
+	{
+		bs->getBattleGame()->cleanupDeleted();
+	}
+	return closed;
+}
+
+/**
+ * Plays the battle without drawing it until enough alien turns are done
+ * or the battle is over. Soldiers don't act, their turns end right away.
+ * @param bs Battlescape state.
+ */
+void BenchmarkState::runTurns(BattlescapeState *bs)
+{
+	SavedBattleGame *save = _game->getSavedGame()->getSavedBattle();
+	BattlescapeGame *battleGame = bs->getBattleGame();
+	Uint64 startTime[SECTION_COUNT];
+	Uint32 startCalls[SECTION_COUNT];
+	for (int i = 0; i < SECTION_COUNT; ++i)
+	{
+		startTime[i] = FrameProfiler::getTotalTime(SECTIONS[i]);
+		startCalls[i] = FrameProfiler::getTotalCalls(SECTIONS[i]);
+	}
+	closePopups(bs);
+
+	int turns = 0, steps = 0;
+	Uint64 turnTime = 0, totalTime = 0;
+	bool finished = false;
+	while (turns < _turns)
+	{
+		UnitFaction side = save->getSide();
+		auto start = std::chrono::steady_clock::now();
+		FrameProfiler::startFrame();
+		battleGame->think();
+		if (side == FACTION_PLAYER && battleGame->getStates().empty())
+		{
+			battleGame->requestEndTurn(false);
+		}
+		battleGame->handleState();
+		Uint64 time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		FrameProfiler::endFrame();
+
+		if (side == FACTION_HOSTILE)
+		{
+			turnTime += time;
+		}
+		if (closePopups(bs))
+		{
+			// the next turn screen would end the battle here
+			auto tally = battleGame->tallyUnits();
+			finished = tally.liveAliens == 0 || tally.liveSoldiers == 0;
+		}
+		if (side == FACTION_HOSTILE && save->getSide() != FACTION_HOSTILE)
+		{
+			turns++;
+			totalTime += turnTime;
+			std::ostringstream ss;
+			ss << "Alien turn " << save->getTurn() << ": " << formatMs(turnTime) << " ms";
+			report(ss.str());
+			turnTime = 0;
+		}
+		if (finished || !_game->isState(bs))
+		{
+			report("Battle finished");
+			break;
+		}
+		steps = (side == save->getSide()) ? steps + 1 : 0;
+		if (steps >= MAX_STEPS_PER_SIDE)
+		{
+			report("Turn did not finish, giving up");
+			break;
+		}
+	}
+
+	std::ostringstream ss;
+	ss << "Total: " << turns << " alien turns, " << formatMs(totalTime) << " ms";
+	if (turns > 0)
+	{
+		ss << ", " << formatMs(totalTime / turns) << " ms per turn";
+	}
+	report(ss.str());
+	for (int i = 0; i < SECTION_COUNT; ++i)
+	{
+		std::ostringstream line;
+		line << FrameProfiler::getSectionName(SECTIONS[i]) << ": " << (FrameProfiler::getTotalCalls(SECTIONS[i]) - startCalls[i]) << " calls, "
+			<< formatMs(FrameProfiler::getTotalTime(SECTIONS[i]) - startTime[i]) << " ms";
+		report(line.str());
+	}
+}
+
+/**
+ * Loads the saved battle twice and sets off the same explosions in it,
+ * first with the former explosion code, then with the current one.
+ * The battles are compared afterwards, they must save exactly the same.
+ */
+void BenchmarkState::runExplosions()
+{
+	std::string results[2];
+	Uint64 times[2];
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		loadBattle();
+		SavedBattleGame *save = _game->getSavedGame()->getSavedBattle();
+		BattlescapeState *bs = new BattlescapeState;
+		_game->pushState(bs);
+		save->setBattleState(bs);
+		bs->getBattleGame()->init();
+		closePopups(bs);
+
+		TileEngine *tileEngine = save->getTileEngine();
+		const RuleDamageType *type = _game->getMod()->getDamageType(DT_HE);
+		RNG::setSeed(EXPLOSION_SEED);
+		// the positions don't use the battle's random numbers, so they don't depend on the explosions
+		Uint32 seed = EXPLOSION_SEED;
+		auto next = [&seed](int max) { seed = seed * 1103515245 + 12345; return (int)((seed >> 8) % max); };
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < _turns; ++i)
+		{
+			Position center(next(save->getMapSizeX()) * 16 + 8, next(save->getMapSizeY()) * 16 + 8, next(save->getMapSizeZ()) * 24 + 2);
+			int power = 50 + next(100);
+			if (pass == 0)
+			{
+				referenceExplode(save, center, power, type, power / 10);
+			}
+			else
+			{
+				tileEngine->explode({ }, center, power, type, power / 10);
+			}
+		}
+		times[pass] = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+		YAML::Emitter out;
+		out << save->save();
+		results[pass] = std::string(out.c_str()) + "\nseed: " + std::to_string(RNG::getSeed());
+
+		while (!_game->isState(this))
+		{
+			_game->popState();
+		}
+	}
+
+	report("Former explosions: " + formatMs(times[0]) + " ms");
+	report("Current explosions: " + formatMs(times[1]) + " ms");
+	report(results[0] == results[1] ? "Battle states match" : "Battle states differ");
+}
+
+/**
+ * Runs pathfinding searches in the saved battle the way the game does,
+ * each for the next unit still in the battle towards a random position.
+ * The targets are always the same, so runs repeat.
+ */
+void BenchmarkState::runPathfinding()
+{
+	loadBattle();
+	SavedBattleGame *save = _game->getSavedGame()->getSavedBattle();
+	std::vector<BattleUnit*> units;
+	for (auto *unit : *save->getUnits())
+	{
+		if (!unit->isOut() && unit->getTile())
+		{
+			units.push_back(unit);
+		}
+	}
+	if (units.empty())
+	{
+		throw Exception("No units in " + _args[0]);
+	}
+
+	Pathfinding *pathfinding = save->getPathfinding();
+	Uint32 seed = PATHFINDING_SEED;
+	auto next = [&seed](int max) { seed = seed * 1103515245 + 12345; return (int)((seed >> 8) % max); };
+	int found = 0;
+	Uint64 steps = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < _turns; ++i)
+	{
+		BattleUnit *unit = units[i % units.size()];
+		Position target(next(save->getMapSizeX()), next(save->getMapSizeY()), next(save->getMapSizeZ()));
+		pathfinding->calculate(unit, target);
+		if (!pathfinding->getPath().empty())
+		{
+			found++;
+			steps += pathfinding->getPath().size();
+		}
+		pathfinding->abortPath();
+	}
+	Uint64 time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+	std::ostringstream ss;
+	ss << "Total: " << _turns << " searches for " << units.size() << " units, " << formatMs(time) << " ms, "
+		<< std::fixed << std::setprecision(1) << (double)time / _turns << " us per search";
+	report(ss.str());
+	report("Paths found: " + std::to_string(found) + ", " + std::to_string(steps) + " steps in total");
+}
+
+/**
+ * Sets up the battle, runs the benchmark
+ * and quits the game when it's done.
+ */
+void BenchmarkState::think()
+{
+	State::think();
+	if (_args.empty())
+	{
+		std::cerr << "Usage: openxcom -benchmark SAVE TURNS" << std::endl;
+		std::cerr << "       openxcom -benchmarkBattle DEPLOYMENT TERRAIN SEED TURNS" << std::endl;
+		std::cerr << "       openxcom -benchmarkExplosions SAVE COUNT" << std::endl;
+		std::cerr << "       openxcom -benchmarkPathfinding SAVE SEARCHES" << std::endl;
+		_game->quit();
+		return;
+	}
+
+	bool profiler = Options::oxceFrameProfiler;
+	Options::oxceFrameProfiler = true;
+	try
+	{
+		if (_explosions)
+		{
+			report("Benchmark: " + std::to_string(_turns) + " explosions in " + _args[0]);
+			runExplosions();
+		}
+		else if (_pathfinding)
+		{
+			report("Benchmark: " + std::to_string(_turns) + " pathfinding searches in " + _args[0]);
+			runPathfinding();
+		}
+		else
+		{
+			if (_generate)
+			{
+				report("Benchmark: " + _args[0] + " on " + _args[1] + ", seed " + _args[2]);
+				generateBattle();
+			}
+			else
+			{
+				report("Benchmark: " + _args[0]);
+				loadBattle();
+			}
+			BattlescapeState *bs = new BattlescapeState;
+			_game->pushState(bs);
+			_game->getSavedGame()->getSavedBattle()->setBattleState(bs);
+			if (_generate)
+			{
+				bs->getBattleGame()->spawnFromPrimedItems();
+				_game->pushState(new NextTurnState(_game->getSavedGame()->getSavedBattle(), bs));
+			}
+			bs->getBattleGame()->init();
+			runTurns(bs);
+		}
+	}
+	catch (std::exception &e)
+	{
+		report(std::string("Benchmark failed: ") + e.what());
+	}
+	Options::oxceFrameProfiler = profiler;
+
+	while (!_game->isState(this))
+	{
+		_game->popState();
+	}
+	_game->quit();
+}
+
+}
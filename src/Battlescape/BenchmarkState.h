@@ -0,0 +1,68 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include "../Engine/State.h"
+
+namespace OpenXcom
+{
+
+class BattlescapeState;
+
+/**
+ * Runs alien turns of a battle as fast as possible without drawing
+ * anything, then prints how long they took and quits. Requested on the
+ * command-line, either with a saved battle or with a mission generated
+ * from a fixed seed, so the results can be compared between builds and mods.
+ * Can also set off explosions in a saved battle with the current and the
+ * former explosion code, to check that both do the same damage, or time
+ * pathfinding searches of the units in a saved battle.
+ */
+class BenchmarkState : public State
+{
+private:
+	std::vector<std::string> _args;
+	bool _generate, _explosions, _pathfinding;
+	int _turns;
+
+	/// Loads the battle from a saved game.
+	void loadBattle();
+	/// Generates the battle from a deployment and terrain.
+	void generateBattle();
+	/// Plays the alien turns and prints the timings.
+	void runTurns(BattlescapeState *bs);
+	/// Sets off the explosions with both explosion codes and prints the timings.
+	void runExplosions();
+	/// Runs the pathfinding searches and prints the timings.
+	void runPathfinding();
+	/// Removes all the screens opened over the battlescape.
+	bool closePopups(BattlescapeState *bs);
+public:
+	/// Checks if a benchmark was requested on the command-line.
+	static bool isRequested();
+	/// Creates the Benchmark state.
+	BenchmarkState();
+	/// Cleans up the Benchmark state.
+	~BenchmarkState();
+	/// Runs the benchmark.
+	void think() override;
+};
+
+}
@@ -848,6 +848,7 @@ void DebriefingState::btnOkClick(Action *)
 		}
 	}
 	_game->getSavedGame()->setBattleGame(0);
+	_game->getMod()->unloadBattlescapeScope();
 	_game->popState();
 	if (_game->getSavedGame()->getMonthsPassed() == -1)
 	{
@@ -2117,26 +2118,25 @@ void DebriefingState::prepareDebriefing()
  */
 void DebriefingState::reequipCraft(Base *base, Craft *craft, bool vehicleItemsCanBeDestroyed)
 {
-	std::map<std::string, int> craftItems = *craft->getItems()->getContents();
-	for (std::map<std::string, int>::iterator i = craftItems.begin(); i != craftItems.end(); ++i)
+	for (auto& i : craft->getItems()->getContents())
 	{
-		int qty = base->getStorageItems()->getItem(i->first);
-		if (qty >= i->second)
+		int qty = base->getStorageItems()->getItem(i.first);
+		if (qty >= i.second)
 		{
-			base->getStorageItems()->removeItem(i->first, i->second);
+			base->getStorageItems()->removeItem(i.first, i.second);
 		}
 		else
 		{
-			int missing = i->second - qty;
-			base->getStorageItems()->removeItem(i->first, qty);
-			craft->getItems()->removeItem(i->first, missing);
-			ReequipStat stat = {i->first, missing, craft->getName(_game->getLanguage()), 0};
+			int missing = i.second - qty;
+			base->getStorageItems()->removeItem(i.first, qty);
+			craft->getItems()->removeItem(i.first, missing);
+			ReequipStat stat = {i.first->getType(), missing, craft->getName(_game->getLanguage()), 0};
 			_missingItems.push_back(stat);
 		}
 	}
 
 	// Now let's see the vehicles
-	ItemContainer craftVehicles;
+	ItemContainer craftVehicles(_game->getMod());
 	for (std::vector<Vehicle*>::iterator i = craft->getVehicles()->begin(); i != craft->getVehicles()->end(); ++i)
 		craftVehicles.addItem((*i)->getRules());
 	// Now we know how many vehicles (separated by types) we have to read
@@ -2146,23 +2146,23 @@ void DebriefingState::reequipCraft(Base *base, Craft *craft, bool vehicleItemsCa
 			delete (*i);
 	craft->getVehicles()->clear();
 	// Ok, now read those vehicles
-	for (std::map<std::string, int>::iterator i = craftVehicles.getContents()->begin(); i != craftVehicles.getContents()->end(); ++i)
+	for (auto& i : craftVehicles.getContents())
 	{
-		int qty = base->getStorageItems()->getItem(i->first);
-		RuleItem *tankRule = _game->getMod()->getItem(i->first, true);
+		int qty = base->getStorageItems()->getItem(i.first);
+		RuleItem *tankRule = i.first;
 		int size = tankRule->getVehicleUnit()->getArmor()->getTotalSize();
-		int canBeAdded = std::min(qty, i->second);
-		if (qty < i->second)
+		int canBeAdded = std::min(qty, i.second);
+		if (qty < i.second)
 		{ // missing tanks
-			int missing = i->second - qty;
-			ReequipStat stat = {i->first, missing, craft->getName(_game->getLanguage()), 0};
+			int missing = i.second - qty;
+			ReequipStat stat = {i.first->getType(), missing, craft->getName(_game->getLanguage()), 0};
 			_missingItems.push_back(stat);
 		}
 		if (tankRule->getVehicleClipAmmo() == nullptr)
 		{ // so this tank does NOT require ammo
 			for (int j = 0; j < canBeAdded; ++j)
 				craft->getVehicles()->push_back(new Vehicle(tankRule, tankRule->getVehicleClipSize(), size));
-			base->getStorageItems()->removeItem(i->first, canBeAdded);
+			base->getStorageItems()->removeItem(i.first, canBeAdded);
 		}
 		else
 		{ // so this tank requires ammo
@@ -2170,9 +2170,9 @@ void DebriefingState::reequipCraft(Base *base, Craft *craft, bool vehicleItemsCa
 			int ammoPerVehicle = tankRule->getVehicleClipsLoaded();
 
 			int baqty = base->getStorageItems()->getItem(ammo); // Ammo Quantity for this vehicle-type on the base
-			if (baqty < i->second * ammoPerVehicle)
+			if (baqty < i.second * ammoPerVehicle)
 			{ // missing ammo
-				int missing = (i->second * ammoPerVehicle) - baqty;
+				int missing = (i.second * ammoPerVehicle) - baqty;
 				ReequipStat stat = {ammo->getType(), missing, craft->getName(_game->getLanguage()), 0};
 				_missingItems.push_back(stat);
 			}
@@ -2184,7 +2184,7 @@ void DebriefingState::reequipCraft(Base *base, Craft *craft, bool vehicleItemsCa
 					craft->getVehicles()->push_back(new Vehicle(tankRule, tankRule->getVehicleClipSize(), size));
 					base->getStorageItems()->removeItem(ammo, ammoPerVehicle);
 				}
-				base->getStorageItems()->removeItem(i->first, canBeAdded);
+				base->getStorageItems()->removeItem(i.first, canBeAdded);
 			}
 		}
 	}
@@ -190,6 +190,7 @@ void Inventory::draw()
  */
 void Inventory::drawGrid()
 {
+	damage();
 	_grid->clear();
 	RuleInterface *rule = _game->getMod()->getInterface("inventory");
 	Uint8 color = rule->getElement("grid")->color;
@@ -257,6 +258,7 @@ void Inventory::drawGrid()
  */
 void Inventory::drawGridLabels(bool showTuCost)
 {
+	damage();
 	_gridLabels->clear();
 
 	Text text = Text(90, 9, 0, 0);
@@ -308,6 +310,7 @@ void Inventory::drawItems()
 	};
 
 	ScriptWorkerBlit work;
+	damage();
 	_items->clear();
 	Uint8 color = _game->getMod()->getInterface("inventory")->getElement("numStack")->color;
 	Uint8 color2 = _game->getMod()->getInterface("inventory")->getElement("numStack")->color2;
@@ -468,6 +471,7 @@ void Inventory::drawSelectedItem()
 {
 	if (_selItem)
 	{
+		damage();
 		_selection->clear();
 		_selItem->getRules()->drawHandSprite(_game->getMod()->getSurfaceSet("BIGOBS.PCK"), _selection, _selItem, _animFrame);
 	}
@@ -579,6 +583,7 @@ void Inventory::setSelectedItem(BattleItem *item)
 	}
 	else
 	{
+		damage();
 		_selection->clear();
 	}
 	drawSelectedItem();
@@ -623,7 +628,13 @@ void Inventory::setMouseOverItem(BattleItem *item)
  */
 void Inventory::think()
 {
+	bool warning = _warning->getVisible();
 	_warning->think();
+	if (warning)
+	{
+		// the message fades on the inventory until it's gone
+		damage();
+	}
 	_animTimer->think(0,this);
 }
 
@@ -633,12 +644,13 @@ void Inventory::think()
  */
 void Inventory::blit(SDL_Surface *surface)
 {
-	clear();
-	_grid->blitNShade(this, 0, 0);
-	_items->blitNShade(this, 0, 0);
-	_gridLabels->blitNShade(this, 0, 0);
-	_selection->blitNShade(this, _selection->getX(), _selection->getY());
-	_warning->blit(this->getSurface());
+	// the layers damage the inventory when they change, composing them doesn't
+	CleanSdlSurface(_surface.get());
+	_grid->blitNShade(_surface.get(), 0, 0);
+	_items->blitNShade(_surface.get(), 0, 0);
+	_gridLabels->blitNShade(_surface.get(), 0, 0);
+	_selection->blitNShade(_surface.get(), _selection->getX(), _selection->getY());
+	_warning->blit(_surface.get());
 	Surface::blit(surface);
 }
 
@@ -649,6 +661,10 @@ void Inventory::blit(SDL_Surface *surface)
  */
 void Inventory::mouseOver(Action *action, State *state)
 {
+	if (_selItem)
+	{
+		damage();
+	}
 	_selection->setX((int)floor(action->getAbsoluteXMouse()) - _selection->getWidth()/2 - getX());
 	_selection->setY((int)floor(action->getAbsoluteYMouse()) - _selection->getHeight()/2 - getY());
 	if (_selUnit == 0)
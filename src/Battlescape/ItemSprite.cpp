@@ -19,6 +19,7 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include "ItemSprite.h"
+#include "SpriteCache.h"
 #include "../Engine/SurfaceSet.h"
 #include "../Mod/RuleSoldier.h"
 #include "../Mod/Unit.h"
@@ -41,10 +42,10 @@ namespace OpenXcom
  * @param x X position in pixels.
  * @param y Y position in pixels.
  */
-ItemSprite::ItemSprite(Surface* dest, Mod* mod, int frame) :
+ItemSprite::ItemSprite(Surface* dest, Mod* mod, SpriteCache* cache, int frame) :
 	_itemSurface(mod->getSurfaceSet("FLOOROB.PCK")),
 	_animationFrame(frame),
-	_dest(dest)
+	_dest(dest), _cache(cache)
 {
 
 }
@@ -68,7 +69,8 @@ void ItemSprite::draw(BattleItem* item, int x, int y, int shade)
 	{
 		ScriptWorkerBlit work;
 		BattleItem::ScriptFill(&work, item, BODYPART_ITEM_FLOOR, _animationFrame, shade);
-		work.executeBlit(sprite, _dest, x, y, shade);
+		SpriteCache::Key key = { item, item->getRules(), sprite, BODYPART_ITEM_FLOOR, _animationFrame, shade, 0, item->getSpriteState() };
+		_cache->blit(work, key, sprite, _dest, x, y, shade, GraphSubset{ _dest->getWidth(), _dest->getHeight() });
 	}
 }
 
@@ -27,6 +27,7 @@ class BattleUnit;
 class BattleItem;
 class SurfaceSet;
 class Mod;
+class SpriteCache;
 
 /**
  * A class that renders a specific unit, given its render rules
@@ -38,10 +39,11 @@ private:
 	SurfaceSet *_itemSurface;
 	int _animationFrame;
 	Surface *_dest;
+	SpriteCache *_cache;
 
 public:
 	/// Creates a new ItemSprite at the specified position and size.
-	ItemSprite(Surface* dest, Mod* mod, int frame);
+	ItemSprite(Surface* dest, Mod* mod, SpriteCache* cache, int frame);
 	/// Cleans up the ItemSprite.
 	~ItemSprite();
 	/// Draws the item.
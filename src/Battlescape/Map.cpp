@@ -20,6 +20,7 @@
 #include "Camera.h"
 #include "UnitSprite.h"
 #include "ItemSprite.h"
+#include "SpriteCache.h"
 #include "Pathfinding.h"
 #include "TileEngine.h"
 #include "Projectile.h"
@@ -36,6 +37,7 @@
 #include "../Engine/Screen.h"
 #include "../Engine/ShaderDraw.h"
 #include "../Engine/ShaderMove.h"
+#include "../Engine/FrameProfiler.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Savegame/Tile.h"
 #include "../Savegame/BattleUnit.h"
@@ -124,6 +126,7 @@ Map::Map(Game *game, int width, int height, int x, int y, int visibleMapHeight)
 	_message->setY((visibleMapHeight - _message->getHeight()) / 2);
 	_message->setTextColor(_messageColor);
 	_camera = new Camera(_spriteWidth, _spriteHeight, _save->getMapSizeX(), _save->getMapSizeY(), _save->getMapSizeZ(), this, visibleMapHeight);
+	_spriteCache = new SpriteCache(std::max(0, Options::oxceRecolorCacheSize) * 1024);
 	_scrollMouseTimer = new Timer(SCROLL_INTERVAL);
 	_scrollMouseTimer->onTimer((SurfaceHandler)&Map::scrollMouse);
 	_scrollKeyTimer = new Timer(SCROLL_INTERVAL);
@@ -186,6 +189,7 @@ Map::~Map()
 	delete _arrow;
 	delete _message;
 	delete _camera;
+	delete _spriteCache;
 	delete _txtAccuracy;
 }
 
@@ -439,6 +443,8 @@ void Map::drawUnit(UnitSprite &unitSprite, Tile *unitTile, Tile *currTile, Posit
 		return;
 	}
 
+	// units are drawn tile by tile with the terrain, so only time the tiles that have one
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_UNITS);
 	unitOffset.x = unitTile->getPosition().x - bu->getPosition().x;
 	unitOffset.y = unitTile->getPosition().y - bu->getPosition().y;
 	int part = unitOffset.x + unitOffset.y*2;
@@ -645,6 +651,7 @@ void Map::drawUnit(UnitSprite &unitSprite, Tile *unitTile, Tile *currTile, Posit
  */
 void Map::drawTerrain(Surface *surface)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_TERRAIN);
 	_isAltPressed = (SDL_GetModState() & KMOD_ALT) != 0;
 	int frameNumber = 0;
 	SurfaceRaw<const Uint8> tmpSurface;
@@ -657,8 +664,9 @@ void Map::drawTerrain(Surface *surface)
 	int dummy;
 	BattleUnit *movingUnit = _save->getTileEngine()->getMovingUnit();
 	int tileShade, tileColor, obstacleShade;
-	UnitSprite unitSprite(surface, _game->getMod(), _animFrame, _save->getDepth() != 0);
-	ItemSprite itemSprite(surface, _game->getMod(), _animFrame);
+	_spriteCache->setTurn(_save->getTurn());
+	UnitSprite unitSprite(surface, _game->getMod(), _spriteCache, _animFrame, _save->getDepth() != 0);
+	ItemSprite itemSprite(surface, _game->getMod(), _spriteCache, _animFrame);
 
 	const int halfAnimFrame = (_animFrame / 2) % 4;
 	const int halfAnimFrameRest = (_animFrame % 2);
@@ -1770,7 +1778,7 @@ void Map::setSelectorPosition(int mx, int my)
 
 	if (oldX != _selectorX || oldY != _selectorY)
 	{
-		_redraw = true;
+		invalidate();
 	}
 }
 
@@ -1856,7 +1864,7 @@ void Map::animate(bool redraw)
 		}
 	}
 
-	if (redraw) _redraw = true;
+	if (redraw) invalidate();
 }
 
 /**
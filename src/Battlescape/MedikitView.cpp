@@ -55,7 +55,7 @@ const std::string PARTS_STRING[6] =
 MedikitView::MedikitView (int w, int h, int x, int y, Game * game, BattleUnit *unit, Text *partTxt, Text *woundTxt) : InteractiveSurface(w, h, x, y), _game(game), _selectedPart(0), _unit(unit), _partTxt(partTxt), _woundTxt(woundTxt)
 {
 	updateSelectedPart();
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -110,7 +110,7 @@ void MedikitView::mouseClick (Action *action, State *)
 		if (surface->getPixel(x, y))
 		{
 			_selectedPart = i;
-			_redraw = true;
+			invalidate();
 			break;
 		}
 	}
@@ -203,7 +203,7 @@ void MiniMapView::draw()
 int MiniMapView::up()
 {
 	_camera->setViewLevel(_camera->getViewLevel()+1);
-	_redraw = true;
+	invalidate();
 	return _camera->getViewLevel();
 }
 
@@ -214,7 +214,7 @@ int MiniMapView::up()
 int MiniMapView::down()
 {
 	_camera->setViewLevel(_camera->getViewLevel()-1);
-	_redraw = true;
+	invalidate();
 	return _camera->getViewLevel();
 }
 
@@ -265,7 +265,7 @@ void MiniMapView::mouseClick(Action *action, State *state)
 		&& 0==(SDL_GetMouseState(0,0)&SDL_BUTTON(Options::battleDragScrollButton))) { // so we missed again the mouse-release :(
 			// Check if we have to revoke the scrolling, because it was too short in time, so it was a click
 			if ((!_mouseMovedOverThreshold) && ((int)(SDL_GetTicks() - _mouseScrollingStartTime) <= (Options::dragScrollTimeTolerance)))
-				{ _camera->centerOnPosition(_posBeforeMouseScrolling); _redraw = true; }
+				{ _camera->centerOnPosition(_posBeforeMouseScrolling); invalidate(); }
 			_isMouseScrolled = _isMouseScrolling = false;
 			stopScrolling(action);
 		}
@@ -290,7 +290,7 @@ void MiniMapView::mouseClick(Action *action, State *state)
 			_isMouseScrolled = false;
 			stopScrolling(action);
 			_camera->centerOnPosition(_posBeforeMouseScrolling);
-			_redraw = true;
+			invalidate();
 		}
 		if (_isMouseScrolled) return;
 	}
@@ -311,7 +311,7 @@ void MiniMapView::mouseClick(Action *action, State *state)
 		int newX = _camera->getCenterPosition().x + xOff;
 		int newY = _camera->getCenterPosition().y + yOff;
 		_camera->centerOnPosition(Position(newX,newY,_camera->getViewLevel()));
-		_redraw = true;
+		invalidate();
 	}
 }
 
@@ -336,7 +336,7 @@ void MiniMapView::mouseOver(Action *action, State *state)
 			if ((!_mouseMovedOverThreshold) && ((int)(SDL_GetTicks() - _mouseScrollingStartTime) <= (Options::dragScrollTimeTolerance)))
 			{
 					_camera->centerOnPosition(_posBeforeMouseScrolling);
-					_redraw = true;
+					invalidate();
 			}
 			_isMouseScrolled = _isMouseScrolling = false;
 			stopScrolling(action);
@@ -392,7 +392,7 @@ void MiniMapView::mouseOver(Action *action, State *state)
 
 		// Scrolling
 		_camera->centerOnPosition(Position(newX,newY,_camera->getViewLevel()));
-		_redraw = true;
+		invalidate();
 
 		if (Options::touchEnabled == false)
 		{
@@ -443,7 +443,7 @@ void MiniMapView::animate()
 	{
 		_frame = 0;
 	}
-	_redraw = true;
+	invalidate();
 }
 
 void MiniMapView::stopScrolling(Action *action)
@@ -19,12 +19,12 @@
 #include <list>
 #include <algorithm>
 #include "Pathfinding.h"
-#include "PathfindingOpenSet.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Savegame/Tile.h"
 #include "../Mod/Armor.h"
 #include "../Savegame/BattleUnit.h"
 #include "../Engine/Options.h"
+#include "../Engine/FrameProfiler.h"
 #include "BattlescapeGame.h"
 #include "TileEngine.h"
 
@@ -43,7 +43,7 @@ int Pathfinding::green = 4;
  * Sets up a Pathfinding.
  * @param save pointer to SavedBattleGame object.
  */
-Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _unit(0), _pathPreviewed(false), _strafeMove(false), _totalTUCost(0), _modifierUsed(false), _movementType(MT_WALK)
+Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _costFieldClock(0), _unit(0), _pathPreviewed(false), _strafeMove(false), _totalTUCost(0), _modifierUsed(false), _movementType(MT_WALK)
 {
 	_size = _save->getMapSizeXYZ();
 	// Initialize one node per tile
@@ -52,6 +52,11 @@ Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _unit(0), _pathPr
 	{
 		_nodes.push_back(PathfindingNode(_save->getTileCoords(i)));
 	}
+	_openSet.reserve(_size);
+	for (int i = 0; i < COST_FIELD_CACHE_SIZE; ++i)
+	{
+		_costFields[i]._save = _save;
+	}
 }
 
 /**
@@ -82,6 +87,7 @@ PathfindingNode *Pathfinding::getNode(Position pos)
  */
 void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleUnit *target, int maxTUCost)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_PATHFINDING);
 	_totalTUCost = 0;
 	_path.clear();
 	// i'm DONE with these out of bounds errors.
@@ -166,13 +172,14 @@ void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleUnit *
 bool Pathfinding::aStarPath(Position startPosition, Position endPosition, BattleUnit *target, bool sneak, int maxTUCost)
 {
 	// reset every node, so we have to check them all
+	_openSet.clear();
 	for (std::vector<PathfindingNode>::iterator it = _nodes.begin(); it != _nodes.end(); ++it)
 		it->reset();
 
 	// start position is the first one in our "open" list
 	PathfindingNode *start = getNode(startPosition);
 	start->connect(0, 0, 0, endPosition);
-	PathfindingOpenSet openList;
+	PathfindingOpenSet &openList = _openSet;
 	openList.push(start);
 	bool missile = (target && maxTUCost == 10000);
 	// if the open list is empty, we've reached the end
@@ -1139,25 +1146,45 @@ bool Pathfinding::bresenhamPath(Position origin, Position target, BattleUnit *ta
 
 /**
  * Locates all tiles reachable to @a *unit with a TU cost no more than @a tuMax.
- * Uses Dijkstra's algorithm.
+ * Uses Dijkstra's algorithm. The result is cached and returned again for the same unit and limits
+ * until the unit moves or the map changes (see invalidateReachable()).
  * @param unit Pointer to the unit.
- * @param tuMax The maximum cost of the path to each tile.
- * @return An array of reachable tiles, sorted in ascending order of cost. The first tile is the start location.
+ * @param cost The cost of the action the unit wants to keep TUs and energy for.
+ * @return The cost field of all reachable tiles. It stays valid until findReachable is called
+ * with COST_FIELD_CACHE_SIZE other units or limits.
  */
-std::vector<int> Pathfinding::findReachable(BattleUnit *unit, const BattleActionCost &cost)
+const PathfindingCostField &Pathfinding::findReachable(BattleUnit *unit, const BattleActionCost &cost)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_PATHFINDING);
 	const Position start = unit->getPosition();
 	int tuMax = unit->getTimeUnits() - cost.Time;
 	int energyMax = unit->getEnergy() - cost.Energy;
+
+	PathfindingCostField *field = &_costFields[0];
+	for (int i = 0; i < COST_FIELD_CACHE_SIZE; ++i)
+	{
+		if (_costFields[i].matches(unit, tuMax, energyMax))
+		{
+			_costFields[i]._lastUse = ++_costFieldClock;
+			return _costFields[i];
+		}
+		if (field->_valid && (!_costFields[i]._valid || _costFields[i]._lastUse < field->_lastUse))
+		{
+			field = &_costFields[i];
+		}
+	}
+	field->reset(unit, tuMax, energyMax);
+	field->_lastUse = ++_costFieldClock;
+
+	_openSet.clear();
 	for (std::vector<PathfindingNode>::iterator it = _nodes.begin(); it != _nodes.end(); ++it)
 	{
 		it->reset();
 	}
 	PathfindingNode *startNode = getNode(start);
 	startNode->connect(0, 0, 0);
-	PathfindingOpenSet unvisited;
+	PathfindingOpenSet &unvisited = _openSet;
 	unvisited.push(startNode);
-	std::vector<PathfindingNode*> reachable;
 	while (!unvisited.empty())
 	{
 		PathfindingNode *currentNode = unvisited.pop();
@@ -1185,16 +1212,22 @@ std::vector<int> Pathfinding::findReachable(BattleUnit *unit, const BattleAction
 			}
 		}
 		currentNode->setChecked();
-		reachable.push_back(currentNode);
+		PathfindingNode *prevNode = currentNode->getPrevNode();
+		field->set(_save->getTileIndex(currentPos), currentNode->getTUCost(false), currentNode->getPrevDir(), prevNode ? prevNode->getPosition().z : currentPos.z);
 	}
-	std::sort(reachable.begin(), reachable.end(), MinNodeCosts());
-	std::vector<int> tiles;
-	tiles.reserve(reachable.size());
-	for (std::vector<PathfindingNode*>::const_iterator it = reachable.begin(); it != reachable.end(); ++it)
+	return *field;
+}
+
+/**
+ * Discards the cached results of findReachable.
+ * Needs to be called whenever units move or the terrain changes.
+ */
+void Pathfinding::invalidateReachable()
+{
+	for (int i = 0; i < COST_FIELD_CACHE_SIZE; ++i)
 	{
-		tiles.push_back(_save->getTileIndex((*it)->getPosition()));
+		_costFields[i].invalidate();
 	}
-	return tiles;
 }
 
 /**
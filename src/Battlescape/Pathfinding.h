@@ -20,6 +20,8 @@
 #include <vector>
 #include "Position.h"
 #include "PathfindingNode.h"
+#include "PathfindingOpenSet.h"
+#include "PathfindingCostField.h"
 #include "../Mod/MapData.h"
 
 namespace OpenXcom
@@ -43,6 +45,13 @@ private:
 
 	SavedBattleGame *_save;
 	std::vector<PathfindingNode> _nodes;
+	/// Open set shared by all searches, so its storage is reused.
+	PathfindingOpenSet _openSet;
+	/// Number of findReachable results kept at the same time.
+	constexpr static int COST_FIELD_CACHE_SIZE = 3;
+	/// Recent findReachable results, reused while the unit and the map don't change.
+	PathfindingCostField _costFields[COST_FIELD_CACHE_SIZE];
+	int _costFieldClock;
 	int _size;
 	BattleUnit *_unit;
 	bool _pathPreviewed;
@@ -130,7 +139,9 @@ public:
 	/// Sets _unit in order to abuse low-level pathfinding functions from outside the class.
 	void setUnit(BattleUnit *unit);
 	/// Gets all reachable tiles, based on cost.
-	std::vector<int> findReachable(BattleUnit *unit, const BattleActionCost &cost);
+	const PathfindingCostField &findReachable(BattleUnit *unit, const BattleActionCost &cost);
+	/// Discards the cached findReachable results.
+	void invalidateReachable();
 	/// Gets _totalTUCost; finds out whether we can hike somewhere in this turn or not.
 	int getTotalTUCost() const { return _totalTUCost; }
 	/// Gets the path preview setting.
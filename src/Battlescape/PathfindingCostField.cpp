@@ -0,0 +1,166 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PathfindingCostField.h"
+#include "Pathfinding.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/BattleUnit.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Sets up an empty cost field.
+ */
+PathfindingCostField::PathfindingCostField() : _save(0), _unit(0), _tuMax(0), _energyMax(0), _valid(false), _lastUse(0), _generation(0)
+{
+
+}
+
+/**
+ * Gets the entry of a position.
+ * @param pos Map position.
+ * @return Pointer to the entry, or null if the field is empty or the position is off the map.
+ */
+const PathfindingCostField::Entry *PathfindingCostField::getEntry(Position pos) const
+{
+	if (!_valid || !_save->getTile(pos))
+	{
+		return 0;
+	}
+	return &_entries[_save->getTileIndex(pos)];
+}
+
+/**
+ * Marks every tile as unreachable and remembers the parameters of the new search.
+ * @param unit The unit the search is for.
+ * @param tuMax The maximum TU cost of the search.
+ * @param energyMax The maximum energy cost of the search.
+ */
+void PathfindingCostField::reset(BattleUnit *unit, int tuMax, int energyMax)
+{
+	Entry empty = { UNREACHABLE, 0, 0 };
+	_entries.assign(_save->getMapSizeXYZ(), empty);
+	_unit = unit;
+	_origin = unit->getPosition();
+	_tuMax = tuMax;
+	_energyMax = energyMax;
+	_valid = true;
+	_generation++;
+}
+
+/**
+ * Discards the result of the search, so anyone holding
+ * the field can tell it needs to be searched again.
+ */
+void PathfindingCostField::invalidate()
+{
+	_valid = false;
+	_generation++;
+}
+
+/**
+ * Stores the result of the search for a tile.
+ * @param index Tile index.
+ * @param tuCost The cost of reaching the tile.
+ * @param prevDir The direction of the last step to the tile.
+ * @param prevZ The level the last step started from.
+ */
+void PathfindingCostField::set(int index, int tuCost, int prevDir, int prevZ)
+{
+	Entry &entry = _entries[index];
+	entry.tuCost = tuCost;
+	entry.prevDir = prevDir;
+	entry.prevZ = prevZ;
+}
+
+/**
+ * Checks if the field is still valid and was calculated for these parameters.
+ * @param unit The unit the search is for.
+ * @param tuMax The maximum TU cost of the search.
+ * @param energyMax The maximum energy cost of the search.
+ * @return True if the field can be reused.
+ */
+bool PathfindingCostField::matches(BattleUnit *unit, int tuMax, int energyMax) const
+{
+	return _valid && _unit == unit && _origin == unit->getPosition() && _tuMax == tuMax && _energyMax == energyMax;
+}
+
+/**
+ * Checks whether a position can be reached within the limits of the search.
+ * The origin of the search is reachable too.
+ * @param pos Map position.
+ * @return True if the position is reachable.
+ */
+bool PathfindingCostField::isReachable(Position pos) const
+{
+	const Entry *entry = getEntry(pos);
+	return entry && entry->tuCost != UNREACHABLE;
+}
+
+/**
+ * Checks whether a position can be reached by walking at least one step,
+ * which is what Pathfinding::getStartDirection() reports after calculating a path.
+ * @param pos Map position.
+ * @return True if the position is reachable and is not the origin.
+ */
+bool PathfindingCostField::hasPath(Position pos) const
+{
+	return pos != _origin && isReachable(pos);
+}
+
+/**
+ * Gets the TU cost of the cheapest path to a position.
+ * @param pos Map position.
+ * @return The TU cost, or -1 if the position is unreachable.
+ */
+int PathfindingCostField::getTUCost(Position pos) const
+{
+	const Entry *entry = getEntry(pos);
+	if (!entry || entry->tuCost == UNREACHABLE)
+	{
+		return -1;
+	}
+	return entry->tuCost;
+}
+
+/**
+ * Reconstructs the cheapest path to a position.
+ * @param pos Map position.
+ * @param path Receives the directions of the path, in reverse order like Pathfinding::getPath().
+ * @return True if the position is reachable.
+ */
+bool PathfindingCostField::getPath(Position pos, std::vector<int> &path) const
+{
+	path.clear();
+	if (!isReachable(pos))
+	{
+		return false;
+	}
+	while (pos != _origin)
+	{
+		const Entry &entry = _entries[_save->getTileIndex(pos)];
+		Position vector;
+		Pathfinding::directionToVector(entry.prevDir, &vector);
+		path.push_back(entry.prevDir);
+		pos = Position(pos.x - vector.x, pos.y - vector.y, entry.prevZ);
+	}
+	return true;
+}
+
+}
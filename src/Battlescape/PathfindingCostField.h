@@ -0,0 +1,84 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include "Position.h"
+
+namespace OpenXcom
+{
+
+class SavedBattleGame;
+class BattleUnit;
+
+/**
+ * The result of a Dijkstra search from a unit's position.
+ * Holds the cheapest TU cost and the step that leads there for every tile,
+ * so reachability and paths can be looked up without searching again.
+ */
+class PathfindingCostField
+{
+private:
+	/// Marks tiles that can't be reached.
+	static const Uint16 UNREACHABLE = 0xFFFF;
+
+	struct Entry
+	{
+		Uint16 tuCost;
+		Uint8 prevDir;
+		Uint8 prevZ;
+	};
+
+	SavedBattleGame *_save;
+	std::vector<Entry> _entries;
+	BattleUnit *_unit;
+	Position _origin;
+	int _tuMax, _energyMax;
+	bool _valid;
+	int _lastUse;
+	Uint32 _generation;
+	friend class Pathfinding;
+
+	/// Gets the entry of a position, or null if it is outside the map.
+	const Entry *getEntry(Position pos) const;
+	/// Clears the field for a new search.
+	void reset(BattleUnit *unit, int tuMax, int energyMax);
+	/// Discards the result of the search.
+	void invalidate();
+	/// Stores the result of the search for a tile.
+	void set(int index, int tuCost, int prevDir, int prevZ);
+	/// Checks if the field was calculated for these parameters.
+	bool matches(BattleUnit *unit, int tuMax, int energyMax) const;
+public:
+	/// Creates an empty cost field.
+	PathfindingCostField();
+	/// Checks whether a position can be reached.
+	bool isReachable(Position pos) const;
+	/// Checks whether a position can be reached by actually moving there.
+	bool hasPath(Position pos) const;
+	/// Gets the TU cost of reaching a position.
+	int getTUCost(Position pos) const;
+	/// Gets the path to a position.
+	bool getPath(Position pos, std::vector<int> &path) const;
+	/// Gets the number of times the field was recalculated or discarded.
+	Uint32 getGeneration() const { return _generation; }
+	/// Gets the position the field was calculated from.
+	Position getOrigin() const { return _origin; }
+};
+
+}
@@ -24,29 +24,88 @@ namespace OpenXcom
 {
 
 /**
- * Cleans up all the entries still in set.
+ * Gets the priority used to order nodes in the heap.
+ * @param node Pointer to the node.
+ * @return Cost so far plus the estimate of the remaining cost.
  */
-PathfindingOpenSet::~PathfindingOpenSet()
+inline int PathfindingOpenSet::getCost(const PathfindingNode *node)
 {
-	while (!_queue.empty())
+	return node->getTUCost(false) + node->getTUGuess();
+}
+
+/**
+ * Stores the node in a heap slot and updates the node's back reference.
+ * @param node Pointer to the node.
+ * @param index Heap slot.
+ */
+inline void PathfindingOpenSet::place(PathfindingNode *node, int index)
+{
+	_heap[index] = node;
+	node->_openIndex = index;
+}
+
+/**
+ * Moves the node at the given slot up until its parent is not more expensive.
+ * @param index Heap slot.
+ */
+void PathfindingOpenSet::siftUp(int index)
+{
+	PathfindingNode *node = _heap[index];
+	const int cost = getCost(node);
+	while (index > 0)
 	{
-		OpenSetEntry *entry = _queue.top();
-		_queue.pop();
-		delete entry;
+		int parent = (index - 1) / 2;
+		if (getCost(_heap[parent]) <= cost)
+			break;
+		place(_heap[parent], index);
+		index = parent;
 	}
+	place(node, index);
 }
 
 /**
- * Keeps removing all discarded entries that have come to the top of the queue.
+ * Moves the node at the given slot down until none of its children is cheaper.
+ * @param index Heap slot.
  */
-void PathfindingOpenSet::removeDiscarded()
+void PathfindingOpenSet::siftDown(int index)
 {
-	while (!_queue.empty() && !_queue.top()->_node)
+	PathfindingNode *node = _heap[index];
+	const int cost = getCost(node);
+	const int size = (int)_heap.size();
+	while (true)
 	{
-		OpenSetEntry *entry = _queue.top();
-		_queue.pop();
-		delete entry;
+		int child = 2 * index + 1;
+		if (child >= size)
+			break;
+		int childCost = getCost(_heap[child]);
+		if (child + 1 < size)
+		{
+			int rightCost = getCost(_heap[child + 1]);
+			if (rightCost < childCost)
+			{
+				++child;
+				childCost = rightCost;
+			}
+		}
+		if (cost <= childCost)
+			break;
+		place(_heap[child], index);
+		index = child;
 	}
+	place(node, index);
+}
+
+/**
+ * Removes all the nodes still in set.
+ * The storage is kept for the next search.
+ */
+void PathfindingOpenSet::clear()
+{
+	for (std::vector<PathfindingNode*>::iterator it = _heap.begin(); it != _heap.end(); ++it)
+	{
+		(*it)->_openIndex = -1;
+	}
+	_heap.clear();
 }
 
 /**
@@ -57,33 +116,33 @@ void PathfindingOpenSet::removeDiscarded()
 PathfindingNode *PathfindingOpenSet::pop()
 {
 	assert(!empty());
-	OpenSetEntry *entry = _queue.top();
-	PathfindingNode *nd = entry->_node;
-	_queue.pop();
-	delete entry;
-	nd->_openentry = 0;
-
-	// Discarded entries might be visible now.
-	removeDiscarded();
+	PathfindingNode *nd = _heap.front();
+	PathfindingNode *last = _heap.back();
+	_heap.pop_back();
+	if (!_heap.empty())
+	{
+		place(last, 0);
+		siftDown(0);
+	}
+	nd->_openIndex = -1;
 	return nd;
 }
 
 /**
  * Places the node in the set.
- * If the node was already in the set, the previous entry is discarded.
+ * If the node was already in the set, its position is updated to the new cost.
  * It is the caller's responsibility to never re-add a node with a worse cost.
  * @param node A pointer to the node to add.
  */
 void PathfindingOpenSet::push(PathfindingNode *node)
 {
-	OpenSetEntry *entry = new OpenSetEntry;
-	entry->_node = node;
-	entry->_cost = node->getTUCost(false) + node->getTUGuess();
-	if (node->_openentry)
-		node->_openentry->_node = 0;
-	node->_openentry = entry;
-	_queue.push(entry);
+	if (node->_openIndex < 0)
+	{
+		_heap.push_back(node);
+		node->_openIndex = (int)_heap.size() - 1;
+	}
+	assert(_heap[node->_openIndex] == node);
+	siftUp(node->_openIndex);
 }
 
-
 }
@@ -17,57 +17,44 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include <queue>
+#include <vector>
 
 namespace OpenXcom
 {
 
 class PathfindingNode;
 
-struct OpenSetEntry
-{
-	int _cost;
-	PathfindingNode *_node;
-};
-
-/**
- * Helper class to compare entries through pointers.
- */
-class EntryCompare
-{
-public:
-	/**
-	 * Compares entries @a *a and @a *b.
-	 * @param a Pointer to first entry.
-	 * @param b Pointer to second entry.
-	 * @return True if entry @a *b must come before @a *a.
-	 */
-	bool operator()(OpenSetEntry *a, OpenSetEntry *b) const
-	{
-		return b->_cost < a->_cost;
-	}
-};
-
 /**
  * A class that holds references to the nodes to be examined in pathfinding.
+ * It is an indexed binary min-heap: every node knows its own slot in the heap,
+ * so an improved cost is applied in place instead of leaving a stale entry behind.
+ * The storage is kept between searches, so a reused set does not allocate.
  */
 class PathfindingOpenSet
 {
 public:
-	/// Cleans up the set and frees allocated memory.
-	~PathfindingOpenSet();
 	/// Gets the next node to check.
 	PathfindingNode *pop();
 	/// Adds a node to the set.
 	void push(PathfindingNode *node);
+	/// Removes all nodes from the set, keeping the allocated storage.
+	void clear();
+	/// Reserves storage for a number of nodes.
+	void reserve(int size) { _heap.reserve(size); }
 	/// Is the set empty?
-	bool empty() const { return _queue.empty(); }
+	bool empty() const { return _heap.empty(); }
 
 private:
-	std::priority_queue<OpenSetEntry*, std::vector<OpenSetEntry*>, EntryCompare> _queue;
-
-	/// Removes reachable discarded entries.
-	void removeDiscarded();
+	std::vector<PathfindingNode*> _heap;
+
+	/// Gets the heap priority of a node.
+	static int getCost(const PathfindingNode *node);
+	/// Stores a node in a heap slot.
+	void place(PathfindingNode *node, int index);
+	/// Moves a node towards the top of the heap.
+	void siftUp(int index);
+	/// Moves a node towards the bottom of the heap.
+	void siftDown(int index);
 };
 
 }
@@ -40,7 +40,7 @@ namespace OpenXcom
  */
 ScannerView::ScannerView (int w, int h, int x, int y, Game * game, BattleUnit *unit) : InteractiveSurface(w, h, x, y), _game(game), _unit(unit), _frame(0)
 {
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -104,7 +104,7 @@ void ScannerView::animate()
 	{
 		_frame = 0;
 	}
-	_redraw = true;
+	invalidate();
 }
 
 }
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SpriteCache.h"
+#include "../Engine/Surface.h"
+#include "../Engine/Script.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty sprite cache.
+ * @param budget Memory available for sprites, in bytes. Zero disables the cache.
+ */
+SpriteCache::SpriteCache(size_t budget) : _size(0), _budget(budget), _turn(-1)
+{
+}
+
+/**
+ * Deletes all cached sprites.
+ */
+SpriteCache::~SpriteCache()
+{
+	clear();
+}
+
+/**
+ * Gets the memory used by a cached sprite, including bookkeeping.
+ * @param surface Cached sprite, or null for a failed recolor.
+ * @return Size in bytes.
+ */
+size_t SpriteCache::getCost(const Surface *surface)
+{
+	size_t cost = sizeof(Entry) + 64;
+	if (surface)
+	{
+		cost += surface->getWidth() * surface->getHeight() + sizeof(Surface);
+	}
+	return cost;
+}
+
+/**
+ * Gets a cached sprite and marks it as the most recently used.
+ * @param key Sprite and recolor script inputs.
+ * @return Recolored sprite, or null if not cached or the recolor failed.
+ */
+Surface *SpriteCache::get(const Key &key)
+{
+	auto i = _index.find(key);
+	if (i == _index.end())
+	{
+		return nullptr;
+	}
+	_entries.splice(_entries.begin(), _entries, i->second);
+	return i->second->surface;
+}
+
+/**
+ * Adds a sprite to the cache, dropping the least recently
+ * used ones if it goes over budget.
+ * @param key Sprite and recolor script inputs.
+ * @param surface Recolored sprite, owned by the cache from now on,
+ * or null to remember that the recolor failed.
+ * @return False if the sprite was rejected and deleted.
+ */
+bool SpriteCache::add(const Key &key, Surface *surface)
+{
+	size_t cost = getCost(surface);
+	if (cost > _budget || _index.find(key) != _index.end())
+	{
+		delete surface;
+		return false;
+	}
+	while (_size + cost > _budget)
+	{
+		Entry &last = _entries.back();
+		_size -= getCost(last.surface);
+		_index.erase(last.key);
+		delete last.surface;
+		_entries.pop_back();
+	}
+	_entries.push_front(Entry{ key, surface });
+	_index[key] = _entries.begin();
+	_size += cost;
+	return true;
+}
+
+/**
+ * Blits a sprite recolored by script. The recolored sprite is cached
+ * when the script result depends only on the source pixels, otherwise
+ * the script is run on every pixel like ScriptWorkerBlit::executeBlit.
+ * Sprites the script failed to recolor are remembered as such.
+ * @param work Script worker already filled for this sprite.
+ * @param key Sprite and recolor script inputs.
+ * @param src Source sprite.
+ * @param dest Destination surface.
+ * @param x X offset of the sprite.
+ * @param y Y offset of the sprite.
+ * @param shade Shade used when there is no script.
+ * @param mask Area of the destination to draw to.
+ */
+void SpriteCache::blit(ScriptWorkerBlit &work, const Key &key, Surface *src, Surface *dest, int x, int y, int shade, GraphSubset mask)
+{
+	if (isEnabled() && work.canRecolor())
+	{
+		Surface *cached = nullptr;
+		auto i = _index.find(key);
+		if (i != _index.end())
+		{
+			cached = get(key);
+		}
+		else
+		{
+			Surface *surface = new Surface(src->getWidth(), src->getHeight());
+			if (!work.executeRecolor(src, surface))
+			{
+				// cache the failure too, so it isn't tried again every frame
+				delete surface;
+				surface = nullptr;
+			}
+			if (add(key, surface))
+			{
+				cached = surface;
+			}
+		}
+		if (cached)
+		{
+			cached->blitNShade(dest, x, y, 0, mask);
+			return;
+		}
+	}
+	work.executeBlit(src, dest, x, y, shade, mask);
+}
+
+/**
+ * Deletes all cached sprites.
+ */
+void SpriteCache::clear()
+{
+	for (auto &e : _entries)
+	{
+		delete e.surface;
+	}
+	_entries.clear();
+	_index.clear();
+	_size = 0;
+}
+
+/**
+ * Recolor scripts can also read battle state that isn't part
+ * of the key, so sprites are never kept from one turn to the next.
+ * @param turn Current battle turn.
+ */
+void SpriteCache::setTurn(int turn)
+{
+	if (turn != _turn)
+	{
+		clear();
+		_turn = turn;
+	}
+}
+
+}
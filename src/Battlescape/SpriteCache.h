@@ -0,0 +1,109 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <list>
+#include <map>
+#include <tuple>
+#include <SDL_types.h>
+#include "../Engine/GraphSubset.h"
+
+namespace OpenXcom
+{
+
+class Surface;
+class ScriptWorkerBlit;
+
+/**
+ * Keeps the most recently used script-recolored unit and item
+ * sprites, so parts that didn't change since the last frame are
+ * drawn with a plain blit instead of running the recolor script.
+ */
+class SpriteCache
+{
+public:
+	/**
+	 * Everything the recolor script of a sprite is given.
+	 */
+	struct Key
+	{
+		const void *owner;
+		const void *rule;
+		const Surface *src;
+		int part, frame, shade, burn;
+		Uint64 state;
+
+		bool operator<(const Key &other) const
+		{
+			return std::tie(owner, rule, src, part, frame, shade, burn, state) < std::tie(other.owner, other.rule, other.src, other.part, other.frame, other.shade, other.burn, other.state);
+		}
+	};
+
+	/**
+	 * Hash of the unit or item state its recolor script can read,
+	 * so a sprite is recolored again as soon as that state changes.
+	 */
+	class StateHash
+	{
+		Uint64 _hash;
+	public:
+		/// Creates an empty hash.
+		StateHash() : _hash(0) { }
+		/// Adds a value to the hash.
+		void add(Uint64 value) { _hash ^= value + 0x9e3779b97f4a7c15ULL + (_hash << 6) + (_hash >> 2); }
+		/// Adds a pointer to the hash.
+		void add(const void *value) { add((Uint64)(size_t)value); }
+		/// Adds all values to the hash.
+		template<typename T>
+		void add(const T *begin, const T *end) { for (; begin != end; ++begin) add((Uint64)*begin); }
+		/// Gets the hash.
+		Uint64 get() const { return _hash; }
+	};
+private:
+	struct Entry
+	{
+		Key key;
+		Surface *surface;
+	};
+	std::list<Entry> _entries;
+	std::map<Key, std::list<Entry>::iterator> _index;
+	size_t _size, _budget;
+	int _turn;
+
+	/// Gets the memory used by a surface.
+	static size_t getCost(const Surface *surface);
+public:
+	/// Creates an empty cache.
+	SpriteCache(size_t budget);
+	/// Cleans up the cache.
+	~SpriteCache();
+	/// Checks if the cache can hold anything.
+	bool isEnabled() const { return _budget > 0; }
+	/// Gets a cached sprite.
+	Surface *get(const Key &key);
+	/// Adds a sprite to the cache.
+	bool add(const Key &key, Surface *surface);
+	/// Blits a sprite recolored by script, using the cache when possible.
+	void blit(ScriptWorkerBlit &work, const Key &key, Surface *src, Surface *dest, int x, int y, int shade, GraphSubset mask);
+	/// Drops all cached sprites.
+	void clear();
+	/// Drops all cached sprites when a new turn begins.
+	void setTurn(int turn);
+};
+
+}
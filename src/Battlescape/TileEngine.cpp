@@ -45,6 +45,7 @@
 #include "Pathfinding.h"
 #include "../Engine/Game.h"
 #include "../Engine/Options.h"
+#include "../Engine/FrameProfiler.h"
 #include "ProjectileFlyBState.h"
 #include "MeleeAttackBState.h"
 #include "../fmath.h"
@@ -211,6 +212,36 @@ MapSubset mapAreaExpand(MapSubset gs, int radius)
 	return { std::make_pair(gs.beg_x - radius, gs.end_x + radius), std::make_pair(gs.beg_y - radius, gs.end_y + radius) };
 }
 
+/**
+ * Directions of rays cast by explosions, every 3 degrees horizontally and 5 degrees vertically.
+ */
+struct ExplosionRays
+{
+	static const int stepTe = 3;
+	static const int stepFi = 5;
+	static const int countTe = 360 / stepTe + 1;
+	static const int countFi = 180 / stepFi + 1;
+
+	double sinTe[countTe], cosTe[countTe];
+	double sinFi[countFi], cosFi[countFi];
+
+	ExplosionRays()
+	{
+		for (int i = 0; i < countTe; ++i)
+		{
+			cosTe[i] = cos(Deg2Rad(i * stepTe));
+			sinTe[i] = sin(Deg2Rad(i * stepTe));
+		}
+		for (int i = 0; i < countFi; ++i)
+		{
+			sinFi[i] = sin(Deg2Rad(i * stepFi - 90));
+			cosFi[i] = cos(Deg2Rad(i * stepFi - 90));
+		}
+	}
+};
+
+const ExplosionRays explosionRays;
+
 } // namespace
 
 constexpr int TileEngine::heightFromCenter[11];
@@ -228,13 +259,14 @@ constexpr Position TileEngine::voxelTileCenter;
  * @param maxDarknessToSeeUnits Threshold of darkness for LoS calculation.
  */
 TileEngine::TileEngine(SavedBattleGame *save, Mod *mod) :
-	_save(save), _voxelData(mod->getVoxelData()), _inventorySlotGround(mod->getInventoryGround()), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0),
+	_save(save), _voxelData(mod->getVoxelData()), _explosionStamp(0), _inventorySlotGround(mod->getInventoryGround()), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0),
 	_maxViewDistance(mod->getMaxViewDistance()), _maxViewDistanceSq(_maxViewDistance * _maxViewDistance),
 	_maxVoxelViewDistance(_maxViewDistance * 16), _maxDarknessToSeeUnits(mod->getMaxDarknessToSeeUnits()),
 	_maxStaticLightDistance(mod->getMaxStaticLightDistance()), _maxDynamicLightDistance(mod->getMaxDynamicLightDistance()),
 	_enhancedLighting(mod->getEnhancedLighting())
 {
 	_blockVisibility.resize(save->getMapSizeXYZ());
+	_explosionTiles.resize(save->getMapSizeXYZ());
 	_cacheTilePos = invalid;
 }
 
@@ -251,6 +283,7 @@ TileEngine::~TileEngine()
   */
 void TileEngine::calculateSunShading(MapSubset gs)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_LIGHTING);
 	int power = 15 - _save->getGlobalShade();
 
 	iterateTiles(
@@ -286,6 +319,7 @@ void TileEngine::calculateSunShading(MapSubset gs)
   */
 void TileEngine::calculateTerrainBackground(MapSubset gs)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_LIGHTING);
 	const int fireLightPower = 15; // amount of light a fire generates
 
 	// add lighting of fire
@@ -333,6 +367,7 @@ void TileEngine::calculateTerrainBackground(MapSubset gs)
   */
 void TileEngine::calculateTerrainItems(MapSubset gs)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_LIGHTING);
 	// add lighting of terrain
 	iterateTiles(
 		_save,
@@ -363,6 +398,7 @@ void TileEngine::calculateTerrainItems(MapSubset gs)
   */
 void TileEngine::calculateUnitLighting(MapSubset gs)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_LIGHTING);
 	const int fireLightPower = 15; // amount of light a fire generates
 
 	for (BattleUnit *unit : *_save->getUnits())
@@ -410,6 +446,7 @@ void TileEngine::calculateUnitLighting(MapSubset gs)
 
 void TileEngine::calculateLighting(LightLayers layer, Position position, int eventRadius, bool terrianChanged)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_LIGHTING);
 	auto gsDynamic = MapSubset{ _save->getMapSizeX(), _save->getMapSizeY() };
 	auto gsStatic = gsDynamic;
 
@@ -744,6 +781,7 @@ inline bool TileEngine::inEventVisibilitySector(const Position &toCheck) const
 */
 bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos, const int eventRadius)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_FOV);
 	size_t oldNumVisibleUnits = unit->getUnitsSpottedThisTurn().size();
 	bool useTurretDirection = false;
 	if (Options::strafe && (unit->getTurretType() > -1)) {
@@ -834,6 +872,7 @@ bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos,
 */
 void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos, const int eventRadius)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_FOV);
 	bool useTurretDirection = false;
 	bool skipNarrowArcTest = false;
 	int direction;
@@ -964,6 +1003,7 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 */
 bool TileEngine::calculateFOV(BattleUnit *unit, bool doTileRecalc, bool doUnitRecalc)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_FOV);
 	//Force a full FOV recheck for this unit.
 	if (doTileRecalc) calculateTilesInFOV(unit);
 	return doUnitRecalc ? calculateUnitsInFOV(unit) : false;
@@ -1691,6 +1731,7 @@ bool TileEngine::canTargetTile(Position *originVoxel, Tile *tile, int part, Posi
  */
 void TileEngine::calculateFOV(Position position, int eventRadius, const bool updateTiles, const bool appendToTileVisibility)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_FOV);
 	int updateRadius;
 	if (eventRadius == -1)
 	{
@@ -2471,6 +2512,10 @@ void TileEngine::hit(BattleActionAttack attack, Position center, int power, cons
 			{
 				_save->addDestroyedObjective();
 			}
+			if (terrainChanged)
+			{
+				_save->getPathfinding()->invalidateReachable();
+			}
 		}
 	}
 	else if (part == V_UNIT)
@@ -2538,9 +2583,18 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	int hitSide = 0;
 	int diagonalWall = 0;
 	int power_;
-	std::map<Tile*, int> tilesAffected;
 	std::vector<BattleItem*> toRemove;
-	std::pair<std::map<Tile*, int>::iterator, bool> ret;
+
+	// new stamp invalidates tiles of previous explosions
+	_explosionAffected.clear();
+	if (++_explosionStamp == 0)
+	{
+		for (auto& t : _explosionTiles)
+		{
+			t.stamp = 0;
+		}
+		_explosionStamp = 1;
+	}
 
 	if (type->FireBlastCalc)
 	{
@@ -2573,15 +2627,15 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 			hitSide = (center.x % 16 + center.y % 16 - 15) > 0 ? 1 : -1;
 	}
 
-	for (int fi = -90; fi <= 90; fi += 5)
+	for (int fi = -90; fi <= 90; fi += ExplosionRays::stepFi)
 	{
 		// raytrace every 3 degrees makes sure we cover all tiles in a circle.
-		for (int te = 0; te <= 360; te += 3)
+		for (int te = 0; te <= 360; te += ExplosionRays::stepTe)
 		{
-			double cos_te = cos(Deg2Rad(te));
-			double sin_te = sin(Deg2Rad(te));
-			double sin_fi = sin(Deg2Rad(fi));
-			double cos_fi = cos(Deg2Rad(fi));
+			const double cos_te = explosionRays.cosTe[te / ExplosionRays::stepTe];
+			const double sin_te = explosionRays.sinTe[te / ExplosionRays::stepTe];
+			const double sin_fi = explosionRays.sinFi[(fi + 90) / ExplosionRays::stepFi];
+			const double cos_fi = explosionRays.cosFi[(fi + 90) / ExplosionRays::stepFi];
 
 			origin = _save->getTile(centetTile);
 			dest = origin;
@@ -2592,14 +2646,22 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 			{
 				if (power_ > 0)
 				{
-					ret = tilesAffected.insert(std::make_pair(dest, 0)); // check if we had this tile already affected
+					const int index = _save->getTileIndex(dest->getPosition());
+					ExplosionTile &affected = _explosionTiles[index];
+					const bool firstHit = affected.stamp != _explosionStamp; // check if we had this tile already affected
+					if (firstHit)
+					{
+						affected.stamp = _explosionStamp;
+						affected.damage = 0;
+						_explosionAffected.push_back(index);
+					}
 
 					const int tileDmg = type->getTileFinalDamage(power_);
-					if (tileDmg > ret.first->second)
+					if (tileDmg > affected.damage)
 					{
-						ret.first->second = tileDmg;
+						affected.damage = tileDmg;
 					}
-					if (ret.second)
+					if (firstHit)
 					{
 						const int damage = type->getRandomDamage(power_);
 						BattleUnit *bu = dest->getOverlappingUnit(_save);
@@ -2706,14 +2768,17 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	// now detonate the tiles affected by explosion
 	if (type->ToTile > 0.0f)
 	{
-		for (std::map<Tile*, int>::iterator i = tilesAffected.begin(); i != tilesAffected.end(); ++i)
+		// same order as tiles in map
+		std::sort(_explosionAffected.begin(), _explosionAffected.end());
+		for (int index : _explosionAffected)
 		{
-			if (detonate(i->first, i->second))
+			Tile *tile = _save->getTile(index);
+			if (detonate(tile, _explosionTiles[index].damage))
 			{
 				_save->addDestroyedObjective();
 			}
-			applyGravity(i->first);
-			Tile *j = _save->getTile(i->first->getPosition() + Position(0,0,1));
+			applyGravity(tile);
+			Tile *j = _save->getTile(tile->getPosition() + Position(0,0,1));
 			if (j)
 				applyGravity(j);
 		}
@@ -2808,6 +2873,7 @@ bool TileEngine::detonate(Tile* tile, int explosive)
 				currentpart2 = currentpart;
 			if (tiles[i]->destroy(currentpart, _save->getObjectiveType()))
 				objective = true;
+			_save->getPathfinding()->invalidateReachable();
 			currentpart =  currentpart2;
 			if (tiles[i]->getMapData(currentpart)) // take new values
 			{
@@ -3357,6 +3423,7 @@ int TileEngine::unitOpensDoor(BattleUnit *unit, bool rClick, int dir)
 					door = tile->openDoor(i->second, unit, _save->getBattleGame()->getReservedAction(), rClick);
 					if (door != -1)
 					{
+						_save->getPathfinding()->invalidateReachable();
 						part = i->second;
 						if (door == 0)
 						{
@@ -3481,6 +3548,10 @@ int TileEngine::closeUfoDoors()
 		}
 		doorsclosed += _save->getTile(i)->closeUfoDoor();
 	}
+	if (doorsclosed)
+	{
+		_save->getPathfinding()->invalidateReachable();
+	}
 
 	return doorsclosed;
 }
@@ -4850,6 +4921,7 @@ bool TileEngine::validateThrow(BattleAction &action, Position originVoxel, Posit
  */
 void TileEngine::recalculateFOV()
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_FOV);
 	for (std::vector<BattleUnit*>::iterator bu = _save->getUnits()->begin(); bu != _save->getUnits()->end(); ++bu)
 	{
 		if ((*bu)->getTile() != 0)
@@ -79,6 +79,14 @@ private:
 		Uint8 smoke: 1;
 		Uint8 fire: 1;
 	};
+	/**
+	 * Helper class storing damage of explosion on tile.
+	 */
+	struct ExplosionTile
+	{
+		Uint32 stamp;
+		int damage;
+	};
 	/**
 	 * Helper class storing reaction data.
 	 */
@@ -94,6 +102,9 @@ private:
 	SavedBattleGame *_save;
 	std::vector<Uint16> *_voxelData;
 	std::vector<VisibilityBlockCache> _blockVisibility;
+	std::vector<ExplosionTile> _explosionTiles;
+	std::vector<int> _explosionAffected;
+	Uint32 _explosionStamp;
 	RuleInventory *_inventorySlotGround;
 	constexpr static int heightFromCenter[11] = {0,-2,+2,-4,+4,-6,+6,-8,+8,-12,+12};
 	bool _personalLighting;
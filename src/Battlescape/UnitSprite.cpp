@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "UnitSprite.h"
+#include "SpriteCache.h"
 #include "../Engine/SurfaceSet.h"
 #include "../Mod/RuleItem.h"
 #include "../Mod/Armor.h"
@@ -40,14 +41,14 @@ namespace OpenXcom
  * @param x X position in pixels.
  * @param y Y position in pixels.
  */
-UnitSprite::UnitSprite(Surface* dest, Mod* mod, int frame, bool helmet) :
+UnitSprite::UnitSprite(Surface* dest, Mod* mod, SpriteCache* cache, int frame, bool helmet) :
 	_unit(0), _itemR(0), _itemL(0),
 	_unitSurface(0),
 	_itemSurface(mod->getSurfaceSet("HANDOB.PCK")),
 	_fireSurface(mod->getSurfaceSet("SMOKE.PCK")),
 	_breathSurface(mod->getSurfaceSet("BREATH-1.PCK", false)),
 	_facingArrowSurface(mod->getSurfaceSet("DETBLOB.DAT")),
-	_dest(dest), _mod(mod),
+	_dest(dest), _mod(mod), _cache(cache),
 	_part(0), _animationFrame(frame), _drawingRoutine(0),
 	_helmet(helmet),
 	_x(0), _y(0), _shade(0), _burn(0),
@@ -145,12 +146,14 @@ void UnitSprite::blitItem(Part& item)
 	{
 		return;
 	}
+	BattleItem *battleItem = (item.bodyPart == BODYPART_ITEM_RIGHTHAND ? _itemR : _itemL);
 	ScriptWorkerBlit work;
-	BattleItem::ScriptFill(&work, (item.bodyPart == BODYPART_ITEM_RIGHTHAND ? _itemR : _itemL), item.bodyPart, _animationFrame, _shade);
+	BattleItem::ScriptFill(&work, battleItem, item.bodyPart, _animationFrame, _shade);
 
 	_dest->lock();
 
-	work.executeBlit(item.src, _dest,  _x + item.offX, _y + item.offY, _shade, _mask);
+	SpriteCache::Key key = { battleItem, battleItem->getRules(), item.src, item.bodyPart, _animationFrame, _shade, 0, battleItem->getSpriteState() };
+	_cache->blit(work, key, item.src, _dest,  _x + item.offX, _y + item.offY, _shade, _mask);
 
 	_dest->unlock();
 }
@@ -170,7 +173,8 @@ void UnitSprite::blitBody(Part& body)
 
 	_dest->lock();
 
-	work.executeBlit(body.src, _dest,  _x + body.offX, _y + body.offY, _shade, _mask);
+	SpriteCache::Key key = { _unit, _unit->getArmor(), body.src, body.bodyPart, _animationFrame, _shade, _burn, _unit->getSpriteState() };
+	_cache->blit(work, key, body.src, _dest,  _x + body.offX, _y + body.offY, _shade, _mask);
 
 	_dest->unlock();
 }
@@ -107,7 +107,7 @@ void WarningMessage::showMessage(const std::string &msg)
 {
 	_text->setText(msg);
 	_fade = 0;
-	_redraw = true;
+	invalidate();
 	setVisible(true);
 	_timer->start();
 }
@@ -126,7 +126,7 @@ void WarningMessage::think()
 void WarningMessage::fade()
 {
 	_fade++;
-	_redraw = true;
+	invalidate();
 	if (_fade == 24)
 	{
 		setVisible(false);
@@ -0,0 +1,738 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BinaryYaml.h"
+#include <string.h>
+#include <unordered_map>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <SDL.h>
+#include "CrossPlatform.h"
+#include "Exception.h"
+#include "Logger.h"
+
+#define MINIZ_NO_STDIO
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "../../libs/miniz/miniz.h"
+
+namespace OpenXcom
+{
+
+namespace BinaryYaml
+{
+
+namespace
+{
+
+/*
+ * File layout:
+ *   "OXBY" signature, format version byte
+ *   per document: flags byte, raw size (u32), stored size (u32), stored bytes
+ * All numbers are little-endian. Inside a document every node starts
+ * with a type byte followed by its YAML tag,
+ * counts and lengths are stored as LEB128 varints.
+ */
+const char SIGNATURE[4] = { 'O', 'X', 'B', 'Y' };
+const Uint8 FORMAT_VERSION = 2;
+/// Deflate can't shrink data by more than about this much, larger raw sizes are corrupt.
+const Uint32 MAX_DEFLATE_RATIO = 1032;
+const size_t FILE_HEADER_SIZE = 5;
+const size_t CHUNK_HEADER_SIZE = 9;
+const int MAX_DEPTH = 256;
+
+enum ChunkFlags : Uint8 { CHUNK_DEFLATE = 1 };
+enum NodeTag : Uint8 { TAG_NULL, TAG_SCALAR, TAG_SCALAR_REF, TAG_SEQUENCE, TAG_MAP, TAG_FLOW_SEQUENCE, TAG_FLOW_MAP };
+
+void writeU32(std::vector<Uint8> &out, Uint32 value)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		out.push_back((Uint8)(value >> (8 * i)));
+	}
+}
+
+Uint32 readU32(const Uint8 *data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | ((Uint32)data[3] << 24);
+}
+
+/**
+ * Serializes a node tree into a chunk.
+ */
+class Writer
+{
+	std::vector<Uint8> &_out;
+	std::unordered_map<std::string, Uint32> _strings, _tags;
+
+	void writeNumber(size_t value)
+	{
+		while (value >= 0x80)
+		{
+			_out.push_back((Uint8)(value | 0x80));
+			value >>= 7;
+		}
+		_out.push_back((Uint8)value);
+	}
+
+	/**
+	 * Writes the tag of a node: the index of a tag already
+	 * seen plus one, or zero followed by a new tag.
+	 */
+	void writeTag(const YAML::Node &node)
+	{
+		const std::string &tag = node.Tag();
+		auto i = _tags.find(tag);
+		if (i != _tags.end())
+		{
+			writeNumber(i->second + 1);
+		}
+		else
+		{
+			Uint32 index = (Uint32)_tags.size();
+			_tags[tag] = index;
+			writeNumber(0);
+			writeNumber(tag.size());
+			_out.insert(_out.end(), tag.begin(), tag.end());
+		}
+	}
+public:
+	Writer(std::vector<Uint8> &out) : _out(out)
+	{
+	}
+
+	void writeNode(const YAML::Node &node)
+	{
+		switch (node.Type())
+		{
+		case YAML::NodeType::Scalar:
+			{
+				const std::string &value = node.Scalar();
+				auto i = _strings.find(value);
+				if (i != _strings.end())
+				{
+					_out.push_back(TAG_SCALAR_REF);
+					writeTag(node);
+					writeNumber(i->second);
+				}
+				else
+				{
+					Uint32 index = (Uint32)_strings.size();
+					_strings[value] = index;
+					_out.push_back(TAG_SCALAR);
+					writeTag(node);
+					writeNumber(value.size());
+					_out.insert(_out.end(), value.begin(), value.end());
+				}
+			}
+			break;
+		case YAML::NodeType::Sequence:
+			_out.push_back(node.Style() == YAML::EmitterStyle::Flow ? TAG_FLOW_SEQUENCE : TAG_SEQUENCE);
+			writeTag(node);
+			writeNumber(node.size());
+			for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+			{
+				writeNode(*i);
+			}
+			break;
+		case YAML::NodeType::Map:
+			_out.push_back(node.Style() == YAML::EmitterStyle::Flow ? TAG_FLOW_MAP : TAG_MAP);
+			writeTag(node);
+			writeNumber(node.size());
+			for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+			{
+				writeNode(i->first);
+				writeNode(i->second);
+			}
+			break;
+		default:
+			_out.push_back(TAG_NULL);
+			writeTag(node);
+			break;
+		}
+	}
+};
+
+/**
+ * Rebuilds a node tree from a chunk.
+ */
+class Reader
+{
+	const Uint8 *_pos, *_end;
+	std::vector<std::string> _strings, _tags;
+
+	void fail()
+	{
+		throw Exception("Corrupted binary YAML data");
+	}
+
+	Uint8 readByte()
+	{
+		if (_pos == _end)
+		{
+			fail();
+		}
+		return *_pos++;
+	}
+
+	size_t readNumber()
+	{
+		size_t value = 0;
+		for (int shift = 0; shift < 35; shift += 7)
+		{
+			Uint8 b = readByte();
+			value |= (size_t)(b & 0x7F) << shift;
+			if (!(b & 0x80))
+			{
+				return value;
+			}
+		}
+		fail();
+		return 0;
+	}
+
+	std::string readString()
+	{
+		size_t length = readNumber();
+		if (length > (size_t)(_end - _pos))
+		{
+			fail();
+		}
+		std::string value((const char*)_pos, length);
+		_pos += length;
+		return value;
+	}
+
+	/**
+	 * Reads the tag of a node.
+	 */
+	void readTag(YAML::Node &node)
+	{
+		size_t index = readNumber();
+		if (index == 0)
+		{
+			_tags.push_back(readString());
+			index = _tags.size();
+		}
+		else if (index > _tags.size())
+		{
+			fail();
+		}
+		node.SetTag(_tags[index - 1]);
+	}
+public:
+	Reader(const Uint8 *data, size_t size) : _pos(data), _end(data + size)
+	{
+	}
+
+	YAML::Node readNode(int depth = 0)
+	{
+		if (depth > MAX_DEPTH)
+		{
+			fail();
+		}
+		Uint8 tag = readByte();
+		switch (tag)
+		{
+		case TAG_NULL:
+			{
+				YAML::Node node;
+				readTag(node);
+				return node;
+			}
+		case TAG_SCALAR:
+			{
+				YAML::Node node(YAML::NodeType::Scalar);
+				readTag(node);
+				_strings.push_back(readString());
+				node = _strings.back();
+				return node;
+			}
+		case TAG_SCALAR_REF:
+			{
+				YAML::Node node(YAML::NodeType::Scalar);
+				readTag(node);
+				size_t index = readNumber();
+				if (index >= _strings.size())
+				{
+					fail();
+				}
+				node = _strings[index];
+				return node;
+			}
+		case TAG_SEQUENCE:
+		case TAG_FLOW_SEQUENCE:
+			{
+				YAML::Node node(YAML::NodeType::Sequence);
+				readTag(node);
+				if (tag == TAG_FLOW_SEQUENCE)
+				{
+					node.SetStyle(YAML::EmitterStyle::Flow);
+				}
+				for (size_t i = readNumber(); i > 0; --i)
+				{
+					node.push_back(readNode(depth + 1));
+				}
+				return node;
+			}
+		case TAG_MAP:
+		case TAG_FLOW_MAP:
+			{
+				YAML::Node node(YAML::NodeType::Map);
+				readTag(node);
+				if (tag == TAG_FLOW_MAP)
+				{
+					node.SetStyle(YAML::EmitterStyle::Flow);
+				}
+				for (size_t i = readNumber(); i > 0; --i)
+				{
+					YAML::Node key = readNode(depth + 1);
+					// keys are unique already, skip the linear lookup of operator[]
+					node.force_insert(key, readNode(depth + 1));
+				}
+				return node;
+			}
+		default:
+			fail();
+			return YAML::Node();
+		}
+	}
+
+	bool atEnd() const
+	{
+		return _pos == _end;
+	}
+};
+
+/**
+ * Decodes a single chunk after its header.
+ * @param flags Chunk flags.
+ * @param rawSize Size of the encoded node tree.
+ * @param data Stored bytes.
+ * @param size Number of stored bytes.
+ * @return Document node.
+ */
+YAML::Node decodeChunk(Uint8 flags, Uint32 rawSize, const Uint8 *data, size_t size)
+{
+	std::vector<Uint8> inflated;
+	if (flags & CHUNK_DEFLATE)
+	{
+		if (rawSize / MAX_DEFLATE_RATIO > size)
+		{
+			throw Exception("Corrupted binary YAML data");
+		}
+		inflated.resize(rawSize);
+		mz_ulong length = rawSize;
+		if (mz_uncompress(inflated.data(), &length, data, (mz_ulong)size) != MZ_OK || length != rawSize)
+		{
+			throw Exception("Corrupted binary YAML data");
+		}
+		data = inflated.data();
+		size = rawSize;
+	}
+	else if (size != rawSize)
+	{
+		throw Exception("Corrupted binary YAML data");
+	}
+	Reader reader(data, size);
+	YAML::Node doc = reader.readNode();
+	if (!reader.atEnd())
+	{
+		throw Exception("Corrupted binary YAML data");
+	}
+	return doc;
+}
+
+/**
+ * Encodes a document and appends it as a chunk.
+ * @param out Buffer to append to.
+ * @param doc Document to encode.
+ * @param compress Deflate the chunk if that makes it smaller.
+ */
+void appendChunk(std::vector<Uint8> &out, const YAML::Node &doc, bool compress)
+{
+	std::vector<Uint8> chunk, deflated;
+	Writer(chunk).writeNode(doc);
+	Uint8 flags = 0;
+	const std::vector<Uint8> *stored = &chunk;
+	if (compress)
+	{
+		mz_ulong length = mz_compressBound((mz_ulong)chunk.size());
+		deflated.resize(length);
+		if (mz_compress2(deflated.data(), &length, chunk.data(), (mz_ulong)chunk.size(), MZ_BEST_SPEED) == MZ_OK && length < chunk.size())
+		{
+			deflated.resize(length);
+			stored = &deflated;
+			flags |= CHUNK_DEFLATE;
+		}
+	}
+	out.push_back(flags);
+	writeU32(out, (Uint32)chunk.size());
+	writeU32(out, (Uint32)stored->size());
+	out.insert(out.end(), stored->begin(), stored->end());
+}
+
+/**
+ * Emits YAML documents as text, the way savegames are written.
+ * @param docs YAML documents.
+ * @return YAML text.
+ */
+std::string emitText(const std::vector<YAML::Node> &docs)
+{
+	YAML::Emitter out;
+	for (size_t i = 0; i < docs.size(); ++i)
+	{
+		if (i > 0)
+		{
+			out << YAML::BeginDoc;
+		}
+		out << docs[i];
+	}
+	return out.c_str();
+}
+
+/**
+ * Reads exactly the requested number of bytes from a file.
+ */
+bool readExact(SDL_RWops *rw, void *data, size_t size)
+{
+	return size == 0 || SDL_RWread(rw, data, size, 1) == 1;
+}
+
+}
+
+/**
+ * Gets the version of the binary format that is written.
+ * @return Format version.
+ */
+int getFormatVersion()
+{
+	return FORMAT_VERSION;
+}
+
+/**
+ * Checks if a buffer starts with the binary format signature.
+ * @param data Buffer.
+ * @param size Buffer size.
+ * @return True if the buffer holds binary documents.
+ */
+bool isBinary(const Uint8 *data, size_t size)
+{
+	return size >= FILE_HEADER_SIZE && memcmp(data, SIGNATURE, sizeof(SIGNATURE)) == 0;
+}
+
+/**
+ * Encodes YAML documents in the binary format.
+ * @param docs Documents to encode.
+ * @param compress Deflate the documents.
+ * The first document is always stored as is, so it stays cheap
+ * to read on its own (eg. the savegame header).
+ * @return Encoded bytes.
+ */
+std::vector<Uint8> encode(const std::vector<YAML::Node> &docs, bool compress)
+{
+	std::vector<Uint8> out(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+	out.push_back(FORMAT_VERSION);
+	for (size_t i = 0; i < docs.size(); ++i)
+	{
+		appendChunk(out, docs[i], compress && i > 0);
+	}
+	return out;
+}
+
+/**
+ * Decodes YAML documents from the binary format.
+ * @param data Encoded bytes.
+ * @param size Number of encoded bytes.
+ * @param maxDocs Stop after this many documents.
+ * @return Decoded documents.
+ */
+std::vector<YAML::Node> decode(const Uint8 *data, size_t size, size_t maxDocs)
+{
+	if (!isBinary(data, size) || data[sizeof(SIGNATURE)] != FORMAT_VERSION)
+	{
+		throw Exception("Unsupported binary YAML data");
+	}
+	std::vector<YAML::Node> docs;
+	size_t pos = FILE_HEADER_SIZE;
+	while (pos < size && docs.size() < maxDocs)
+	{
+		if (size - pos < CHUNK_HEADER_SIZE)
+		{
+			throw Exception("Corrupted binary YAML data");
+		}
+		Uint8 flags = data[pos];
+		Uint32 rawSize = readU32(data + pos + 1);
+		Uint32 storedSize = readU32(data + pos + 5);
+		pos += CHUNK_HEADER_SIZE;
+		if (storedSize > size - pos)
+		{
+			throw Exception("Corrupted binary YAML data");
+		}
+		docs.push_back(decodeChunk(flags, rawSize, data + pos, storedSize));
+		pos += storedSize;
+	}
+	return docs;
+}
+
+/**
+ * Checks if a file is in the binary format by looking at its signature.
+ * @param filename Full path to the file.
+ * @return True if the file holds binary documents.
+ */
+bool isBinaryFile(const std::string &filename)
+{
+	SDL_RWops *rw = SDL_RWFromFile(filename.c_str(), "rb");
+	if (!rw)
+	{
+		return false;
+	}
+	Uint8 header[FILE_HEADER_SIZE];
+	bool binary = readExact(rw, header, sizeof(header)) && isBinary(header, sizeof(header));
+	SDL_RWclose(rw);
+	return binary;
+}
+
+/**
+ * Loads YAML documents from a binary file. Only the chunks
+ * of the requested documents are read from the disk.
+ * @param filename Full path to the file.
+ * @param maxDocs Stop after this many documents.
+ * @return Decoded documents.
+ */
+std::vector<YAML::Node> loadFile(const std::string &filename, size_t maxDocs)
+{
+	FileReader reader(filename);
+	std::vector<YAML::Node> docs;
+	YAML::Node doc;
+	while (docs.size() < maxDocs && reader.read(doc))
+	{
+		docs.push_back(doc);
+	}
+	return docs;
+}
+
+/**
+ * Saves YAML documents to a binary file.
+ * @param filename Full path to the file.
+ * @param docs Documents to save.
+ * @param compress Deflate the documents.
+ * @return If we did write it.
+ */
+bool saveFile(const std::string &filename, const std::vector<YAML::Node> &docs, bool compress)
+{
+	std::vector<Uint8> data = encode(docs, compress);
+	return CrossPlatform::writeFile(filename, data);
+}
+
+/**
+ * Converts a file between the binary and the text format,
+ * eg. to inspect or edit a binary savegame by hand.
+ * Binary files become YAML text, anything else becomes binary.
+ * @param source Full path to the file to convert.
+ * @param destination Full path to the converted file.
+ */
+void convertFile(const std::string &source, const std::string &destination)
+{
+	bool written;
+	if (isBinaryFile(source))
+	{
+		written = CrossPlatform::writeFile(destination, emitText(loadFile(source)));
+	}
+	else
+	{
+		std::vector<YAML::Node> docs = YAML::LoadAll(*CrossPlatform::readFile(source));
+		written = saveFile(destination, docs, true);
+	}
+	if (!written)
+	{
+		throw Exception("Failed to write " + destination);
+	}
+}
+
+/**
+ * Times writing and reading a file in the text format, through the
+ * YAML emitter and parser, and in the binary format, and prints the
+ * average time of each. Also checks that the binary round trip gives
+ * back the same documents, by comparing their text.
+ * @param filename Full path to a text or binary file (eg. a savegame).
+ * @param rounds Number of times to write and read it in each format.
+ */
+void benchmark(const std::string &filename, int rounds)
+{
+	std::vector<YAML::Node> docs;
+	if (isBinaryFile(filename))
+	{
+		docs = loadFile(filename);
+	}
+	else
+	{
+		docs = YAML::LoadAll(*CrossPlatform::readFile(filename));
+	}
+	if (docs.empty())
+	{
+		throw Exception(filename + " has no documents");
+	}
+
+	std::string text = emitText(docs);
+	std::vector<Uint8> binary = encode(docs, true);
+	std::cout << filename << ", " << docs.size() << " documents, " << rounds << " rounds:" << std::endl;
+	std::cout << "  text    " << text.size() << " bytes" << std::endl;
+	std::cout << "  binary  " << binary.size() << " bytes" << std::endl;
+
+	auto time = [&](const std::string &name, const std::function<void()> &run)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < rounds; ++i)
+		{
+			run();
+		}
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "  " << std::left << std::setw(22) << name << std::fixed << std::setprecision(2) << ms / rounds << " ms" << std::endl;
+	};
+	time("text write", [&]() { emitText(docs); });
+	time("text read", [&]() { YAML::LoadAll(text); });
+	time("text read header", [&]() { YAML::Load(text.substr(0, text.find("\n---"))); });
+	time("binary write", [&]() { encode(docs, true); });
+	time("binary write (raw)", [&]() { encode(docs, false); });
+	time("binary read", [&]() { decode(binary.data(), binary.size()); });
+	time("binary read header", [&]() { decode(binary.data(), binary.size(), 1); });
+
+	if (emitText(decode(binary.data(), binary.size())) == text)
+	{
+		std::cout << "Binary round trip matches the text." << std::endl;
+	}
+	else
+	{
+		std::cout << "Binary round trip DOES NOT match the text!" << std::endl;
+	}
+}
+
+/**
+ * Opens a binary file and checks its signature.
+ * @param filename Full path to the file.
+ */
+FileReader::FileReader(const std::string &filename) : _rw(0)
+{
+	_rw = SDL_RWFromFile(filename.c_str(), "rb");
+	if (!_rw)
+	{
+		std::string err = "Failed to read " + filename + ": " + SDL_GetError();
+		Log(LOG_ERROR) << err;
+		throw Exception(err);
+	}
+	Uint8 header[FILE_HEADER_SIZE];
+	if (!readExact(_rw, header, sizeof(header)) || !isBinary(header, sizeof(header)) || header[sizeof(SIGNATURE)] != FORMAT_VERSION)
+	{
+		SDL_RWclose(_rw);
+		throw Exception("Unsupported binary YAML file " + filename);
+	}
+}
+
+/**
+ * Closes the file.
+ */
+FileReader::~FileReader()
+{
+	SDL_RWclose(_rw);
+}
+
+/**
+ * Reads the next document from the file.
+ * @param doc Receives the document.
+ * @return False if there are no more documents.
+ */
+bool FileReader::read(YAML::Node &doc)
+{
+	Uint8 chunk[CHUNK_HEADER_SIZE];
+	if (!readExact(_rw, chunk, sizeof(chunk)))
+	{
+		return false;
+	}
+	Uint32 rawSize = readU32(chunk + 1);
+	Uint32 storedSize = readU32(chunk + 5);
+	_buffer.resize(storedSize);
+	if (!readExact(_rw, _buffer.data(), storedSize))
+	{
+		throw Exception("Truncated binary YAML file");
+	}
+	doc = decodeChunk(chunk[0], rawSize, _buffer.data(), storedSize);
+	return true;
+}
+
+/**
+ * Creates a binary file and writes its signature.
+ * @param filename Full path to the file.
+ */
+FileWriter::FileWriter(const std::string &filename) : _rw(0), _failed(false)
+{
+	_rw = SDL_RWFromFile(filename.c_str(), "wb");
+	if (!_rw)
+	{
+		std::string err = "Failed to write " + filename + ": " + SDL_GetError();
+		Log(LOG_ERROR) << err;
+		throw Exception(err);
+	}
+	Uint8 header[FILE_HEADER_SIZE];
+	memcpy(header, SIGNATURE, sizeof(SIGNATURE));
+	header[sizeof(SIGNATURE)] = FORMAT_VERSION;
+	_failed = SDL_RWwrite(_rw, header, sizeof(header), 1) != 1;
+}
+
+/**
+ * Closes the file if it's still open.
+ */
+FileWriter::~FileWriter()
+{
+	close();
+}
+
+/**
+ * Appends a document to the file.
+ * @param doc Document to write.
+ * @param compress Deflate the document.
+ */
+void FileWriter::write(const YAML::Node &doc, bool compress)
+{
+	if (!_rw || _failed)
+	{
+		return;
+	}
+	_buffer.clear();
+	appendChunk(_buffer, doc, compress);
+	_failed = SDL_RWwrite(_rw, _buffer.data(), _buffer.size(), 1) != 1;
+}
+
+/**
+ * Closes the file.
+ * @return True if everything was written.
+ */
+bool FileWriter::close()
+{
+	if (_rw)
+	{
+		SDL_RWclose(_rw);
+		_rw = 0;
+	}
+	return !_failed;
+}
+
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+#include <SDL_types.h>
+#include <SDL_rwops.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Compact binary storage for YAML documents, used where
+ * the YAML emitter and parser are too slow (eg. savegames).
+ * Each document is stored as a length-prefixed chunk that can be
+ * deflated, so the first documents of a file can be read without
+ * decoding the rest. Scalars are interned per chunk.
+ */
+namespace BinaryYaml
+{
+	/// Gets the version of the binary format that is written.
+	int getFormatVersion();
+	/// Checks if a buffer starts with the binary format signature.
+	bool isBinary(const Uint8 *data, size_t size);
+	/// Encodes YAML documents in the binary format.
+	std::vector<Uint8> encode(const std::vector<YAML::Node> &docs, bool compress);
+	/// Decodes YAML documents from the binary format.
+	std::vector<YAML::Node> decode(const Uint8 *data, size_t size, size_t maxDocs = (size_t)-1);
+	/// Checks if a file is in the binary format.
+	bool isBinaryFile(const std::string &filename);
+	/// Loads YAML documents from a binary file.
+	std::vector<YAML::Node> loadFile(const std::string &filename, size_t maxDocs = (size_t)-1);
+	/// Saves YAML documents to a binary file.
+	bool saveFile(const std::string &filename, const std::vector<YAML::Node> &docs, bool compress);
+	/// Converts a file between the binary and the text format.
+	void convertFile(const std::string &source, const std::string &destination);
+	/// Times reading and writing a file in the text and binary formats.
+	void benchmark(const std::string &filename, int rounds);
+
+	/**
+	 * Reads the documents of a binary file one at a time,
+	 * so they don't all have to be held in memory.
+	 */
+	class FileReader
+	{
+		SDL_RWops *_rw;
+		std::vector<Uint8> _buffer;
+	public:
+		/// Opens a binary file, throws if it can't be read.
+		FileReader(const std::string &filename);
+		/// Closes the file.
+		~FileReader();
+		/// Reads the next document, returns false at the end of the file.
+		bool read(YAML::Node &doc);
+	};
+
+	/**
+	 * Writes documents to a binary file one at a time.
+	 */
+	class FileWriter
+	{
+		SDL_RWops *_rw;
+		bool _failed;
+		std::vector<Uint8> _buffer;
+	public:
+		/// Creates a binary file, throws if it can't be written.
+		FileWriter(const std::string &filename);
+		/// Closes the file.
+		~FileWriter();
+		/// Appends a document to the file.
+		void write(const YAML::Node &doc, bool compress);
+		/// Closes the file, returns false if anything failed to write.
+		bool close();
+	};
+}
+
+}
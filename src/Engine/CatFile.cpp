@@ -25,13 +25,21 @@
 namespace OpenXcom
 {
 
+/**
+ * Reads a little-endian 32-bit value, the buffer doesn't need to be aligned.
+ */
+static inline Uint32 readLE32(const Uint8 *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((Uint32)p[3] << 24);
+}
+
 /**
  * Creates a CAT file stream. A CAT file starts with an index of the
  * offset and size of every file contained within. Each file consists
  * of a filename followed by its contents.
  * @param rw SDL_RWops of the CAT file.
  */
-CatFile::CatFile(const std::string& filename) : _data(0), _items()
+CatFile::CatFile(const std::string& filename) : _items()
 {
 	// Get amount of files
 
@@ -61,33 +69,27 @@ CatFile::CatFile(const std::string& filename) : _data(0), _items()
 	 * 		SOUND/SAMPLE2.CAT
 	 *		TFTD/SOUND/SAMPLE.CAT
 	 *
-	 * Given an rwops object, this reads it and sets up rwops instances
-	 * for each chunk.
-	 *
-	 * The original rwops object is consumed here.
+	 * The whole file is kept in memory (memory-mapped when possible)
+	 * and rwops instances for each chunk read it in place.
 	 */
 	_filename = filename;
-	auto rwops = FileMap::getRWops(filename);
-	auto offset0 = SDL_ReadLE32(rwops); // read the first offset; 8 is the sizeof(item) of the header
-	SDL_RWseek(rwops, 0, RW_SEEK_SET);  // reset the rwops pointer back
-	size_t filesize;
-	_data = (Uint8 *)SDL_LoadFile_RW(rwops, &filesize, SDL_FALSE); // read all of the file
-	SDL_RWseek(rwops, 0, RW_SEEK_SET);  // and again reset the rwops pointer back
+	_data = FileMap::getData(filename); // read all of the file, items point straight into it
+	const Uint8 *data = (const Uint8 *)_data->data();
+	size_t filesize = _data->size();
+	Uint32 offset0 = filesize >= 4 ? readLE32(data) : 0; // read the first offset; 8 is the sizeof(item) of the header
 
 	if (offset0 >= filesize) {
 		Log(LOG_WARNING) << "Catfile(" << filename << "): first offset " << offset0 << ">= file size " << filesize << ", not parsing.";
-		SDL_RWclose(rwops);
 		return;
 	}
 	for (Uint32 i = 0; i < offset0 / 8; ++i) {
-		auto offset = SDL_ReadLE32(rwops);
-		SDL_ReadLE32(rwops); // ignore size;
+		auto offset = readLE32(data + i * 8); // ignore size;
 		// reject bad data
 		if (offset >= filesize) {
 			Log(LOG_WARNING) << "Catfile("<<filename<<"): item "<<i<<" outside of the file: offset="<<offset<<" "<<" filesize="<<filesize;
 			continue;
 		}
-		_items.push_back(std::make_tuple(_data + offset, offset));
+		_items.push_back(std::make_tuple(data + offset, offset));
 	}
 	Uint32 last_offset = filesize;
 	for ( auto it = _items.rbegin(); it != _items.rend(); ++it) {
@@ -95,7 +97,6 @@ CatFile::CatFile(const std::string& filename) : _data(0), _items()
 		std::get<1>(*it) = last_offset - this_offset;
 		last_offset = this_offset;
 	}
-	SDL_RWclose(rwops);
 }
 
 /**
@@ -103,7 +104,6 @@ CatFile::CatFile(const std::string& filename) : _data(0), _items()
  */
 CatFile::~CatFile()
 {
-	if (_data) { SDL_free(_data); }
 }
 
 /**
@@ -120,4 +120,21 @@ SDL_RWops *CatFile::getRWops(Uint32 i) {
 	return SDL_RWFromConstMem(std::get<0>(_items[i]), std::get<1>(_items[i]));
 }
 
+/**
+ * Gets the data of an item, read in place.
+ * @param i Object number.
+ * @param size Returns the size of the object data.
+ * @return Pointer to the object data, valid while the CAT file lives, or NULL if there's no such object.
+ */
+const Uint8 *CatFile::getData(Uint32 i, size_t &size) const
+{
+	if (i >= _items.size()) {
+		Log(LOG_ERROR) << "Catfile<" << _filename << ">::getData("<<i<<"): >= size " << _items.size();
+		size = 0;
+		return NULL;
+	}
+	size = std::get<1>(_items[i]);
+	return std::get<0>(_items[i]);
+}
+
 }
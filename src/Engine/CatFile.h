@@ -20,12 +20,15 @@
 #include <vector>
 #include <string>
 #include <tuple>
+#include <memory>
 #include <SDL_rwops.h>
 
 
 namespace OpenXcom
 {
 
+namespace FileMap { class FileData; }
+
 /**
  * Handles CAT files
  */
@@ -33,8 +36,8 @@ class CatFile
 {
 private:
 	std::string _filename;
-	Uint8 *_data;
-	std::vector<std::tuple<void *, size_t>> _items;
+	std::unique_ptr<FileMap::FileData> _data;
+	std::vector<std::tuple<const Uint8 *, size_t>> _items;
 
 public:
 	/// Creates a CAT file stream.
@@ -45,6 +48,8 @@ public:
 	size_t size() const { return _items.size(); }
 	/// Return a pointer to the object data.
 	SDL_RWops *getRWops(Uint32 i);
+	/// Return the object data, read in place.
+	const Uint8 *getData(Uint32 i, size_t &size) const;
 	/// Return the original file name
 	const std::string& fileName() const { return _filename; }
 };
@@ -70,6 +70,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/types.h>
 #include <pwd.h>
@@ -175,6 +177,33 @@ void processArgs (int argc, char *argv[])
 /// Returns the command-line arguments
 const std::vector<std::string>& getArgs() { return args; }
 
+/**
+ * Finds a command-line option that takes a fixed number of parameters,
+ * given as -name or --name in any case.
+ * @param name Option name, in lowercase.
+ * @param count Number of parameters.
+ * @param params Returns the parameters, empty if some are missing.
+ * @return True if the option was found.
+ */
+bool findArgs(const std::string &name, size_t count, std::vector<std::string> &params)
+{
+	for (size_t i = 0; i < args.size(); ++i)
+	{
+		std::string argname = args[i];
+		std::transform(argname.begin(), argname.end(), argname.begin(), ::tolower);
+		if (argname == "-" + name || argname == "--" + name)
+		{
+			params.clear();
+			if (i + count < args.size())
+			{
+				params.assign(args.begin() + i + 1, args.begin() + i + 1 + count);
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
 /**
  * Displays a message box with an error message.
  * @param error Error message.
@@ -880,6 +909,33 @@ time_t getDateModified(const std::string &path)
 #endif
 }
 
+/**
+ * Gets the size of a file.
+ * @param path Full path to file.
+ * @return The size in bytes, or -1 if the file can't be accessed.
+ */
+Sint64 getFileSize(const std::string &path)
+{
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA info;
+	auto pathW = pathToWindows(path);
+	if (!GetFileAttributesExW(pathW.c_str(), GetFileExInfoStandard, &info)) {
+		return -1;
+	}
+	return ((Sint64)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+#else
+	struct stat info;
+	if (stat(path.c_str(), &info) == 0)
+	{
+		return info.st_size;
+	}
+	else
+	{
+		return -1;
+	}
+#endif
+}
+
 /**
  * Converts a date/time into a human-readable string
  * using the ISO 8601 standard.
@@ -1033,6 +1089,83 @@ std::unique_ptr<std::istream> readFile(const std::string& filename) {
 	return std::unique_ptr<std::istream>(new std::istringstream(datastr));
 }
 
+/**
+ * Maps the whole contents of a file into memory, read-only,
+ * so it can be read without copying it to the heap first.
+ * @param filename Path of the file.
+ * @param size Returns the size of the file.
+ * @return Pointer to the contents, or NULL if the file can't be mapped (including empty files).
+ */
+void *mapFile(const std::string &filename, size_t &size)
+{
+	size = 0;
+#ifdef _WIN32
+	auto pathW = pathToWindows(filename);
+	HANDLE file = CreateFileW(pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return NULL;
+	}
+	LARGE_INTEGER fileSize;
+	void *data = NULL;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 && (Uint64)fileSize.QuadPart <= SIZE_MAX)
+	{
+		HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping != NULL)
+		{
+			data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping); // the view keeps the mapping alive
+		}
+	}
+	CloseHandle(file);
+	if (data != NULL)
+	{
+		size = (size_t)fileSize.QuadPart;
+	}
+	return data;
+#else
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return NULL;
+	}
+	struct stat info;
+	void *data = NULL;
+	if (fstat(fd, &info) == 0 && info.st_size > 0)
+	{
+		data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			data = NULL;
+		}
+	}
+	close(fd); // the mapping stays valid
+	if (data != NULL)
+	{
+		size = info.st_size;
+	}
+	return data;
+#endif
+}
+
+/**
+ * Releases a file mapped with mapFile.
+ * @param data Pointer returned by mapFile.
+ * @param size Size returned by mapFile.
+ */
+void unmapFile(void *data, size_t size)
+{
+	if (data == NULL)
+	{
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#else
+	munmap(data, size);
+#endif
+}
+
 /**
  * Gets an istream to a file's bytes at least up to and including first "\n---" sequence.
  * To be used only for savegames.
@@ -36,6 +36,8 @@ namespace CrossPlatform
 	void processArgs (int argc, char *argv[]);
 	/// Returns the command-line arguments
 	const std::vector<std::string>& getArgs();
+	/// Finds a command-line option and its parameters.
+	bool findArgs(const std::string &name, size_t count, std::vector<std::string> &params);
 	/// Gets the available error dialog.
 	void getErrorDialog();
 	/// Displays an error message.
@@ -82,6 +84,8 @@ namespace CrossPlatform
 	bool isQuitShortcut(const SDL_Event &ev);
 	/// Gets the modified date of a file.
 	time_t getDateModified(const std::string &path);
+	/// Gets the size of a file.
+	Sint64 getFileSize(const std::string &path);
 	/// Converts a timestamp to a string.
 	std::pair<std::string, std::string> timeToString(time_t time);
 	/// Move/rename a file between paths.
@@ -93,6 +97,10 @@ namespace CrossPlatform
 	bool writeFile(const std::string& filename, const std::vector<unsigned char>& data);
 	/// Reads in a file
 	std::unique_ptr<std::istream> readFile(const std::string& filename);
+	/// Maps a whole file into memory, read-only.
+	void *mapFile(const std::string &filename, size_t &size);
+	/// Releases a file mapped with mapFile.
+	void unmapFile(void *data, size_t size);
 	/// Reads file until "\n---" sequence is met or to the end. To be used only for savegames.
 	std::unique_ptr<std::istream> getYamlSaveHeader (const std::string& filename);
 	/// Flashes the game window.
@@ -41,6 +41,9 @@
 #include <istream>
 #include <unordered_map>
 #include <unordered_set>
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
+#include <SDL_timer.h>
 
 #include "FileMap.h"
 #include "Unicode.h"
@@ -48,6 +51,7 @@
 #include "CrossPlatform.h"
 #include "Options.h"
 #include "Exception.h"
+#include "Profiler.h"
 
 #define MINIZ_NO_STDIO
 #include "../../libs/miniz/miniz.h"
@@ -205,6 +209,136 @@ static inline std::string concatOptionalPaths(const std::string& basePath, const
 	}
 }
 
+namespace
+{
+
+/**
+ * Counts a file buffer in the startup profile.
+ * @param storage Where the buffer came from.
+ * @param size Size of the buffer.
+ */
+void countRead(FileData::Storage storage, size_t size)
+{
+	if (!Profiler::isEnabled())
+	{
+		return;
+	}
+	static const char *names[] = { "File reads: memory-mapped", "File reads: zip buffers", "File reads: heap buffers" };
+	Profiler::addCount(names[storage], 1);
+	Profiler::addCount(std::string(names[storage]) + " bytes", size);
+}
+
+/**
+ * Stream buffer over memory owned by someone else, with seeking.
+ */
+class MemoryBuf : public std::streambuf
+{
+public:
+	MemoryBuf(const char *data, size_t size)
+	{
+		char *begin = const_cast<char *>(data);
+		setg(begin, begin, begin + size);
+	}
+protected:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+	{
+		if (!(which & std::ios_base::in))
+		{
+			return pos_type(off_type(-1));
+		}
+		char *base = dir == std::ios_base::beg ? eback() : dir == std::ios_base::cur ? gptr() : egptr();
+		if (off < eback() - base || off > egptr() - base)
+		{
+			return pos_type(off_type(-1));
+		}
+		setg(eback(), base + off, egptr());
+		return pos_type(gptr() - eback());
+	}
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+	{
+		return seekoff(off_type(pos), std::ios_base::beg, which);
+	}
+};
+
+/**
+ * Input stream over a file buffer, optionally keeping the buffer alive.
+ */
+class MemoryIStream : public std::istream
+{
+	std::unique_ptr<FileData> _owned;
+	MemoryBuf _buf;
+public:
+	MemoryIStream(const char *data, size_t size, std::unique_ptr<FileData> owned = nullptr) : std::istream(nullptr), _owned(std::move(owned)), _buf(data, size)
+	{
+		rdbuf(&_buf);
+	}
+};
+
+/**
+ * Gets an istream that reads a file buffer in place and frees it when done.
+ * @param data File buffer.
+ * @return The istream.
+ */
+std::unique_ptr<std::istream> makeIStream(std::unique_ptr<FileData> data)
+{
+	const char *begin = data->data();
+	size_t size = data->size();
+	return std::unique_ptr<std::istream>(new MemoryIStream(begin, size, std::move(data)));
+}
+
+}
+
+/**
+ * Takes ownership of a file buffer.
+ * @param data Buffer, allocated as the storage says.
+ * @param size Size of the buffer.
+ * @param storage Where the buffer came from, to release it the same way.
+ */
+FileData::FileData(char *data, size_t size, Storage storage) : _data(data), _size(size), _storage(storage)
+{
+	countRead(storage, size);
+}
+
+/**
+ * Releases the buffer.
+ */
+FileData::~FileData()
+{
+	switch (_storage)
+	{
+	case STORAGE_MAPPED:
+		CrossPlatform::unmapFile(_data, _size);
+		break;
+	case STORAGE_ZIP:
+		mz_free(_data);
+		break;
+	case STORAGE_HEAP:
+		SDL_free(_data);
+		break;
+	}
+}
+
+/**
+ * Gets an istream reading the buffer in place.
+ * The FileData has to outlive the stream.
+ * @return The istream.
+ */
+std::unique_ptr<std::istream> FileData::getIStream() const
+{
+	return std::unique_ptr<std::istream>(new MemoryIStream(_data, _size));
+}
+
+/**
+ * Gets SDL_RWops reading the buffer in place.
+ * The FileData has to outlive the RWops.
+ * @return The RWops.
+ */
+SDL_RWops *FileData::getRWops() const
+{
+	static char empty;
+	return SDL_RWFromConstMem(_size ? _data : &empty, _size);
+}
+
 FileRecord::FileRecord() : fullpath(""), zip(NULL), findex(0) { }
 
 SDL_RWops *FileRecord::getRWops() const
@@ -222,19 +356,37 @@ SDL_RWops *FileRecord::getRWops() const
 SDL_RWops *FileRecord::getRWopsReadAll() const
 {
 	SDL_RWops *rv;
+	size_t size = 0;
 	if (zip != NULL)
 	{
 		rv = SDL_RWFromMZ((mz_zip_archive *)zip, findex);
 	}
+	else if (void *mapped = CrossPlatform::mapFile(fullpath, size))
+	{
+		countRead(FileData::STORAGE_MAPPED, size);
+		rv = SDL_RWFromConstMem(mapped, size);
+
+		//close callback
+		rv->close = [](struct SDL_RWops *context)
+		{
+			if (context)
+			{
+				//HACK: `hidden` is an implementation detail, same as for the heap buffer below
+				CrossPlatform::unmapFile(context->hidden.mem.base, context->hidden.mem.stop - context->hidden.mem.base);
+				SDL_FreeRW(context);
+			}
+			return 0;
+		};
+	}
 	else
 	{
 		rv = SDL_RWFromFile(fullpath.c_str(), "rb");
 		if (rv)
 		{
-			size_t size = 0;
 			auto data = SDL_LoadFile_RW(rv, &size, SDL_TRUE);
 			if (data)
 			{
+				countRead(FileData::STORAGE_HEAP, size);
 				rv = SDL_RWFromConstMem(data, size);
 
 				//close callback
@@ -262,24 +414,64 @@ SDL_RWops *FileRecord::getRWopsReadAll() const
 	return rv;
 }
 
-std::unique_ptr<std::istream> FileRecord::getIStream() const
+/**
+ * Gets a stamp of the file that changes when its contents change,
+ * for validating caches: size and CRC for zip entries,
+ * size and modification time for loose files.
+ * @return Stamp string.
+ */
+std::string FileRecord::getStamp() const
 {
+	std::ostringstream stamp;
+	if (zip != NULL) {
+		mz_zip_archive_file_stat stat;
+		if (!mz_zip_reader_file_stat((mz_zip_archive *)zip, findex, &stat)) {
+			return "";
+		}
+		stamp << "zip:" << stat.m_uncomp_size << ":" << stat.m_crc32;
+	} else {
+		stamp << "file:" << CrossPlatform::getFileSize(fullpath) << ":" << CrossPlatform::getDateModified(fullpath);
+	}
+	return stamp.str();
+}
+
+/**
+ * Reads the whole file into a single buffer. Loose files are
+ * memory-mapped, zip entries are decompressed straight into the
+ * buffer, so nothing gets copied after that.
+ * @return The file contents.
+ */
+std::unique_ptr<FileData> FileRecord::getData() const
+{
+	size_t size = 0;
 	if (zip != NULL) {
-		size_t size;
 		void *data = mz_zip_reader_extract_to_heap((mz_zip_archive *)zip, findex, &size, 0);
 		if (data == NULL) {
-			auto err = "FileRecord::getIStream(): failed to decompress " + fullpath + ": ";
+			auto err = "FileRecord::getData(): failed to decompress " + fullpath + ": ";
 			err += mz_zip_get_error_string(mz_zip_get_last_error((mz_zip_archive *)zip));
 			Log(LOG_FATAL) << err;
 			throw Exception(err);
 		}
-		std::string a_string((char *)data, size);
-		auto rv = new std::stringstream(a_string);
-		mz_free(data);
-		return std::unique_ptr<std::istream>(rv);
-	} else {
-		return CrossPlatform::readFile(fullpath);
+		return std::unique_ptr<FileData>(new FileData((char *)data, size, FileData::STORAGE_ZIP));
+	}
+	void *mapped = CrossPlatform::mapFile(fullpath, size);
+	if (mapped != NULL) {
+		return std::unique_ptr<FileData>(new FileData((char *)mapped, size, FileData::STORAGE_MAPPED));
 	}
+	// can't be mapped (eg. empty file), read it the usual way
+	SDL_RWops *rwops = SDL_RWFromFile(fullpath.c_str(), "rb");
+	void *data = rwops ? SDL_LoadFile_RW(rwops, &size, SDL_TRUE) : NULL;
+	if (data == NULL) {
+		std::string err = "Failed to read " + fullpath + ": " + SDL_GetError();
+		Log(LOG_ERROR) << err;
+		throw Exception(err);
+	}
+	return std::unique_ptr<FileData>(new FileData((char *)data, size, FileData::STORAGE_HEAP));
+}
+
+std::unique_ptr<std::istream> FileRecord::getIStream() const
+{
+	return makeIStream(getData());
 }
 
 YAML::Node FileRecord::getYAML() const
@@ -735,6 +927,7 @@ void clear(bool clearOnly, bool embeddedOnly) {
 */
 void setup(const std::vector<const ModInfo* >& active, bool embeddedOnly)
 {
+	Profiler::ScopedTimer timer("FileMap::setup");
 	TheVFS.clear();
 	TheVFS.map_common(embeddedOnly);
 	std::string log_ctx = "FileMap::setup(): ";
@@ -1018,6 +1211,7 @@ SDL_RWops *zipGetFileByName(const std::string& zipfile, const std::string& fullp
  *
  */
 void scanModDir(const std::string& dirname, const std::string& basename, bool protectedLocation) {
+	Profiler::ScopedTimer timer("FileMap::scanModDir: " + dirname + basename);
 
 	// "standard" directory is for built-in mods only! otherwise automatic updates would delete user data
 	const std::set<std::string> standardMods = {
@@ -1289,12 +1483,244 @@ SDL_RWops *getRWopsReadAll(const std::string &relativeFilePath)
 std::unique_ptr<std::istream> getIStream(const std::string &relativeFilePath) {
 	return at(relativeFilePath)->getIStream();
 }
+
+std::unique_ptr<FileData> getData(const std::string &relativeFilePath) {
+	return at(relativeFilePath)->getData();
+}
 YAML::Node getYAML(const std::string &relativeFilePath) {
 	return at(relativeFilePath)->getYAML();
 }
 std::vector<YAML::Node> getAllYAML(const std::string &relativeFilePath) {
 	return at(relativeFilePath)->getAllYAML();
 }
+
+namespace
+{
+
+void parseText(const FileData &text, ParsedYAML &result)
+{
+	Uint32 start = SDL_GetTicks();
+	try
+	{
+		result.doc = YAML::Load(*text.getIStream());
+	}
+	catch (YAML::Exception &e)
+	{
+		result.error = e.what();
+	}
+	result.parseTime = SDL_GetTicks() - start;
+}
+
+/**
+ * Worker threads for parseYAML. They are started on first use and kept
+ * waiting between calls, so each batch of files only costs waking them up.
+ */
+namespace ParseThreads
+{
+
+SDL_mutex *mutex = 0;
+SDL_cond *startCond = 0, *doneCond = 0;
+std::vector<SDL_Thread*> workers;
+/// Thread count the workers were started for, including the calling thread.
+int startedThreads = 0;
+bool quit = false;
+
+/// Current batch, only valid while it is being parsed.
+const std::vector<std::unique_ptr<FileData>> *texts = 0;
+std::vector<ParsedYAML> *results = 0;
+size_t nextText = 0, pendingTexts = 0;
+unsigned int generation = 0;
+
+/**
+ * Takes the next file of the current batch and parses it.
+ * Called with the mutex locked, returns with it locked.
+ * @return False if there were no files left.
+ */
+bool parseNext()
+{
+	if (texts == 0 || nextText >= texts->size())
+	{
+		return false;
+	}
+	size_t i = nextText++;
+	SDL_mutexV(mutex);
+	parseText(*(*texts)[i], (*results)[i]);
+	SDL_mutexP(mutex);
+	if (--pendingTexts == 0)
+	{
+		SDL_CondSignal(doneCond);
+	}
+	return true;
+}
+
+/**
+ * Worker thread, parses files of each new batch until told to quit.
+ * @param data Unused.
+ * @return Always 0.
+ */
+int worker(void *)
+{
+	unsigned int seen = 0;
+	SDL_mutexP(mutex);
+	while (true)
+	{
+		while (seen == generation && !quit)
+		{
+			SDL_CondWait(startCond, mutex);
+		}
+		if (quit)
+		{
+			break;
+		}
+		seen = generation;
+		while (parseNext());
+	}
+	SDL_mutexV(mutex);
+	return 0;
+}
+
+/**
+ * Stops all the worker threads.
+ */
+void stop()
+{
+	if (workers.empty())
+	{
+		return;
+	}
+	SDL_mutexP(mutex);
+	quit = true;
+	SDL_CondBroadcast(startCond);
+	SDL_mutexV(mutex);
+	for (auto *thread : workers)
+	{
+		SDL_WaitThread(thread, 0);
+	}
+	workers.clear();
+	quit = false;
+}
+
+/**
+ * Starts the worker threads for a thread count,
+ * unless they were already started for it.
+ * @param threads Number of threads, including the calling thread.
+ */
+void start(int threads)
+{
+	if (threads == startedThreads)
+	{
+		return;
+	}
+	stop();
+	startedThreads = threads;
+	if (threads <= 1)
+	{
+		return;
+	}
+	if (mutex == 0)
+	{
+		mutex = SDL_CreateMutex();
+		startCond = SDL_CreateCond();
+		doneCond = SDL_CreateCond();
+		if (mutex == 0 || startCond == 0 || doneCond == 0)
+		{
+			Log(LOG_WARNING) << "Failed to create ruleset parsing locks, parsing on a single thread";
+			return;
+		}
+	}
+	// the calling thread is one of the threads
+	for (int i = 1; i < threads; ++i)
+	{
+		SDL_Thread *thread = SDL_CreateThread(worker, 0);
+		if (thread == 0)
+		{
+			Log(LOG_WARNING) << "Failed to create ruleset parsing thread: " << SDL_GetError();
+			break;
+		}
+		workers.push_back(thread);
+	}
+}
+
+/**
+ * Parses a batch of files on the worker threads and the calling
+ * thread, and waits until all of them are done.
+ * @param batch Contents of the files.
+ * @param parsed Returns the parsed documents, one for each file.
+ */
+void run(const std::vector<std::unique_ptr<FileData>> &batch, std::vector<ParsedYAML> &parsed)
+{
+	if (workers.empty() || batch.size() < 2)
+	{
+		for (size_t i = 0; i < batch.size(); ++i)
+		{
+			parseText(*batch[i], parsed[i]);
+		}
+		return;
+	}
+	SDL_mutexP(mutex);
+	texts = &batch;
+	results = &parsed;
+	nextText = 0;
+	pendingTexts = batch.size();
+	generation++;
+	SDL_CondBroadcast(startCond);
+	while (parseNext());
+	while (pendingTexts > 0)
+	{
+		SDL_CondWait(doneCond, mutex);
+	}
+	texts = 0;
+	results = 0;
+	SDL_mutexV(mutex);
+}
+
+}
+
+}
+
+/**
+ * Parses the YAML of several files. The files are read on the calling thread
+ * (zip archives can't be shared between threads), then parsed by the worker
+ * threads and the calling thread. The workers are kept between calls.
+ * Parse errors don't throw, they are returned for each file,
+ * so the caller can handle them in its own order.
+ * @param files Files to parse.
+ * @param threads Number of threads to use, 1 parses on the calling thread.
+ * @return Parsed documents in the same order as the files.
+ */
+std::vector<ParsedYAML> parseYAML(const std::vector<const FileRecord *> &files, int threads)
+{
+	std::vector<ParsedYAML> results(files.size());
+	std::vector<std::unique_ptr<FileData>> texts;
+	texts.reserve(files.size());
+	for (auto file : files)
+	{
+		texts.push_back(file->getData());
+	}
+	ParseThreads::start(threads);
+	ParseThreads::run(texts, results);
+	return results;
+}
+
+/**
+ * Stops the worker threads of parseYAML and frees their locks,
+ * so nothing is left running when the game shuts down.
+ */
+void stopParseThreads()
+{
+	ParseThreads::stop();
+	ParseThreads::startedThreads = 0;
+	if (ParseThreads::mutex != 0)
+	{
+		SDL_DestroyCond(ParseThreads::doneCond);
+		SDL_DestroyCond(ParseThreads::startCond);
+		SDL_DestroyMutex(ParseThreads::mutex);
+		ParseThreads::doneCond = 0;
+		ParseThreads::startCond = 0;
+		ParseThreads::mutex = 0;
+	}
+}
+
 const std::vector<const FileRecord *> getSlice(const std::string &relativeFilePath) {
 	return TheVFS.get_slice(relativeFilePath);
 }
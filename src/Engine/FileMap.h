@@ -21,6 +21,7 @@
 #include <set>
 #include <string>
 #include <vector>
+#include <memory>
 #include <istream>
 #include <unordered_map>
 #include <unordered_set>
@@ -37,6 +38,36 @@ namespace OpenXcom
  */
 namespace FileMap
 {
+	/**
+	 * Whole contents of a file in a single read-only buffer: memory-mapped
+	 * for loose files, decompressed once for zip entries. Streams and RWops
+	 * made from it read the buffer directly, so it has to outlive them.
+	 */
+	class FileData
+	{
+	public:
+		enum Storage { STORAGE_MAPPED, STORAGE_ZIP, STORAGE_HEAP };
+	private:
+		char *_data;
+		size_t _size;
+		Storage _storage;
+	public:
+		/// Takes ownership of a buffer.
+		FileData(char *data, size_t size, Storage storage);
+		/// Releases the buffer.
+		~FileData();
+		FileData(const FileData&) = delete;
+		FileData &operator=(const FileData&) = delete;
+		/// Gets the contents.
+		const char *data() const { return _data; }
+		/// Gets the size of the contents.
+		size_t size() const { return _size; }
+		/// Gets an istream reading the buffer in place.
+		std::unique_ptr<std::istream> getIStream() const;
+		/// Gets SDL_RWops reading the buffer in place.
+		SDL_RWops *getRWops() const;
+	};
+
 	struct FileRecord {
 		std::string fullpath; 	// includes zip file name if any
 
@@ -50,6 +81,11 @@ namespace FileMap
 		/// Read the whole file to memory and warp in RWops.
 		SDL_RWops *getRWopsReadAll() const;
 
+		/// Get a short string that changes when the file contents change.
+		std::string getStamp() const;
+
+		/// Gets the whole file in a single buffer, without extra copies.
+		std::unique_ptr<FileData> getData() const;
 		std::unique_ptr<std::istream> getIStream() const;
 		YAML::Node getYAML() const;
 		std::vector<YAML::Node> getAllYAML() const;
@@ -70,6 +106,9 @@ namespace FileMap
 	/// Gets an std::istream interface to the file data. Has to be deleted on the caller's end.
 	std::unique_ptr<std::istream>getIStream(const std::string &relativeFilePath);
 
+	/// Gets the whole file data in a single buffer, memory-mapped if possible.
+	std::unique_ptr<FileData> getData(const std::string &relativeFilePath);
+
 	/// Gets a 'vertical slice' through all the VFS layers for a given file name. (used for langs)
 	/// Beware of NULLs for the layers that miss the relpath.
 	const std::vector<const FileRecord *> getSlice(const std::string &relativeFilePath);
@@ -78,6 +117,18 @@ namespace FileMap
 	YAML::Node getYAML(const std::string &relativeFilePath);
 	std::vector<YAML::Node> getAllYAML(const std::string &relativeFilePath);
 
+	/// Result of parsing one file with parseYAML.
+	struct ParsedYAML {
+		YAML::Node doc;
+		std::string error;		// set if the file failed to parse
+		Uint32 parseTime;		// in milliseconds
+	};
+
+	/// Parses the YAML of several files, using worker threads when asked to.
+	std::vector<ParsedYAML> parseYAML(const std::vector<const FileRecord *> &files, int threads);
+	/// Stops the worker threads of parseYAML, they are started again when needed.
+	void stopParseThreads();
+
 	/// if we have the file
 	bool fileExists(const std::string &relativeFilePath);
 
@@ -0,0 +1,342 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "FrameProfiler.h"
+#include <map>
+#include <sstream>
+#include <iomanip>
+#include "Logger.h"
+#include "Options.h"
+
+namespace OpenXcom
+{
+
+namespace FrameProfiler
+{
+
+namespace
+{
+
+const char *SECTION_NAMES[SECTION_MAX] = { "Map::drawTerrain", "Unit sprites", "Screen::flip", "TileEngine FOV", "TileEngine lighting", "Pathfinding", "AIModule::think" };
+const char *SECTION_LABELS[SECTION_MAX] = { "MAP", "UNIT", "FLIP", "FOV", "LIGHT", "PATH", "AI" };
+/// Frames in the rolling average.
+const int WINDOW_SIZE = 60;
+/// Microseconds between overlay updates.
+const Uint64 OVERLAY_INTERVAL = 1000000;
+
+/**
+ * Times of a frame, in microseconds.
+ */
+struct FrameTimes
+{
+	Uint64 total;
+	Uint64 sections[SECTION_MAX];
+
+	void add(const FrameTimes &other)
+	{
+		total += other.total;
+		for (int i = 0; i < SECTION_MAX; ++i)
+		{
+			sections[i] += other.sections[i];
+		}
+	}
+
+	void subtract(const FrameTimes &other)
+	{
+		total -= other.total;
+		for (int i = 0; i < SECTION_MAX; ++i)
+		{
+			sections[i] -= other.sections[i];
+		}
+	}
+};
+
+/**
+ * Times of a unit's AI during a turn, in microseconds.
+ */
+struct UnitTimes
+{
+	Uint32 count;
+	Uint64 total, max;
+};
+
+/// Running sections, so nested runs of the same section aren't counted twice.
+int depth[SECTION_MAX];
+/// Times of the frame in progress.
+FrameTimes frame;
+bool started = false, working = false;
+std::chrono::steady_clock::time_point frameStart, lastOverlay;
+
+/// Last frames, for the rolling average.
+FrameTimes window[WINDOW_SIZE];
+FrameTimes windowSum;
+int windowPos = 0, windowCount = 0;
+/// Worst frame since the last overlay update.
+FrameTimes intervalWorst;
+std::string overlay;
+
+/// Totals of the turn in progress.
+Uint32 turnFrames = 0;
+FrameTimes turnSum, turnWorst;
+Uint64 turnSectionMax[SECTION_MAX];
+Uint32 turnCalls[SECTION_MAX];
+std::map<int, UnitTimes> turnUnits;
+
+/// Totals since startup.
+Uint64 totalTime[SECTION_MAX];
+Uint32 totalCalls[SECTION_MAX];
+
+std::string formatMs(Uint64 time)
+{
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(1) << time / 1000.0;
+	return ss.str();
+}
+
+/**
+ * Rebuilds the overlay text from the rolling average
+ * and the worst frame since the last update.
+ */
+void updateOverlay()
+{
+	std::ostringstream ss;
+	ss << "FRAME avg " << formatMs(windowSum.total / windowCount) << " ms, worst " << formatMs(intervalWorst.total) << " ms\nAVG";
+	for (int i = 0; i < SECTION_MAX; ++i)
+	{
+		ss << ' ' << SECTION_LABELS[i] << ' ' << formatMs(windowSum.sections[i] / windowCount);
+	}
+	ss << "\nMAX";
+	for (int i = 0; i < SECTION_MAX; ++i)
+	{
+		ss << ' ' << SECTION_LABELS[i] << ' ' << formatMs(intervalWorst.sections[i]);
+	}
+	overlay = ss.str();
+}
+
+}
+
+/**
+ * Starts timing a section, if profiling is enabled.
+ * @param section Section to time.
+ * @param unitId ID of the unit the time belongs to, or -1.
+ */
+ScopedSection::ScopedSection(Section section, int unitId) : _section(section), _unitId(unitId), _entered(false), _active(false)
+{
+	if (Options::oxceFrameProfiler)
+	{
+		_entered = true;
+		if (depth[section]++ == 0)
+		{
+			_active = true;
+			_start = std::chrono::steady_clock::now();
+		}
+	}
+}
+
+/**
+ * Stops timing and adds the run to the current frame.
+ */
+ScopedSection::~ScopedSection()
+{
+	if (_active)
+	{
+		Uint64 time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count();
+		frame.sections[_section] += time;
+		turnCalls[_section]++;
+		totalTime[_section] += time;
+		totalCalls[_section]++;
+		if (_unitId >= 0)
+		{
+			UnitTimes &unit = turnUnits[_unitId];
+			unit.count++;
+			unit.total += time;
+			if (time > unit.max)
+			{
+				unit.max = time;
+			}
+		}
+	}
+	if (_entered)
+	{
+		depth[_section]--;
+	}
+}
+
+/**
+ * Checks if the profiler is collecting timings.
+ * @return True if enabled.
+ */
+bool isEnabled()
+{
+	return Options::oxceFrameProfiler;
+}
+
+/**
+ * Marks the start of the work on the next frame,
+ * eg. when the game wakes up to handle events.
+ */
+void startFrame()
+{
+	if (isEnabled())
+	{
+		working = true;
+		frameStart = std::chrono::steady_clock::now();
+	}
+}
+
+/**
+ * Finishes the current frame. The frame time is the time since
+ * the last call to startFrame, so it doesn't include any waiting
+ * for the frame. Does nothing if startFrame wasn't called.
+ */
+void endFrame()
+{
+	if (!isEnabled())
+	{
+		started = false;
+		working = false;
+		frame = FrameTimes();
+		return;
+	}
+	if (!working)
+	{
+		return;
+	}
+	working = false;
+	auto now = std::chrono::steady_clock::now();
+	if (!started)
+	{
+		started = true;
+		lastOverlay = now;
+	}
+	frame.total = std::chrono::duration_cast<std::chrono::microseconds>(now - frameStart).count();
+
+	windowSum.subtract(window[windowPos]);
+	window[windowPos] = frame;
+	windowSum.add(frame);
+	windowPos = (windowPos + 1) % WINDOW_SIZE;
+	if (windowCount < WINDOW_SIZE)
+	{
+		windowCount++;
+	}
+	if (frame.total > intervalWorst.total)
+	{
+		intervalWorst = frame;
+	}
+
+	turnFrames++;
+	turnSum.add(frame);
+	if (frame.total > turnWorst.total)
+	{
+		turnWorst = frame;
+	}
+	for (int i = 0; i < SECTION_MAX; ++i)
+	{
+		if (frame.sections[i] > turnSectionMax[i])
+		{
+			turnSectionMax[i] = frame.sections[i];
+		}
+	}
+	frame = FrameTimes();
+
+	if ((Uint64)std::chrono::duration_cast<std::chrono::microseconds>(now - lastOverlay).count() >= OVERLAY_INTERVAL)
+	{
+		updateOverlay();
+		intervalWorst = FrameTimes();
+		lastOverlay = now;
+	}
+}
+
+/**
+ * Writes the timings of the turn that just ended to the log,
+ * with the breakdown of its worst frame and the AI time
+ * of each unit, then starts collecting a new turn.
+ * @param turn Turn number.
+ * @param side Side that just played.
+ */
+void endTurn(int turn, const std::string &side)
+{
+	if (isEnabled() && turnFrames > 0)
+	{
+		Log(LOG_INFO) << "Frame profile: turn " << turn << ", " << side << " side: " << turnFrames << " frames, avg "
+			<< formatMs(turnSum.total / turnFrames) << " ms, worst " << formatMs(turnWorst.total) << " ms";
+		for (int i = 0; i < SECTION_MAX; ++i)
+		{
+			Log(LOG_INFO) << "  " << SECTION_NAMES[i] << ": " << turnCalls[i] << " calls, avg " << formatMs(turnSum.sections[i] / turnFrames)
+				<< " ms, max " << formatMs(turnSectionMax[i]) << " ms, worst frame " << formatMs(turnWorst.sections[i]) << " ms";
+		}
+		for (auto &unit : turnUnits)
+		{
+			Log(LOG_INFO) << "  " << SECTION_NAMES[SECTION_AI] << ", unit " << unit.first << ": " << unit.second.count << " calls, total "
+				<< formatMs(unit.second.total) << " ms, max " << formatMs(unit.second.max) << " ms";
+		}
+	}
+	turnFrames = 0;
+	turnSum = FrameTimes();
+	turnWorst = FrameTimes();
+	for (int i = 0; i < SECTION_MAX; ++i)
+	{
+		turnSectionMax[i] = 0;
+		turnCalls[i] = 0;
+	}
+	turnUnits.clear();
+}
+
+/**
+ * Gets the text for the overlay, updated about once a second with
+ * the average of the last frames and the worst frame since the last update.
+ * @return Overlay text, empty before the first update.
+ */
+const std::string &getOverlayText()
+{
+	return overlay;
+}
+
+/**
+ * Gets the name of a section, as used in the log.
+ * @param section Section.
+ * @return Section name.
+ */
+const char *getSectionName(Section section)
+{
+	return SECTION_NAMES[section];
+}
+
+/**
+ * Gets the time spent in a section while the profiler was enabled.
+ * @param section Section.
+ * @return Time in microseconds.
+ */
+Uint64 getTotalTime(Section section)
+{
+	return totalTime[section];
+}
+
+/**
+ * Gets how many times a section ran while the profiler was enabled.
+ * @param section Section.
+ * @return Number of runs.
+ */
+Uint32 getTotalCalls(Section section)
+{
+	return totalCalls[section];
+}
+
+}
+
+}
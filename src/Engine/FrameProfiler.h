@@ -0,0 +1,75 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <chrono>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Per frame timings of the expensive parts of the battlescape,
+ * shown as an overlay and written to the log at the end of each turn.
+ * Sections can run inside each other (eg. unit sprites are drawn
+ * during terrain drawing, the AI runs pathfinding), so their times
+ * don't add up to the frame time. Only active with the
+ * oxceFrameProfiler option, and only meant for the main thread.
+ */
+namespace FrameProfiler
+{
+	enum Section { SECTION_TERRAIN, SECTION_UNITS, SECTION_FLIP, SECTION_FOV, SECTION_LIGHTING, SECTION_PATHFINDING, SECTION_AI, SECTION_MAX };
+
+	/**
+	 * Times the scope it lives in as part of a section.
+	 */
+	class ScopedSection
+	{
+		Section _section;
+		int _unitId;
+		bool _entered, _active;
+		std::chrono::steady_clock::time_point _start;
+	public:
+		/// Starts timing a section, optionally for a unit.
+		ScopedSection(Section section, int unitId = -1);
+		/// Stops timing and adds the result to the section.
+		~ScopedSection();
+		ScopedSection(const ScopedSection&) = delete;
+		ScopedSection &operator=(const ScopedSection&) = delete;
+	};
+
+	/// Checks if the profiler is collecting timings.
+	bool isEnabled();
+	/// Marks the start of the work on the next frame.
+	void startFrame();
+	/// Finishes the current frame.
+	void endFrame();
+	/// Writes the timings of a turn to the log and starts a new turn.
+	void endTurn(int turn, const std::string &side);
+	/// Gets the overlay text with the recent timings.
+	const std::string &getOverlayText();
+	/// Gets the name of a section.
+	const char *getSectionName(Section section);
+	/// Gets the time spent in a section since startup.
+	Uint64 getTotalTime(Section section);
+	/// Gets the number of runs of a section since startup.
+	Uint32 getTotalCalls(Section section);
+}
+
+}
@@ -25,6 +25,7 @@
 #include "State.h"
 #include "Screen.h"
 #include "Sound.h"
+#include "Timer.h"
 #include "Music.h"
 #include "Language.h"
 #include "Logger.h"
@@ -33,11 +34,15 @@
 #include "../Mod/Mod.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SaveWriter.h"
 #include "Action.h"
 #include "Exception.h"
 #include "Options.h"
 #include "CrossPlatform.h"
 #include "FileMap.h"
+#include "ScalerThreads.h"
+#include "Profiler.h"
+#include "FrameProfiler.h"
 #include "Unicode.h"
 #include "../Menu/NotesState.h"
 #include "../Menu/TestState.h"
@@ -59,13 +64,15 @@ namespace OpenXcom
 {
 
 const double Game::VOLUME_GRADIENT = 10.0;
+/// Time in milliseconds for the d-pad to move the cursor by a step.
+const Uint32 Game::DPAD_CURSOR_INTERVAL = 10;
 
 /**
  * Starts up SDL with all the subsystems and SDL_mixer for audio processing,
  * creates the display screen and sets up the cursor.
  * @param title Title of the game window.
  */
-Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0), _mod(0), _quit(false), _init(false), _update(false),  _mouseActive(true), _timeUntilNextFrame(0)
+Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0), _mod(0), _quit(false), _init(false), _update(false),  _mouseActive(true), _nextFrameTime(0), _dpadHeld(false), _warped(false), _dpadTime(0), _warpX(0), _warpY(0)
 {
 	Options::reload = false;
 	Options::mute = false;
@@ -111,8 +118,6 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 
 	// Create blank language
 	_lang = new Language();
-
-	_timeOfLastFrame = 0;
 }
 
 /**
@@ -137,6 +142,9 @@ Game::~Game()
 	delete _screen;
 	delete _fpsCounter;
 
+	FileMap::stopParseThreads();
+	ScalerThreads::shutdown();
+
 	Mix_CloseAudio();
 
 	SDL_Quit();
@@ -156,6 +164,8 @@ void Game::run()
 	bool startupEvent = Options::allowResize;
 	while (!_quit)
 	{
+		FrameProfiler::startFrame();
+
 		// Clean up states
 		while (!_deleted.empty())
 		{
@@ -163,11 +173,15 @@ void Game::run()
 			_deleted.pop_back();
 		}
 
+		// Report finished background saves
+		SaveWriter::poll();
+
 		// Initialize active state
 		if (!_init)
 		{
 			_init = true;
 			_states.back()->init();
+			_screen->invalidate();
 
 			// Unpress buttons
 			_states.back()->resetAll();
@@ -271,6 +285,11 @@ void Game::run()
 							Options::captureMouse = (SDL_GrabMode)(!Options::captureMouse);
 							SDL_WM_GrabInput(Options::captureMouse);
 						}
+						// "ctrl-p" profiler report
+						else if (action.getDetails()->key.keysym.sym == SDLK_p && (SDL_GetModState() & KMOD_CTRL) != 0 && Profiler::isEnabled())
+						{
+							Profiler::report("on demand");
+						}
 						// "ctrl-n" notes UI
 						else if (action.getDetails()->key.keysym.sym == SDLK_n && (SDL_GetModState() & KMOD_CTRL) != 0)
 						{
@@ -315,79 +334,218 @@ void Game::run()
 		}
 
 
-		{
-			//poll mouse state
-
-			if ((keystate[BUTTON_DOWN] || keystate[BUTTON_UP] ||
-			keystate[BUTTON_LEFT] || keystate[BUTTON_RIGHT])) {
-				SDL_GetMouseState(&av_mouse_cur_x, &av_mouse_cur_y);
-				av_mouse_cur_x += 2 * (keystate[BUTTON_RIGHT] - keystate[BUTTON_LEFT]);
-				av_mouse_cur_y += 2 * (keystate[BUTTON_DOWN]  - keystate[BUTTON_UP]);
-
-				if (av_mouse_cur_x < 0) av_mouse_cur_x = 0;
-				if (av_mouse_cur_x > 640) av_mouse_cur_x = 640;
-				if (av_mouse_cur_y < 0) av_mouse_cur_y = 0;
-				if (av_mouse_cur_y > 480) av_mouse_cur_y = 480;
-
-				SDL_WarpMouse(av_mouse_cur_x, av_mouse_cur_y);
-			}
-		}
+		//poll mouse state
+		moveDpadCursor();
 
 		// Process rendering
 		if (runningState != PAUSED)
 		{
 			// Process logic
+			Timer::resetDeadline();
 			_states.back()->think();
 			_fpsCounter->think();
-			if (Options::FPS > 0 && !(Options::useOpenGL && Options::vSyncForOpenGL))
+			int fps = getFrameRate();
+			double now = SDL_GetTicks();
+			if (fps > 0)
 			{
-				// Update our FPS delay time based on the time of the last draw.
-				int fps = SDL_GetAppState() & SDL_APPINPUTFOCUS ? Options::FPS : Options::FPSInactive;
-
-				_timeUntilNextFrame = (1000.0f / fps) - (SDL_GetTicks() - _timeOfLastFrame);
-			}
-			else
-			{
-				_timeUntilNextFrame = 0;
+				// don't keep waiting on a slower rate after it changed
+				_nextFrameTime = std::min(_nextFrameTime, now + 1000.0 / fps);
 			}
 
-			if (_init && _timeUntilNextFrame <= 0)
+			if (_init && (fps == 0 || now >= _nextFrameTime))
 			{
-				// make a note of when this frame update occurred.
-				_timeOfLastFrame = SDL_GetTicks();
-				_fpsCounter->addFrame();
-				_screen->clear();
-				std::list<State*>::iterator i = _states.end();
-				do
+				if (fps > 0)
 				{
-					--i;
+					// the next frame is due one frame after this one was due, so
+					// rounding to whole milliseconds doesn't slow the rate down,
+					// unless drawing fell behind by more than a frame
+					_nextFrameTime += 1000.0 / fps;
+					if (_nextFrameTime < now)
+					{
+						_nextFrameTime = now + 1000.0 / fps;
+					}
 				}
-				while (i != _states.begin() && !(*i)->isScreen());
-
-				for (; i != _states.end(); ++i)
+				_fpsCounter->addFrame();
+				// only redraw what changed since the last frame, if anything
+				SDL_Rect area;
+				if (Surface::beginDamage(_screen->getSurface(), _screen->isInvalid(), &area))
 				{
-					(*i)->blit();
+					_screen->clear(&area);
+					std::list<State*>::iterator i = _states.end();
+					do
+					{
+						--i;
+					}
+					while (i != _states.begin() && !(*i)->isScreen());
+
+					for (; i != _states.end(); ++i)
+					{
+						(*i)->blit();
+					}
+					_fpsCounter->blit(_screen->getSurface());
+					_cursor->blit(_screen->getSurface());
+					Surface::endDamage();
+					_screen->flip(&area);
+					FrameProfiler::endFrame();
 				}
-				_fpsCounter->blit(_screen->getSurface());
-				_cursor->blit(_screen->getSurface());
-				_screen->flip();
 			}
 		}
 
 		// Save on CPU
-		switch (runningState)
+		if (Options::oxceEventDrivenSleep)
 		{
-			case RUNNING:
-				SDL_Delay(1); //Save CPU from going 100%
-				break;
-			case SLOWED: case PAUSED:
-				SDL_Delay(100); break; //More slowing down.
+			// sleep until the next frame or timer is due, waking up early on input
+			int timeout = 100;
+			if (runningState == RUNNING)
+			{
+				if (!_init)
+				{
+					timeout = 0;
+				}
+				else if (getFrameRate() > 0)
+				{
+					timeout = std::max(0, (int)std::ceil(_nextFrameTime - SDL_GetTicks()));
+					int timer = Timer::getTimeUntilDeadline();
+					if (timer >= 0)
+					{
+						timeout = std::min(timeout, timer);
+					}
+				}
+				else
+				{
+					timeout = 1;
+				}
+				if (_dpadHeld)
+				{
+					timeout = std::min(timeout, std::max(0, (int)(_dpadTime + DPAD_CURSOR_INTERVAL - SDL_GetTicks())));
+				}
+			}
+			waitForEvent(timeout);
+		}
+		else
+		{
+			switch (runningState)
+			{
+				case RUNNING:
+					SDL_Delay(1); //Save CPU from going 100%
+					break;
+				case SLOWED: case PAUSED:
+					SDL_Delay(100); break; //More slowing down.
+			}
 		}
 	}
 
+	// Don't cut a background save short
+	SaveWriter::wait();
 	Options::save();
 }
 
+/**
+ * Gets the frame rate the screen is drawn at, depending
+ * on the window having focus and the options.
+ * @return Frames per second, 0 if unlimited.
+ */
+int Game::getFrameRate() const
+{
+	if (Options::FPS <= 0 || (Options::useOpenGL && Options::vSyncForOpenGL))
+	{
+		return 0;
+	}
+	int fps = SDL_GetAppState() & SDL_APPINPUTFOCUS ? Options::FPS : Options::FPSInactive;
+	return std::max(0, fps);
+}
+
+/**
+ * Moves the cursor while the d-pad is held, by a step for each
+ * DPAD_CURSOR_INTERVAL that passed, so its speed doesn't depend
+ * on how often the main loop runs.
+ */
+void Game::moveDpadCursor()
+{
+	bool held = keystate[BUTTON_DOWN] || keystate[BUTTON_UP] || keystate[BUTTON_LEFT] || keystate[BUTTON_RIGHT];
+	Uint32 now = SDL_GetTicks();
+	int steps = 0;
+	if (!held)
+	{
+		_dpadHeld = false;
+		return;
+	}
+	if (!_dpadHeld)
+	{
+		// move right away when pressed
+		_dpadHeld = true;
+		_dpadTime = now;
+		steps = 1;
+	}
+	else
+	{
+		steps = (now - _dpadTime) / DPAD_CURSOR_INTERVAL;
+		_dpadTime += steps * DPAD_CURSOR_INTERVAL;
+	}
+	if (steps == 0)
+	{
+		return;
+	}
+
+	SDL_GetMouseState(&av_mouse_cur_x, &av_mouse_cur_y);
+	av_mouse_cur_x += 2 * steps * (keystate[BUTTON_RIGHT] - keystate[BUTTON_LEFT]);
+	av_mouse_cur_y += 2 * steps * (keystate[BUTTON_DOWN]  - keystate[BUTTON_UP]);
+
+	if (av_mouse_cur_x < 0) av_mouse_cur_x = 0;
+	if (av_mouse_cur_x > 640) av_mouse_cur_x = 640;
+	if (av_mouse_cur_y < 0) av_mouse_cur_y = 0;
+	if (av_mouse_cur_y > 480) av_mouse_cur_y = 480;
+
+	SDL_WarpMouse(av_mouse_cur_x, av_mouse_cur_y);
+	_warped = true;
+	_warpX = av_mouse_cur_x;
+	_warpY = av_mouse_cur_y;
+}
+
+/**
+ * Checks if an event is the motion queued by warping the cursor
+ * with the d-pad, which doesn't need to wake up the main loop.
+ * @param event Queued event.
+ * @return True if it's the d-pad motion.
+ */
+bool Game::isDpadMotion(const SDL_Event &event) const
+{
+	return _warped && event.type == SDL_MOUSEMOTION && event.motion.x == _warpX && event.motion.y == _warpY;
+}
+
+/**
+ * Puts the main loop to sleep until there's an event to process
+ * or the timeout runs out. SDL 1.2 has no waiting with a timeout,
+ * so the queue is checked in short slices like SDL_WaitEvent does.
+ * The cursor motion from the d-pad doesn't wake it up.
+ * @param timeout Maximum time to sleep in milliseconds.
+ */
+void Game::waitForEvent(int timeout)
+{
+	static const int EVENT_POLL_INTERVAL = 10;
+	static const int EVENT_PEEK_COUNT = 8;
+	Uint32 end = SDL_GetTicks() + std::max(timeout, 0);
+	SDL_Event events[EVENT_PEEK_COUNT];
+	while (true)
+	{
+		SDL_PumpEvents();
+		int count = SDL_PeepEvents(events, EVENT_PEEK_COUNT, SDL_PEEKEVENT, SDL_ALLEVENTS);
+		for (int i = 0; i < count; ++i)
+		{
+			if (!isDpadMotion(events[i]))
+			{
+				return;
+			}
+		}
+		int left = (int)(end - SDL_GetTicks());
+		if (left <= 0)
+		{
+			return;
+		}
+		SDL_Delay(std::min(left, EVENT_POLL_INTERVAL));
+	}
+}
+
 /**
  * Stops the state machine and the game is shut down.
  */
@@ -489,13 +647,18 @@ void Game::popState()
 }
 
 /**
- * Sets a new saved game for the game to use.
+ * Sets a new saved game for the game to use. Any battle
+ * of the old one is gone, so its resources are released.
  * @param save Pointer to the saved game.
  */
 void Game::setSavedGame(SavedGame *save)
 {
 	delete _save;
 	_save = save;
+	if (_mod)
+	{
+		_mod->unloadBattlescapeScope();
+	}
 }
 
 /**
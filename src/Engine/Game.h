@@ -52,9 +52,20 @@ private:
 	bool _quit, _init, _update;
 	FpsCounter *_fpsCounter;
 	bool _mouseActive;
-	unsigned int _timeOfLastFrame;
-	int _timeUntilNextFrame;
+	double _nextFrameTime;
+	bool _dpadHeld, _warped;
+	Uint32 _dpadTime;
+	int _warpX, _warpY;
 	static const double VOLUME_GRADIENT;
+	static const Uint32 DPAD_CURSOR_INTERVAL;
+	/// Moves the cursor with the d-pad.
+	void moveDpadCursor();
+	/// Checks if an event is the cursor motion caused by the d-pad.
+	bool isDpadMotion(const SDL_Event &event) const;
+	/// Gets the frame rate the screen is limited to.
+	int getFrameRate() const;
+	/// Sleeps until an event arrives or the timeout runs out.
+	void waitForEvent(int timeout);
 
 public:
 	/// Creates a new game and initializes SDL.
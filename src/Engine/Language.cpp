@@ -31,6 +31,7 @@
 #include "../Mod/ExtraStrings.h"
 #include "../Savegame/Soldier.h"
 #include "FileMap.h"
+#include "Profiler.h"
 
 namespace OpenXcom
 {
@@ -155,6 +156,7 @@ void Language::getList(std::vector<std::string> &ids, std::vector<std::string> &
  */
 void Language::loadFile(const FileMap::FileRecord *frec)
 {
+	Profiler::ScopedTimer timer("Language::loadFile");
 	YAML::Node doc = frec->getYAML();
 	YAML::Node lang;
 	if (doc.begin()->second.IsMap())
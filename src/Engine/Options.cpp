@@ -31,8 +31,10 @@
 #include "Exception.h"
 #include "Logger.h"
 #include "CrossPlatform.h"
+#include "BinaryYaml.h"
 #include "FileMap.h"
 #include "Screen.h"
+#include "Zoom.h"
 
 namespace OpenXcom
 {
@@ -229,6 +231,18 @@ void create()
 	_info.push_back(OptionInfo("oxceEnableUnitResponseSounds", &oxceEnableUnitResponseSounds, true));
 	_info.push_back(OptionInfo("oxceEnableSlackingIndicator", &oxceEnableSlackingIndicator, true));
 	_info.push_back(OptionInfo("oxceEnablePaletteFlickerFix", &oxceEnablePaletteFlickerFix, false));
+	_info.push_back(OptionInfo("oxceEventDrivenSleep", &oxceEventDrivenSleep, true));
+	_info.push_back(OptionInfo("oxceBinarySaves", &oxceBinarySaves, false));
+	_info.push_back(OptionInfo("oxceRulesetLoadThreads", &oxceRulesetLoadThreads, 0));
+	_info.push_back(OptionInfo("oxceRulesetCache", &oxceRulesetCache, true));
+	_info.push_back(OptionInfo("oxceProfileStartup", &oxceProfileStartup, false));
+	_info.push_back(OptionInfo("oxceRecolorCacheSize", &oxceRecolorCacheSize, 0)); // KB, opt-in: scripts reading state missing from the cache key would draw stale sprites
+	_info.push_back(OptionInfo("oxceGlobeFixedShading", &oxceGlobeFixedShading, true));
+	_info.push_back(OptionInfo("oxceFrameProfiler", &oxceFrameProfiler, false));
+	_info.push_back(OptionInfo("oxceScalerThreads", &oxceScalerThreads, 0));
+	_info.push_back(OptionInfo("oxceUnloadBattlescapeResources", &oxceUnloadBattlescapeResources, true));
+	_info.push_back(OptionInfo("oxceSoundCacheSize", &oxceSoundCacheSize, 12288)); // KB, room for all of BATTLE.CAT decoded at 22050 Hz 16-bit stereo
+	_info.push_back(OptionInfo("oxceSoundPreload", &oxceSoundPreload, true));
 	_info.push_back(OptionInfo("oxcePersonalLayoutIncludingArmor", &oxcePersonalLayoutIncludingArmor, true));
 	_info.push_back(OptionInfo("oxceManufactureFilterSuppliesOK", &oxceManufactureFilterSuppliesOK, false));
 
@@ -534,6 +548,22 @@ static bool showHelp()
 	help << "        use PATH as the default Config Folder instead of auto-detecting" << std::endl << std::endl;
 	help << "-master MOD" << std::endl;
 	help << "        set MOD to the current master mod (eg. -master xcom2)" << std::endl << std::endl;
+	help << "-convertSave SOURCE DESTINATION" << std::endl;
+	help << "        convert the saved game SOURCE between the binary and text formats into DESTINATION, then exit" << std::endl << std::endl;
+	help << "-benchmark SAVE TURNS" << std::endl;
+	help << "        play TURNS alien turns of the battle in SAVE without drawing, print the timings, then exit" << std::endl << std::endl;
+	help << "-benchmarkBattle DEPLOYMENT TERRAIN SEED TURNS" << std::endl;
+	help << "        same as -benchmark, on a battle generated from DEPLOYMENT (or a UFO type) and TERRAIN with random SEED" << std::endl;
+	help << "        (set SDL_VIDEODRIVER=dummy to run without a display)" << std::endl << std::endl;
+	help << "-benchmarkExplosions SAVE COUNT" << std::endl;
+	help << "        set off COUNT explosions in the battle in SAVE with the former and the current explosion code," << std::endl;
+	help << "        print the timings and check that both left the battle the same, then exit" << std::endl << std::endl;
+	help << "-benchmarkScalers FRAMES" << std::endl;
+	help << "        print the time per frame of the xBRZ and HQX filters, scaling FRAMES frames with each, then exit" << std::endl << std::endl;
+	help << "-benchmarkPathfinding SAVE SEARCHES" << std::endl;
+	help << "        run SEARCHES pathfinding searches of the units in the battle in SAVE to random positions, print the timings, then exit" << std::endl << std::endl;
+	help << "-benchmarkSave FILE ROUNDS" << std::endl;
+	help << "        print the time to write and read the saved game FILE in the text and binary formats, ROUNDS times each, then exit" << std::endl << std::endl;
 	help << "-KEY VALUE" << std::endl;
 	help << "        override option KEY with VALUE (eg. -displayWidth 640)" << std::endl << std::endl;
 	help << "-help" << std::endl;
@@ -559,6 +589,84 @@ static bool showHelp()
 	return false;
 }
 
+/**
+ * Converts a saved game between the binary and text formats
+ * when requested on the command-line.
+ * @return True if a conversion was requested.
+ */
+static bool convertSave()
+{
+	std::vector<std::string> params;
+	if (!CrossPlatform::findArgs("convertsave", 2, params))
+	{
+		return false;
+	}
+	if (params.empty())
+	{
+		std::cerr << "Usage: openxcom -convertSave SOURCE DESTINATION" << std::endl;
+		return true;
+	}
+	try
+	{
+		BinaryYaml::convertFile(params[0], params[1]);
+		std::cout << "Converted " << params[0] << " to " << params[1] << std::endl;
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << e.what() << std::endl;
+	}
+	return true;
+}
+
+/**
+ * Times the 32-bit scalers when requested on the command-line.
+ * @return True if a benchmark was requested.
+ */
+static bool benchmarkScalers()
+{
+	std::vector<std::string> params;
+	if (!CrossPlatform::findArgs("benchmarkscalers", 1, params))
+	{
+		return false;
+	}
+	int frames = params.empty() ? 0 : atoi(params[0].c_str());
+	if (frames <= 0)
+	{
+		std::cerr << "Usage: openxcom -benchmarkScalers FRAMES" << std::endl;
+		return true;
+	}
+	Zoom::benchmarkScalers(frames);
+	return true;
+}
+
+/**
+ * Times the text and binary save formats when requested on the command-line.
+ * @return True if a benchmark was requested.
+ */
+static bool benchmarkSave()
+{
+	std::vector<std::string> params;
+	if (!CrossPlatform::findArgs("benchmarksave", 2, params))
+	{
+		return false;
+	}
+	int rounds = params.empty() ? 0 : atoi(params[1].c_str());
+	if (rounds <= 0)
+	{
+		std::cerr << "Usage: openxcom -benchmarkSave FILE ROUNDS" << std::endl;
+		return true;
+	}
+	try
+	{
+		BinaryYaml::benchmark(params[0], rounds);
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << e.what() << std::endl;
+	}
+	return true;
+}
+
 const std::map<std::string, ModInfo> &getModInfos() { return _modInfos; }
 
 /**
@@ -588,7 +696,7 @@ static void userSplitMasters()
  */
 bool init()
 {
-	if (showHelp())
+	if (showHelp() || convertSave() || benchmarkScalers() || benchmarkSave())
 		return false;
 	create();
 	resetDefault();
@@ -78,6 +78,18 @@ OPT int oxceInterceptGuiMaintenanceTimeHidden;
 OPT bool oxceEnableUnitResponseSounds;
 OPT bool oxceEnableSlackingIndicator;
 OPT bool oxceEnablePaletteFlickerFix;
+OPT bool oxceEventDrivenSleep;
+OPT bool oxceBinarySaves;
+OPT int oxceRulesetLoadThreads;
+OPT bool oxceRulesetCache;
+OPT bool oxceProfileStartup;
+OPT int oxceRecolorCacheSize;
+OPT bool oxceGlobeFixedShading;
+OPT bool oxceFrameProfiler;
+OPT int oxceScalerThreads;
+OPT bool oxceUnloadBattlescapeResources;
+OPT int oxceSoundCacheSize;
+OPT bool oxceSoundPreload;
 OPT bool oxcePersonalLayoutIncludingArmor;
 OPT bool oxceManufactureFilterSuppliesOK;
 
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Profiler.h"
+#include <deque>
+#include <map>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
+#include "Logger.h"
+#include "Options.h"
+#include "CrossPlatform.h"
+
+namespace OpenXcom
+{
+
+namespace Profiler
+{
+
+/**
+ * Timings of a named section under a specific parent.
+ */
+struct Entry
+{
+	std::string name;
+	Entry *parent;
+	std::vector<Entry*> children;
+	Uint32 count;
+	Uint64 total, max; // in microseconds
+};
+
+namespace
+{
+
+const std::string CSV_FILE = "profile.csv";
+
+/// Entries never move or go away, so pointers to them stay valid.
+std::deque<Entry> entries;
+/// Innermost running section of each thread.
+std::map<Uint32, Entry*> current;
+/// Named counters, eg. of allocations.
+std::map<std::string, Uint64> counters;
+
+SDL_mutex *getMutex()
+{
+	static SDL_mutex *mutex = SDL_CreateMutex();
+	return mutex;
+}
+
+Entry *getRoot()
+{
+	if (entries.empty())
+	{
+		entries.push_back(Entry{ "", nullptr, {}, 0, 0, 0 });
+	}
+	return &entries.front();
+}
+
+/**
+ * Finds or creates the entry for a section
+ * under the running section of this thread.
+ * @param name Section name.
+ * @return The section entry.
+ */
+Entry *enter(const std::string &name)
+{
+	SDL_mutexP(getMutex());
+	Entry *&top = current[SDL_ThreadID()];
+	if (top == nullptr)
+	{
+		top = getRoot();
+	}
+	Entry *entry = nullptr;
+	for (auto *child : top->children)
+	{
+		if (child->name == name)
+		{
+			entry = child;
+			break;
+		}
+	}
+	if (entry == nullptr)
+	{
+		entries.push_back(Entry{ name, top, {}, 0, 0, 0 });
+		entry = &entries.back();
+		top->children.push_back(entry);
+	}
+	top = entry;
+	SDL_mutexV(getMutex());
+	return entry;
+}
+
+/**
+ * Adds a finished run to a section and makes
+ * its parent the running section again.
+ * @param entry The section entry.
+ * @param time Run time in microseconds.
+ */
+void leave(Entry *entry, Uint64 time)
+{
+	SDL_mutexP(getMutex());
+	entry->count++;
+	entry->total += time;
+	if (time > entry->max)
+	{
+		entry->max = time;
+	}
+	current[SDL_ThreadID()] = entry->parent;
+	SDL_mutexV(getMutex());
+}
+
+std::string formatMs(Uint64 time)
+{
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(1) << time / 1000.0;
+	return ss.str();
+}
+
+/**
+ * Writes a section and everything under it to the log and CSV.
+ * @param entry The section entry.
+ * @param path Path of the parent section.
+ * @param depth Nesting depth of the section.
+ * @param csv CSV output.
+ */
+void reportEntry(const Entry *entry, const std::string &path, int depth, std::ostringstream &csv)
+{
+	Uint64 self = entry->total;
+	for (auto *child : entry->children)
+	{
+		self = (child->total < self) ? self - child->total : 0;
+	}
+	std::string name = path.empty() ? entry->name : path + "/" + entry->name;
+	Log(LOG_INFO) << std::string(depth * 2, ' ') << entry->name << ": " << entry->count << "x, total " << formatMs(entry->total)
+		<< " ms, self " << formatMs(self) << " ms, max " << formatMs(entry->max) << " ms";
+	std::string quoted = name;
+	for (size_t i = quoted.find('"'); i != std::string::npos; i = quoted.find('"', i + 2))
+	{
+		quoted.insert(i, 1, '"');
+	}
+	csv << '"' << quoted << "\"," << depth << ',' << entry->count << ',' << formatMs(entry->total)
+		<< ',' << formatMs(self) << ',' << formatMs(entry->max) << '\n';
+	for (auto *child : entry->children)
+	{
+		reportEntry(child, name, depth + 1, csv);
+	}
+}
+
+}
+
+/**
+ * Starts timing a named section, if profiling is enabled.
+ * @param name Section name.
+ */
+ScopedTimer::ScopedTimer(const char *name) : _entry(nullptr)
+{
+	if (Options::oxceProfileStartup)
+	{
+		_entry = enter(name);
+		_start = std::chrono::steady_clock::now();
+	}
+}
+
+/**
+ * Starts timing a named section, if profiling is enabled.
+ * @param name Section name.
+ */
+ScopedTimer::ScopedTimer(const std::string &name) : _entry(nullptr)
+{
+	if (Options::oxceProfileStartup)
+	{
+		_entry = enter(name);
+		_start = std::chrono::steady_clock::now();
+	}
+}
+
+/**
+ * Stops timing and adds the run to the section.
+ */
+ScopedTimer::~ScopedTimer()
+{
+	if (_entry)
+	{
+		auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start);
+		leave(_entry, time.count());
+	}
+}
+
+/**
+ * Checks if the profiler is collecting timings.
+ * @return True if enabled.
+ */
+bool isEnabled()
+{
+	return Options::oxceProfileStartup;
+}
+
+/**
+ * Adds to a named counter, if profiling is enabled.
+ * Counters are reported after the timings.
+ * @param name Counter name.
+ * @param amount Amount to add.
+ */
+void addCount(const std::string &name, Uint64 amount)
+{
+	if (Options::oxceProfileStartup)
+	{
+		SDL_mutexP(getMutex());
+		counters[name] += amount;
+		SDL_mutexV(getMutex());
+	}
+}
+
+/**
+ * Writes the timings collected so far to the log, indented by
+ * nesting, and to a CSV file in the user folder for comparing runs.
+ * Sections still running are not included.
+ * @param title Title of the report.
+ */
+void report(const std::string &title)
+{
+	if (!isEnabled())
+	{
+		return;
+	}
+	std::ostringstream csv;
+	csv << "section,depth,count,total_ms,self_ms,max_ms\n";
+	Log(LOG_INFO) << "Profile: " << title;
+	SDL_mutexP(getMutex());
+	for (auto *child : getRoot()->children)
+	{
+		reportEntry(child, "", 0, csv);
+	}
+	for (auto &counter : counters)
+	{
+		Log(LOG_INFO) << counter.first << ": " << counter.second;
+		csv << "\"counter/" << counter.first << "\",0," << counter.second << ",,,\n";
+	}
+	SDL_mutexV(getMutex());
+	CrossPlatform::writeFile(Options::getUserFolder() + CSV_FILE, csv.str());
+}
+
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <chrono>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Lightweight instrumentation for slow one-off work like startup.
+ * Timers nest, so every entry is kept under the timer that was
+ * running when it started, with its call count, total, self
+ * and longest time. Only active with the oxceProfileStartup option.
+ */
+namespace Profiler
+{
+	struct Entry;
+
+	/**
+	 * Times the scope it lives in.
+	 */
+	class ScopedTimer
+	{
+		Entry *_entry;
+		std::chrono::steady_clock::time_point _start;
+	public:
+		/// Starts timing a named section.
+		ScopedTimer(const char *name);
+		/// Starts timing a named section.
+		ScopedTimer(const std::string &name);
+		/// Stops timing and adds the result to the section.
+		~ScopedTimer();
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer &operator=(const ScopedTimer&) = delete;
+	};
+
+	/// Checks if the profiler is collecting timings.
+	bool isEnabled();
+	/// Adds to a named counter, reported with the timings.
+	void addCount(const std::string &name, Uint64 amount);
+	/// Writes the collected timings to the log and a CSV file.
+	void report(const std::string &title);
+}
+
+}
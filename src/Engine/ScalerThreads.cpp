@@ -0,0 +1,259 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ScalerThreads.h"
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
+#include "Logger.h"
+
+namespace OpenXcom
+{
+
+namespace ScalerThreads
+{
+
+namespace
+{
+
+/// Fewest source rows in a band, xBRZ wastes some work on the first row of each band.
+const int MIN_BAND_ROWS = 16;
+/// Bands per thread, so a slow thread doesn't hold up the whole frame.
+const int BANDS_PER_THREAD = 2;
+
+SDL_mutex *mutex = 0;
+SDL_cond *startCond = 0, *doneCond = 0;
+std::vector<SDL_Thread*> workers;
+/// Requested thread count, 0 for automatic.
+int requested = 0;
+bool started = false, quit = false;
+
+/// Current job, only valid while a frame is being scaled.
+const std::function<void(int, int)> *currentJob = 0;
+int jobRows = 0, bandRows = 0, nextBand = 0, bandCount = 0, pendingBands = 0;
+unsigned int generation = 0;
+
+/**
+ * Takes the next band of the current job and scales it.
+ * Called with the mutex locked, returns with it locked.
+ * @return False if there were no bands left.
+ */
+bool scaleBand()
+{
+	if (nextBand >= bandCount)
+	{
+		return false;
+	}
+	int band = nextBand++;
+	int yFirst = band * bandRows;
+	int yLast = std::min(yFirst + bandRows, jobRows);
+	const std::function<void(int, int)> &job = *currentJob;
+	SDL_mutexV(mutex);
+	job(yFirst, yLast);
+	SDL_mutexP(mutex);
+	if (--pendingBands == 0)
+	{
+		SDL_CondSignal(doneCond);
+	}
+	return true;
+}
+
+/**
+ * Worker thread, scales bands of each new job until told to quit.
+ * @param data Unused.
+ * @return Always 0.
+ */
+int worker(void *)
+{
+	unsigned int seen = 0;
+	SDL_mutexP(mutex);
+	while (true)
+	{
+		while (seen == generation && !quit)
+		{
+			SDL_CondWait(startCond, mutex);
+		}
+		if (quit)
+		{
+			break;
+		}
+		seen = generation;
+		while (scaleBand());
+	}
+	SDL_mutexV(mutex);
+	return 0;
+}
+
+/**
+ * Stops all the worker threads.
+ */
+void stop()
+{
+	if (workers.empty())
+	{
+		return;
+	}
+	SDL_mutexP(mutex);
+	quit = true;
+	SDL_CondBroadcast(startCond);
+	SDL_mutexV(mutex);
+	for (auto *thread : workers)
+	{
+		SDL_WaitThread(thread, 0);
+	}
+	workers.clear();
+	quit = false;
+}
+
+/**
+ * Starts the worker threads for the requested thread count.
+ */
+void start()
+{
+	started = true;
+	int threads = requested;
+	if (threads <= 0)
+	{
+#ifdef DINGOO
+		threads = 1;
+#else
+		threads = std::max(1, std::min(4, (int)std::thread::hardware_concurrency()));
+#endif
+	}
+	if (threads <= 1)
+	{
+		return;
+	}
+	if (mutex == 0)
+	{
+		mutex = SDL_CreateMutex();
+		startCond = SDL_CreateCond();
+		doneCond = SDL_CreateCond();
+		if (mutex == 0 || startCond == 0 || doneCond == 0)
+		{
+			Log(LOG_WARNING) << "Failed to create scaler thread locks, scaling on a single thread";
+			return;
+		}
+	}
+	// the calling thread is one of the threads
+	for (int i = 1; i < threads; ++i)
+	{
+		SDL_Thread *thread = SDL_CreateThread(worker, 0);
+		if (thread == 0)
+		{
+			Log(LOG_WARNING) << "Failed to create scaler thread: " << SDL_GetError();
+			break;
+		}
+		workers.push_back(thread);
+	}
+}
+
+}
+
+/**
+ * Scales the rows of a frame in bands, on the worker threads and the
+ * calling thread, and waits until all of them are done. The job must
+ * be safe to call at the same time for rows that don't overlap.
+ * @param rows Number of source rows.
+ * @param job Function scaling the source rows [yFirst, yLast).
+ */
+void run(int rows, const std::function<void(int, int)> &job)
+{
+	if (!started)
+	{
+		start();
+	}
+	int threads = (int)workers.size() + 1;
+	if (threads == 1 || rows < MIN_BAND_ROWS * 2)
+	{
+		job(0, rows);
+		return;
+	}
+	int bands = std::max(1, std::min(threads * BANDS_PER_THREAD, rows / MIN_BAND_ROWS));
+
+	SDL_mutexP(mutex);
+	currentJob = &job;
+	jobRows = rows;
+	bandRows = (rows + bands - 1) / bands;
+	bandCount = (rows + bandRows - 1) / bandRows;
+	nextBand = 0;
+	pendingBands = bandCount;
+	generation++;
+	SDL_CondBroadcast(startCond);
+	while (scaleBand());
+	while (pendingBands > 0)
+	{
+		SDL_CondWait(doneCond, mutex);
+	}
+	currentJob = 0;
+	SDL_mutexV(mutex);
+}
+
+/**
+ * Gets the number of threads the scaling is split between,
+ * starting the workers if they aren't yet.
+ * @return Number of threads, including the calling thread.
+ */
+int getThreads()
+{
+	if (!started)
+	{
+		start();
+	}
+	return (int)workers.size() + 1;
+}
+
+/**
+ * Sets the number of threads to split the scaling between,
+ * restarting the workers if it changed.
+ * @param threads Number of threads including the calling one, 0 for automatic.
+ */
+void setThreads(int threads)
+{
+	if (threads != requested || !started)
+	{
+		stop();
+		requested = threads;
+		start();
+	}
+}
+
+/**
+ * Stops the worker threads and frees their locks,
+ * so nothing is left running when the game shuts down.
+ */
+void shutdown()
+{
+	stop();
+	started = false;
+	if (mutex != 0)
+	{
+		SDL_DestroyCond(doneCond);
+		SDL_DestroyCond(startCond);
+		SDL_DestroyMutex(mutex);
+		doneCond = 0;
+		startCond = 0;
+		mutex = 0;
+	}
+}
+
+}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <functional>
+
+namespace OpenXcom
+{
+
+/**
+ * Worker threads for the 32-bit screen scalers. The rows of the
+ * source image are split into horizontal bands that are scaled in
+ * parallel, with the calling thread taking bands too. The workers
+ * are started on first use and kept waiting between frames, so a
+ * frame only costs waking them up. Falls back to scaling everything
+ * on the calling thread if the threads can't be created.
+ */
+namespace ScalerThreads
+{
+	/// Scales the rows [0, rows) in bands, calling job(yFirst, yLast) for each band.
+	void run(int rows, const std::function<void(int, int)> &job);
+	/// Gets the number of threads used for scaling, including the calling thread.
+	int getThreads();
+	/// Sets the number of threads used for scaling, 0 for automatic.
+	void setThreads(int threads);
+	/// Stops the worker threads, they are started again when needed.
+	void shutdown();
+}
+
+}
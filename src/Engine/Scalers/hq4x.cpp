@@ -163,15 +163,15 @@
 #define PIXEL33_81    *(dp+dpL+dpL+dpL+3) = Interp8(w[5], w[6]);
 #define PIXEL33_82    *(dp+dpL+dpL+dpL+3) = Interp8(w[5], w[8]);
 
-HQX_API void HQX_CALLCONV hq4x_32_rb(const uint32_t* sp, uint32_t srb, uint32_t* dp, uint32_t drb, int Xres, int Yres )
+HQX_API void HQX_CALLCONV hq4x_32_rb_slice(const uint32_t* sp, uint32_t srb, uint32_t* dp, uint32_t drb, int Xres, int Yres, int yFirst, int yLast )
 {
     int  i, j, k;
     int  prevline, nextline;
     uint32_t w[10];
     int dpL = (drb >> 2);
     int spL = (srb >> 2);
-    const uint8_t* sRowP = (const uint8_t*) sp;
-    const uint8_t* dRowP = (const uint8_t*) dp;
+    const uint8_t* sRowP = (const uint8_t*) sp + srb * yFirst;
+    const uint8_t* dRowP = (const uint8_t*) dp + drb * 4 * yFirst;
     uint32_t yuv1, yuv2;
 
     //   +----+----+----+
@@ -185,7 +185,11 @@ HQX_API void HQX_CALLCONV hq4x_32_rb(const uint32_t* sp, uint32_t srb, uint32_t*
     //   | w7 | w8 | w9 |
     //   +----+----+----+
 
-    for (j=0; j<Yres; j++)
+    if (yLast > Yres) yLast = Yres;
+    sp = (const uint32_t*) sRowP;
+    dp = (uint32_t*) dRowP;
+
+    for (j=yFirst; j<yLast; j++)
     {
         if (j>0)      prevline = -spL;
         else prevline = 0;
@@ -5228,6 +5232,11 @@ HQX_API void HQX_CALLCONV hq4x_32_rb(const uint32_t* sp, uint32_t srb, uint32_t*
     }
 }
 
+HQX_API void HQX_CALLCONV hq4x_32_rb(const uint32_t* sp, uint32_t srb, uint32_t* dp, uint32_t drb, int Xres, int Yres )
+{
+    hq4x_32_rb_slice(sp, srb, dp, drb, Xres, Yres, 0, Yres);
+}
+
 HQX_API void HQX_CALLCONV hq4x_32(const uint32_t* sp, uint32_t* dp, int Xres, int Yres )
 {
     uint32_t rowBytesL = Xres * 4;
@@ -52,4 +52,9 @@ HQX_API void HQX_CALLCONV hq2x_32_rb(const uint32_t* src, uint32_t src_rowBytes,
 HQX_API void HQX_CALLCONV hq3x_32_rb(const uint32_t* src, uint32_t src_rowBytes, uint32_t* dest, uint32_t dest_rowBytes, int width, int height );
 HQX_API void HQX_CALLCONV hq4x_32_rb(const uint32_t* src, uint32_t src_rowBytes, uint32_t* dest, uint32_t dest_rowBytes, int width, int height );
 
+/* scale only the source rows [yFirst, yLast), the other rows are still read as neighbors, so slices can run in parallel */
+HQX_API void HQX_CALLCONV hq2x_32_rb_slice(const uint32_t* src, uint32_t src_rowBytes, uint32_t* dest, uint32_t dest_rowBytes, int width, int height, int yFirst, int yLast );
+HQX_API void HQX_CALLCONV hq3x_32_rb_slice(const uint32_t* src, uint32_t src_rowBytes, uint32_t* dest, uint32_t dest_rowBytes, int width, int height, int yFirst, int yLast );
+HQX_API void HQX_CALLCONV hq4x_32_rb_slice(const uint32_t* src, uint32_t src_rowBytes, uint32_t* dest, uint32_t dest_rowBytes, int width, int height, int yFirst, int yLast );
+
 #endif
@@ -29,6 +29,7 @@
 #include "Logger.h"
 #include "Action.h"
 #include "Options.h"
+#include "FrameProfiler.h"
 #include "CrossPlatform.h"
 #include "FileMap.h"
 #include "Zoom.h"
@@ -112,7 +113,7 @@ void Screen::makeVideoFlags()
  * Initializes a new display screen for the game to render contents to.
  * The screen is set up based on the current options.
  */
-Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false)
+Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false), _fullRedraw(true)
 {
 	_flickerFix = Options::oxceEnablePaletteFlickerFix;
 
@@ -187,9 +188,14 @@ void Screen::handle(Action *action)
  * If the scaling factor is bigger than 1, the entire contents
  * of the buffer are resized by that factor (eg. 2 = doubled)
  * before being put on screen.
+ * On a single-buffered unscaled display only the redrawn area is copied.
+ * @param area Area of the buffer that was redrawn, or null for all of it.
  */
-void Screen::flip()
+void Screen::flip(const SDL_Rect *area)
 {
+	FrameProfiler::ScopedSection profile(FrameProfiler::SECTION_FLIP);
+	bool paletteChanged = _pushPalette && _numColors && _screen->format->BitsPerPixel == 8;
+
 	// perform any requested palette update
 	if (_flickerFix && _pushPalette && _numColors && _screen->format->BitsPerPixel == 8)
 	{
@@ -201,9 +207,22 @@ void Screen::flip()
 		_pushPalette = false;
 	}
 
+	// with page flipping every page has to be redrawn in full
+	bool partial = area && !_fullRedraw && !paletteChanged && !(_screen->flags & SDL_DOUBLEBUF);
 	if (getWidth() != _baseWidth || getHeight() != _baseHeight || useOpenGL())
 	{
-		Zoom::flipWithZoom(_surface.get(), _screen, _topBlackBand, _bottomBlackBand, _leftBlackBand, _rightBlackBand, &glOutput);
+		if (!useOpenGL() && (_topBlackBand > 0 || _bottomBlackBand > 0 || _leftBlackBand > 0 || _rightBlackBand > 0))
+		{
+			// the zoom doesn't touch the black bands
+			Surface::CleanSdlSurface(_screen);
+		}
+		Zoom::flipWithZoom(_surface.get(), _screen, _topBlackBand, _bottomBlackBand, _leftBlackBand, _rightBlackBand, _letterbox, &glOutput);
+		partial = false;
+	}
+	else if (partial)
+	{
+		SDL_Rect src = *area, dest = *area;
+		SDL_BlitSurface(_surface.get(), &src, _screen, &dest);
 	}
 	else
 	{
@@ -222,20 +241,32 @@ void Screen::flip()
 	}
 
 
-
-	if (SDL_Flip(_screen) == -1)
+	_fullRedraw = false;
+	if (partial)
+	{
+		SDL_UpdateRect(_screen, area->x, area->y, area->w, area->h);
+	}
+	else if (SDL_Flip(_screen) == -1)
 	{
 		throw Exception(SDL_GetError());
 	}
 }
 
 /**
- * Clears all the contents out of the internal buffer.
+ * Clears the contents out of the internal buffer.
+ * @param area Area to clear, or null for all of it.
  */
-void Screen::clear()
+void Screen::clear(const SDL_Rect *area)
 {
-	Surface::CleanSdlSurface(_surface.get());
-	Surface::CleanSdlSurface(_screen);
+	if (area)
+	{
+		SDL_Rect rect = *area;
+		SDL_FillRect(_surface.get(), &rect, 0);
+	}
+	else
+	{
+		Surface::CleanSdlSurface(_surface.get());
+	}
 }
 
 /**
@@ -263,6 +294,9 @@ void Screen::setPalette(const SDL_Color* colors, int firstcolor, int ncolors, bo
 	}
 
 	SDL_SetColors(_surface.get(), const_cast<SDL_Color *>(colors), firstcolor, ncolors);
+	// the buffer may be unchanged (eg. fades), but on displays that aren't
+	// 8bpp its pixels have to be converted again with the new colors
+	_fullRedraw = true;
 
 	// defer actual update of screen until SDL_Flip()
 	if (immediately && _screen->format->BitsPerPixel == 8 && SDL_SetColors(_screen, const_cast<SDL_Color *>(colors), firstcolor, ncolors) == 0)
@@ -328,6 +362,8 @@ void Screen::resetDisplay(bool resetVideo, bool noShaders)
 	Uint32 oldFlags = _flags;
 #endif
 	makeVideoFlags();
+	// the display format may change, the buffer is created again on the next flip
+	_letterbox.reset();
 
 	if (!_surface || (_surface->format->BitsPerPixel != _bpp ||
 		_surface->w != _baseWidth ||
@@ -492,6 +528,8 @@ void Screen::resetDisplay(bool resetVideo, bool noShaders)
 	{
 		setPalette(getPalette());
 	}
+	Surface::CleanSdlSurface(_screen);
+	_fullRedraw = true;
 }
 
 /**
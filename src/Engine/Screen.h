@@ -52,6 +52,10 @@ private:
 	OpenGL glOutput;
 	Surface::UniqueBufferPtr _buffer;
 	Surface::UniqueSurfacePtr _surface;
+	/// Scaled frame before it's blitted between the black bands, for scalers that need it.
+	Surface::UniqueSurfacePtr _letterbox;
+	/// Forces the next frame to redraw the whole display.
+	bool _fullRedraw;
 	/// Sets the _flags and _bpp variables based on game options; needed in more than one place now
 	void makeVideoFlags();
 public:
@@ -71,9 +75,13 @@ public:
 	/// Handles keyboard events.
 	void handle(Action *action);
 	/// Renders the screen onto the game window.
-	void flip();
+	void flip(const SDL_Rect *area = 0);
 	/// Clears the screen.
-	void clear();
+	void clear(const SDL_Rect *area = 0);
+	/// Forces the next frame to redraw the whole display.
+	void invalidate() { _fullRedraw = true; }
+	/// Does the next frame have to redraw the whole display?
+	bool isInvalid() const { return _fullRedraw; }
 	/// Sets the screen's 8bpp palette.
 	void setPalette(const SDL_Color *colors, int firstcolor = 0, int ncolors = 256, bool immediately = false);
 	/// Gets the screen's 8bpp palette.
@@ -33,6 +33,7 @@
 #include "ShaderDraw.h"
 #include "ShaderMove.h"
 #include "Exception.h"
+#include "Profiler.h"
 #include "../fallthrough.h"
 
 namespace OpenXcom
@@ -450,6 +451,47 @@ void ScriptWorkerBlit::executeBlit(Surface* src, Surface* dest, int x, int y, in
 {
 	executeBlit(src, dest, x, y, shade, GraphSubset{ dest->getWidth(), dest->getHeight() } );
 }
+
+/**
+ * Calculate new color of one pixel using script and global events.
+ * @param src source pixel.
+ * @param dest destination pixel.
+ * @return new color, zero if destination pixel should not change.
+ */
+inline int ScriptWorkerBlit::executePixel(Uint8 src, Uint8 dest)
+{
+	ScriptWorkerBlit::Output arg = { src, dest };
+	set(arg);
+	if (_events)
+	{
+		auto ptr = _events;
+		while (*ptr)
+		{
+			reset(arg);
+			scriptExe(*this, ptr->data());
+			++ptr;
+		}
+		++ptr;
+
+		reset(arg);
+		scriptExe(*this, _proc);
+
+		while (*ptr)
+		{
+			reset(arg);
+			scriptExe(*this, ptr->data());
+			++ptr;
+		}
+		++ptr;
+	}
+	else
+	{
+		scriptExe(*this, _proc);
+	}
+	get(arg);
+	return arg.getFirst();
+}
+
 /**
  * Blitting one surface to another using script.
  * @param src source surface.
@@ -466,37 +508,23 @@ void ScriptWorkerBlit::executeBlit(Surface* src, Surface* dest, int x, int y, in
 
 	if (_proc)
 	{
-		if (_events)
+		if (_sourceOnly)
 		{
+			// script do not see destination pixel, every source color
+			// have only one result and script need run once per color.
+			int lookup[256];
+			bool lookupDone[256] = { };
 			ShaderDrawFunc(
 				[&](Uint8& destStuff, const Uint8& srcStuff)
 				{
 					if (srcStuff)
 					{
-						ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
-						set(arg);
-						auto ptr = _events;
-						while (*ptr)
-						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
-						}
-						++ptr;
-
-						reset(arg);
-						scriptExe(*this, _proc);
-
-						while (*ptr)
+						if (!lookupDone[srcStuff])
 						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
+							lookup[srcStuff] = executePixel(srcStuff, 0);
+							lookupDone[srcStuff] = true;
 						}
-						++ptr;
-
-						get(arg);
-						if (arg.getFirst()) destStuff = arg.getFirst();
+						if (lookup[srcStuff]) destStuff = lookup[srcStuff];
 					}
 				},
 				destShader,
@@ -510,11 +538,8 @@ void ScriptWorkerBlit::executeBlit(Surface* src, Surface* dest, int x, int y, in
 				{
 					if (srcStuff)
 					{
-						ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
-						set(arg);
-						scriptExe(*this, _proc);
-						get(arg);
-						if (arg.getFirst()) destStuff = arg.getFirst();
+						int result = executePixel(srcStuff, destStuff);
+						if (result) destStuff = result;
 					}
 				},
 				destShader,
@@ -528,6 +553,54 @@ void ScriptWorkerBlit::executeBlit(Surface* src, Surface* dest, int x, int y, in
 	}
 }
 
+/**
+ * Recolor whole surface using script, result can be later blit
+ * in place of calling executeBlit with same arguments.
+ * @param src source surface.
+ * @param dest destination surface, same size as source.
+ * @return false if script need destination pixels or some color can't be represented.
+ */
+bool ScriptWorkerBlit::executeRecolor(Surface* src, Surface* dest)
+{
+	if (!_proc || !_sourceOnly)
+	{
+		return false;
+	}
+
+	ShaderMove<Uint8> srcShader(src, 0, 0);
+	ShaderMove<Uint8> destShader(dest, 0, 0);
+
+	int lookup[256];
+	bool lookupDone[256] = { };
+	bool valid = true;
+	ShaderDrawFunc(
+		[&](Uint8& destStuff, const Uint8& srcStuff)
+		{
+			if (srcStuff)
+			{
+				if (!lookupDone[srcStuff])
+				{
+					lookup[srcStuff] = executePixel(srcStuff, 0);
+					lookupDone[srcStuff] = true;
+				}
+				// color that wrap to zero would be transparent after blit
+				if (lookup[srcStuff] && (Uint8)lookup[srcStuff] == 0)
+				{
+					valid = false;
+				}
+				destStuff = lookup[srcStuff];
+			}
+			else
+			{
+				destStuff = 0;
+			}
+		},
+		destShader,
+		srcShader
+	);
+	return valid;
+}
+
 /**
  * Execute script with two arguments.
  * @return Result value from script.
@@ -2455,6 +2528,7 @@ const ScriptRefData* ScriptParserBase::getRef(ScriptRef prefix, ScriptRef postfi
  */
 bool ScriptParserBase::parseBase(ScriptContainerBase& destScript, const std::string& parentName, const std::string& srcCode) const
 {
+	Profiler::ScopedTimer timer("Script parsing: " + _name);
 	ScriptContainerBase tempScript;
 	std::string err = "Error in parsing script '" + _name + "' for '" + parentName + "': ";
 	ParserWriter help(
@@ -2606,6 +2680,13 @@ bool ScriptParserBase::parseBase(ScriptContainerBase& destScript, const std::str
 		while (i < ScriptMaxArg && args[i].getType() != TokenNone)
 		{
 			argData[i] = args[i].parse(help);
+			for (Uint8 j = 0; j < _regOutSize; ++j)
+			{
+				if (argData[i] && argData[i].name == _regOutName[j])
+				{
+					tempScript._regOutUsed |= 1 << j;
+				}
+			}
 			++i;
 		}
 
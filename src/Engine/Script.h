@@ -373,7 +373,9 @@ struct TypeInfo
 class ScriptContainerBase
 {
 	friend struct ParserWriter;
+	friend class ScriptParserBase;
 	std::vector<Uint8> _proc;
+	Uint16 _regOutUsed = 0;
 
 public:
 	/// Constructor.
@@ -402,6 +404,12 @@ public:
 	{
 		return *this ? _proc.data() : nullptr;
 	}
+
+	/// Test if script code refers to output reg.
+	bool isOutputUsed(Uint8 i) const
+	{
+		return (_regOutUsed >> i) & 1;
+	}
 };
 
 /**
@@ -449,6 +457,33 @@ public:
 	{
 		return _events;
 	}
+
+	/// Test if script or any of global events refers to output reg.
+	bool isOutputUsed(Uint8 i) const
+	{
+		if (_current.isOutputUsed(i))
+		{
+			return true;
+		}
+		auto ptr = _events;
+		if (ptr)
+		{
+			// events before and after script, each list ends with empty script
+			for (int list = 0; list < 2; ++list)
+			{
+				while (*ptr)
+				{
+					if (ptr->isOutputUsed(i))
+					{
+						return true;
+					}
+					++ptr;
+				}
+				++ptr;
+			}
+		}
+		return false;
+	}
 };
 
 /**
@@ -803,13 +838,18 @@ class ScriptWorkerBlit : public ScriptWorkerBase
 	/// Current script set in worker.
 	const Uint8* _proc;
 	const ScriptContainerBase* _events;
+	/// Script result depends only on source pixel, not on destination one.
+	bool _sourceOnly;
+
+	/// Calculate new color of one pixel.
+	int executePixel(Uint8 src, Uint8 dest);
 
 public:
 	/// Type of output value from script.
 	using Output = ScriptOutputArgs<int&, int>;
 
 	/// Default constructor.
-	ScriptWorkerBlit() : ScriptWorkerBase(), _proc(nullptr), _events(nullptr)
+	ScriptWorkerBlit() : ScriptWorkerBase(), _proc(nullptr), _events(nullptr), _sourceOnly(false)
 	{
 
 	}
@@ -824,6 +864,7 @@ public:
 		{
 			_proc = c.data();
 			_events = nullptr;
+			_sourceOnly = !c.isOutputUsed(1);
 			updateBase<Output>(args...);
 		}
 	}
@@ -838,6 +879,7 @@ public:
 		{
 			_proc = c.data();
 			_events = c.dataEvents();
+			_sourceOnly = !c.isOutputUsed(1);
 			updateBase<Output>(args...);
 		}
 	}
@@ -846,12 +888,20 @@ public:
 	void executeBlit(Surface* src, Surface* dest, int x, int y, int shade);
 	/// Programmable blitting using script.
 	void executeBlit(Surface* src, Surface* dest, int x, int y, int shade, GraphSubset mask);
+	/// Recolor whole surface using script, if result do not depend on destination.
+	bool executeRecolor(Surface* src, Surface* dest);
+	/// Test if executeRecolor can be used with current script.
+	bool canRecolor() const
+	{
+		return _proc && _sourceOnly;
+	}
 
 	/// Clear all worker data.
 	void clear()
 	{
 		_proc = nullptr;
 		_events = nullptr;
+		_sourceOnly = false;
 	}
 };
 
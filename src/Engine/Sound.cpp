@@ -17,6 +17,9 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Sound.h"
+#include <vector>
+#include <algorithm>
+#include "CatFile.h"
 #include "Exception.h"
 #include "Options.h"
 #include "Logger.h"
@@ -26,6 +29,191 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Decoded sounds in the cache, most recently played first.
+std::list<const Sound*> cache;
+/// Memory used by the decoded sounds in the cache.
+size_t cacheSize = 0;
+
+/**
+ * Reads a little-endian 32-bit value, the buffer doesn't need to be aligned.
+ */
+inline Uint32 readLE32(const Uint8 *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((Uint32)p[3] << 24);
+}
+
+/**
+ * Converts a 8Khz sample to 11Khz.
+ * @param oldsound Pointer to original sample buffer.
+ * @param oldsize Original buffer size.
+ * @param newsound Pointer to converted sample buffer.
+ * @return Converted buffer size.
+ */
+int convertSampleRate(const Uint8 *oldsound, size_t oldsize, Uint8 *newsound)
+{
+	const Uint32 step16 = (8000 << 16) / 11025;
+	int newsize = 0;
+	for (Uint32 offset16 = 0; (offset16 >> 16) < oldsize; offset16 += step16, ++newsound, ++newsize)
+	{
+		*newsound = oldsound[offset16 >> 16];
+	}
+	return newsize;
+}
+
+const Uint8 header[] = {  'R',  'I',  'F',  'F', 0x00, 0x00, 0x00, 0x00,  'W',  'A',  'V',  'E',
+						  'f',  'm',  't',  ' ', 0x10, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00,
+						 0x11, 0x2b, 0x00, 0x00, 0x11, 0x2b, 0x00, 0x00, 0x01, 0x00, 0x08, 0x00,
+						  'd',  'a',  't',  'a', 0x00, 0x00, 0x00, 0x00                           };
+/**
+ * Write out a WAV. Resample if needed.
+ * @param dest where to write
+ * @param sound sound data
+ * @param size  size of sound data
+ * @param resample if resampling is needed.
+ */
+void writeWAV(SDL_RWops *dest, const Uint8 *sound, size_t size, bool resample)
+{
+	SDL_RWwrite(dest, header, sizeof(header), 1);
+	int newsize = size;
+
+	if (resample) {
+		auto newsound = SDL_malloc(2*size);
+		newsize = convertSampleRate(sound, size, (Uint8 *)newsound);
+		SDL_RWwrite(dest, newsound, newsize, 1);
+		SDL_free(newsound);
+	} else {
+		SDL_RWwrite(dest, sound, size, 1);
+	}
+
+	// update the header
+	SDL_RWseek(dest, 4, RW_SEEK_SET);	// write WAVE chunk size
+	SDL_WriteLE32(dest, newsize + 36);
+	SDL_RWseek(dest, 40, RW_SEEK_SET); 	// write data subchunk size
+	SDL_WriteLE32(dest, newsize);
+}
+
+/**
+ * Decodes an entry of an X-Com sound CAT file. Each entry consists
+ * of a filename followed by a WAV, or by raw DOS samples.
+ * @param catFile CAT file.
+ * @param index Entry in the CAT file.
+ * @param tftd if to expect signed 8bit 11Khz instead of unsigned 6bit 8KHz in the data.
+ * @return Decoded sound, or NULL if it couldn't be decoded.
+ * @sa http://www.ufopaedia.org/index.php?title=SOUND
+ */
+Mix_Chunk *decodeCatItem(const CatFile &catFile, int index, bool tftd)
+{
+	size_t size;
+	const Uint8 *item = catFile.getData(index, size);
+	if (!item)
+	{
+		return 0;
+	}
+	// skip "name".
+	size_t namesize = size > 0 ? item[0] + 1 : 0;
+	const Uint8 *sound = item + std::min(namesize, size);
+	size -= std::min(namesize, size);
+	// NB: the original code after ce548c29d5742e26a442a44ef2a5fcce3f80dace
+	// did not adjust the size for the namesize byte when skipping the name
+	// and thus submitted one trailing byte of garbage.
+	// The original code before that commit did not adjust the size at all
+	// when skipping the name and thus submitted at least one trailing byte of garbage.
+	// v1.4 sounds do miss namesize+1 bytes as they are in the catfile -
+	// comparing what's in the WAV header to cat item size without name.
+	if (size < 12)
+	{
+		return 0;
+	}
+
+	// See if we've got RIFF header here.
+	bool wav = ((sound[0] == 'R') && (sound[1] == 'I') && (sound[2]  == 'F') && (sound[3]  == 'F')
+			 && (sound[8] == 'W') && (sound[9] == 'A') && (sound[10] == 'V') && (sound[11] == 'E'));
+
+	// the cat data is read in place, so only converted samples get their own buffer
+	std::vector<Uint8> converted;
+	const Uint8 *samples;
+	size_t samplecount;
+	bool do_resample = true;
+	int delta = 0;
+	if (wav) { // skip WAV header
+		int expected_size = (Sint32)readLE32(sound + 0x04) + 8;
+		delta = ((int)size) - expected_size;
+		int samplerate = (Sint32)readLE32(sound + 0x18);
+		do_resample  = (samplerate < 11025);
+		samples = sound + 44;
+		samplecount = size - 44;
+	} else { // skip DOS header
+		// UFO2000 style
+		samples = sound + 6;
+		samplecount = size - 6;
+
+		// OpenXcom style
+		samples = sound + 5;
+		samplecount = size - 6;
+
+		// scale to 8 bits (UFO) or get rid of signedness (TFTD)
+		converted.resize(samplecount);
+		for (size_t n = 0; n < samplecount; ++n) {
+			int sample = samples[n];
+			converted[n] = (Uint8) (tftd ? sample + 128 : sample * 4);
+		}
+		samples = converted.data();
+	}
+	size_t dest_size = 44 + 2 * size; // worst-case estimation
+	auto dest_mem = SDL_malloc(dest_size);
+	auto dest_rwops = SDL_RWFromMem(dest_mem, dest_size);
+
+	if (do_resample) {
+		writeWAV(dest_rwops, samples, samplecount, !tftd);
+	} else { // nothing to do.
+		SDL_RWwrite(dest_rwops, sound, size, 1);
+		// fix the header if we miss some data.
+		if (delta < 0) {
+			SDL_RWseek(dest_rwops, 0x04, RW_SEEK_SET); // WAVE chunk size
+			SDL_WriteLE32(dest_rwops, readLE32(sound + 0x04) + delta);
+			SDL_RWseek(dest_rwops, 0x28, RW_SEEK_SET); // data chunk size
+			SDL_WriteLE32(dest_rwops, readLE32(sound + 0x28) + delta);
+		}
+	}
+	SDL_RWseek(dest_rwops, 0, RW_SEEK_SET);
+	Mix_Chunk *chunk = Mix_LoadWAV_RW(dest_rwops, SDL_TRUE);  // this frees the dest_rwops
+	SDL_free(dest_mem);
+	return chunk;
+}
+
+/**
+ * Checks if a sound is on any of the mixer channels,
+ * freeing it would cut it off.
+ * @param chunk Decoded sound.
+ * @return True if it's playing.
+ */
+bool isPlaying(const Mix_Chunk *chunk)
+{
+	int channels = Mix_AllocateChannels(-1);
+	for (int i = 0; i < channels; ++i)
+	{
+		if (Mix_Playing(i) && Mix_GetChunk(i) == chunk)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Gets the memory budget of the sound cache.
+ * @return Size in bytes.
+ */
+size_t getCacheBudget()
+{
+	return (size_t)std::max(0, Options::oxceSoundCacheSize) * 1024;
+}
+
+}
+
 /**
  * Deletes the loaded sound content.
  */
@@ -39,6 +227,85 @@ Sound::UniqueSoundPtr Sound::NewSound(Mix_Chunk* sound)
 	return Sound::UniqueSoundPtr(sound);
 }
 
+/**
+ * Initializes a new blank sound effect.
+ */
+Sound::Sound() : _catIndex(-1), _tftd(false), _cached(false), _failed(false)
+{
+}
+
+/**
+ * Deletes the decoded sound and removes it from the cache.
+ */
+Sound::~Sound()
+{
+	unload();
+}
+
+/**
+ * Moves a sound, keeping its place in the cache.
+ * @param other Sound to move from.
+ */
+Sound::Sound(Sound&& other) : Sound()
+{
+	*this = std::move(other);
+}
+
+/**
+ * Replaces this sound with another one, keeping its place in the cache.
+ * @param other Sound to move from.
+ * @return This sound.
+ */
+Sound& Sound::operator=(Sound&& other)
+{
+	if (this != &other)
+	{
+		unload();
+		_cat = std::move(other._cat);
+		_filename = std::move(other._filename);
+		_catIndex = other._catIndex;
+		_tftd = other._tftd;
+		_sound = std::move(other._sound);
+		_failed = other._failed;
+		_cached = other._cached;
+		if (_cached)
+		{
+			_cacheEntry = other._cacheEntry;
+			*_cacheEntry = this;
+			other._cached = false;
+		}
+		other.clear();
+	}
+	return *this;
+}
+
+/**
+ * Frees the decoded sound, and removes it from the cache
+ * if it was decoded on demand.
+ */
+void Sound::unload() const
+{
+	if (_cached)
+	{
+		cacheSize -= _sound->alen;
+		cache.erase(_cacheEntry);
+		_cached = false;
+	}
+	_sound.reset();
+}
+
+/**
+ * Frees the sound and forgets where it came from.
+ */
+void Sound::clear()
+{
+	unload();
+	_cat.reset();
+	_filename.clear();
+	_catIndex = -1;
+	_failed = false;
+}
+
 /**
  * Loads a sound file from a specified filename.
  * @param filename Filename of the sound file.
@@ -52,6 +319,7 @@ void Sound::load(const std::string &filename) {
 	}
 
 	//always overwrite
+	clear();
 	_sound = std::move(s);
 }
 
@@ -67,18 +335,148 @@ void Sound::load(SDL_RWops *rw) {
 	}
 
 	//always overwrite
+	clear();
 	_sound = std::move(s);
 }
 
+/**
+ * Sets the sound file to decode when the sound is first played.
+ * A file that can't be decoded is logged then, and stays silent.
+ * @param filename Filename of the sound file.
+ */
+void Sound::setFile(const std::string &filename)
+{
+	if (!FileMap::fileExists(filename))
+	{
+		std::string fail = "Sound::setFile(" + filename + "): requested file not found.";
+		Log(LOG_FATAL) << fail;
+		throw Exception(fail);
+	}
+	clear();
+	_filename = filename;
+}
+
+/**
+ * Sets the CAT entry to decode when the sound is first played.
+ * The CAT file is kept open as long as its sounds need it.
+ * @param cat CAT file.
+ * @param index Entry in the CAT file.
+ * @param tftd if the entry has TFTD samples.
+ */
+void Sound::setCatItem(const std::shared_ptr<const CatFile> &cat, int index, bool tftd)
+{
+	clear();
+	_cat = cat;
+	_catIndex = index;
+	_tftd = tftd;
+}
+
+/**
+ * Gets the decoded sound, decoding it first if needed. Decoded
+ * sounds go to the front of the cache, so sounds that were just
+ * preloaded aren't the first ones freed. Played sounds also free
+ * the least recently played ones that aren't playing anymore to
+ * stay in budget, preloading doesn't free anything.
+ * @param preload Is the sound decoded ahead of time?
+ * @return Decoded sound, or NULL if there's none.
+ */
+Mix_Chunk *Sound::decode(bool preload) const
+{
+	if (_sound)
+	{
+		if (_cached && !preload)
+		{
+			cache.splice(cache.begin(), cache, _cacheEntry);
+		}
+		return _sound.get();
+	}
+	if (_failed || (!_cat && _filename.empty()))
+	{
+		return 0;
+	}
+
+	Mix_Chunk *chunk = 0;
+	if (_cat)
+	{
+		chunk = decodeCatItem(*_cat, _catIndex, _tftd);
+		if (!chunk)
+		{
+			Log(LOG_ERROR) << "Sound::decode(" << _cat->fileName() << ", " << _catIndex << "): mix error=" << Mix_GetError();
+		}
+	}
+	else
+	{
+		chunk = Mix_LoadWAV_RW(FileMap::getRWops(_filename), SDL_TRUE);
+		if (!chunk)
+		{
+			Log(LOG_ERROR) << "Sound::decode(" << _filename << "): mix error=" << Mix_GetError();
+		}
+	}
+	if (!chunk)
+	{
+		_failed = true;
+		return 0;
+	}
+
+	if (!preload)
+	{
+		size_t budget = getCacheBudget();
+		for (auto i = cache.end(); i != cache.begin() && cacheSize + chunk->alen > budget;)
+		{
+			--i;
+			const Sound *old = *i;
+			if (!isPlaying(old->_sound.get()))
+			{
+				// keep the iterator on the entry after it, so it stays valid
+				++i;
+				old->unload();
+			}
+		}
+	}
+	_sound = NewSound(chunk);
+	_cached = true;
+	cacheSize += chunk->alen;
+	_cacheEntry = cache.insert(cache.begin(), this);
+	return chunk;
+}
+
+/**
+ * Decodes the sound ahead of time, so it doesn't have
+ * to be decoded when it's first played.
+ * @return False if the cache is full.
+ */
+bool Sound::preload() const
+{
+	if (cacheSize >= getCacheBudget())
+	{
+		return false;
+	}
+	decode(true);
+	return true;
+}
+
+/**
+ * Frees the decoded sound, if it was decoded on demand
+ * and isn't playing, so it's decoded again when needed.
+ */
+void Sound::release() const
+{
+	if (_cached && !isPlaying(_sound.get()))
+	{
+		unload();
+	}
+}
+
 /**
  * Plays the contained sound effect.
  * @param channel Use specified channel, -1 to use any channel
  */
 void Sound::play(int channel, int angle, int distance) const
  {
-	if (!Options::mute && _sound)
+	Mix_Chunk *sound = Options::mute ? 0 : decode(false);
+	if (sound)
  	{
-		int chan = Mix_PlayChannel(channel, _sound.get(), 0);
+		int chan = Mix_PlayChannel(channel, sound, 0);
 		if (chan == -1)
 		{
 			Log(LOG_WARNING) << Mix_GetError();
@@ -109,9 +507,10 @@ void Sound::stop()
  */
 void Sound::loop()
 {
-	if (!Options::mute && _sound && Mix_Playing(3) == 0)
+	Mix_Chunk *sound = (Options::mute || Mix_Playing(3) != 0) ? 0 : decode(false);
+	if (sound)
 	{
-		int chan = Mix_PlayChannel(3, _sound.get(), -1);
+		int chan = Mix_PlayChannel(3, sound, -1);
 		if (chan == -1)
 		{
 			Log(LOG_WARNING) << Mix_GetError();
@@ -130,4 +529,13 @@ void Sound::stopLoop()
 	}
 }
 
+/**
+ * Gets the memory used by the decoded samples.
+ * @return Size in bytes.
+ */
+size_t Sound::getMemorySize() const
+{
+	return _sound ? _sound->alen : 0;
+}
+
 }
@@ -21,13 +21,20 @@
 #include <SDL_mixer.h>
 #include <string>
 #include <memory>
+#include <list>
 
 namespace OpenXcom
 {
 
+class CatFile;
+
 /**
  * Container for sound effects.
  * Handles loading and playing various formats through SDL_mixer.
+ * Sounds from game files are only registered by reference and
+ * decoded the first time they're played, then kept in a cache
+ * shared by all sounds that drops the least recently played ones
+ * when it goes over the oxceSoundCacheSize budget.
  */
 class Sound
 {
@@ -43,22 +50,43 @@ public:
 	static UniqueSoundPtr NewSound(Mix_Chunk* sound);
 
 private:
-	UniqueSoundPtr _sound;
+	std::shared_ptr<const CatFile> _cat;
+	std::string _filename;
+	int _catIndex;
+	bool _tftd;
+	mutable UniqueSoundPtr _sound;
+	mutable bool _cached, _failed;
+	mutable std::list<const Sound*>::iterator _cacheEntry;
+
+	/// Decodes the sound, if needed.
+	Mix_Chunk *decode(bool preload) const;
+	/// Frees the sound and forgets where it came from.
+	void clear();
+	/// Frees the decoded sound.
+	void unload() const;
 
 public:
 	/// Creates a blank sound effect.
-	Sound() = default;
+	Sound();
 	/// Cleans up the sound effect.
-	~Sound() = default;
+	~Sound();
 	/// Move sound to another place.
-	Sound(Sound&& other) = default;
+	Sound(Sound&& other);
 	/// Move assignment
-	Sound& operator=(Sound&& other) = default;
+	Sound& operator=(Sound&& other);
 
 	/// Loads sound from the specified file.
 	void load(const std::string &filename);
 	/// Loads sound from SDL_RWops
 	void load(SDL_RWops *rw);
+	/// Sets the file to decode the sound from when needed.
+	void setFile(const std::string &filename);
+	/// Sets the CAT entry to decode the sound from when needed.
+	void setCatItem(const std::shared_ptr<const CatFile> &cat, int index, bool tftd);
+	/// Decodes the sound ahead of time, if the cache has room.
+	bool preload() const;
+	/// Frees the decoded sound until it's played again.
+	void release() const;
 	/// Plays the sound.
 	void play(int channel = -1, int angle = 0, int distance = 0) const;
 	/// Stops all sounds.
@@ -67,6 +95,8 @@ public:
 	void loop();
 	/// Stops the looping sound effect.
 	void stopLoop();
+	/// Gets the memory used by the decoded sound.
+	size_t getMemorySize() const;
 };
 
 }
@@ -19,6 +19,7 @@
  */
 #include <SDL_mixer.h>
 #include <map>
+#include <memory>
 
 namespace OpenXcom
 {
@@ -37,16 +38,13 @@ private:
 	std::map<int, Sound> _sounds;
 	int _sharedSounds;
 
-	int convertSampleRate(Uint8 *oldsound, size_t oldsize, Uint8 *newsound) const;
-	void writeWAV(SDL_RWops *dest, Uint8 *sound, size_t size, bool resample) const;
-
 public:
 	/// Crates a sound set.
 	SoundSet();
 	/// Cleans up the sound set.
 	~SoundSet() = default;
 	/// Loads an X-Com CAT set of sound files.
-	void loadCat(CatFile& sndFile);
+	void loadCat(const std::shared_ptr<CatFile> &sndFile);
 	/// Gets a particular sound from the set.
 	Sound *getSound(int i);
 	/// Creates a new sound and returns a pointer to it.
@@ -59,8 +57,12 @@ public:
 
 	/// Gets the total sounds in the set.
 	size_t getTotalSounds() const;
+	/// Gets the memory used by the sounds.
+	size_t getMemorySize() const;
+	/// Frees the decoded sounds until they're played again.
+	void releaseSounds() const;
 	/// Loads a specific entry from a CAT file into the soundset.
-	void loadCatByIndex(CatFile &sndFile, int index, bool tftd = false);
+	void loadCatByIndex(const std::shared_ptr<CatFile> &sndFile, int index, bool tftd = false);
 };
 
 }
@@ -105,8 +105,201 @@ inline void FixTransparent(const Surface::UniqueSurfacePtr& dest, int currentTra
 	}
 }
 
+/// Most surfaces damaged while the screen is drawn before they are blitted.
+const size_t MAX_LATE_DAMAGE = 256;
+
+/// Screen the damage is tracked for.
+SDL_Surface *damageTarget = nullptr;
+/// Area of the screen to redraw next frame.
+SDL_Rect damageArea = { };
+/// Area of the screen being redrawn.
+SDL_Rect damageClip = { };
+/// Is the screen being drawn?
+bool damageDrawing = false;
+/// Surfaces damaged while the screen is drawn, with their screen areas.
+std::pair<const Surface*, SDL_Rect> lateDamage[MAX_LATE_DAMAGE];
+size_t lateDamageCount = 0;
+
+/**
+ * Checks if a rectangle has no area.
+ * @param rect Rectangle.
+ * @return True if empty.
+ */
+inline bool IsEmptyRect(const SDL_Rect &rect)
+{
+	return rect.w == 0 || rect.h == 0;
+}
+
+/**
+ * Grows a rectangle to cover another one too.
+ * @param dest Rectangle to grow.
+ * @param src Rectangle to cover.
+ */
+inline void UniteRect(SDL_Rect &dest, const SDL_Rect &src)
+{
+	if (IsEmptyRect(src))
+	{
+		return;
+	}
+	if (IsEmptyRect(dest))
+	{
+		dest = src;
+		return;
+	}
+	int x1 = std::min(dest.x, src.x);
+	int y1 = std::min(dest.y, src.y);
+	int x2 = std::max(dest.x + dest.w, src.x + src.w);
+	int y2 = std::max(dest.y + dest.h, src.y + src.h);
+	dest.x = x1;
+	dest.y = y1;
+	dest.w = x2 - x1;
+	dest.h = y2 - y1;
+}
+
+/**
+ * Checks if a rectangle lies inside another one.
+ * @param inner Rectangle to check.
+ * @param outer Containing rectangle.
+ * @return True if inside.
+ */
+inline bool IsInsideRect(const SDL_Rect &inner, const SDL_Rect &outer)
+{
+	return inner.x >= outer.x && inner.y >= outer.y &&
+		inner.x + inner.w <= outer.x + outer.w &&
+		inner.y + inner.h <= outer.y + outer.h;
+}
+
 } //namespace
 
+Uint32 Surface::_currentDamagePhase = 1;
+
+/**
+ * Starts drawing the screen, limited to the area damaged
+ * since it was last drawn: the clipping rectangle of the
+ * screen is set to it, so blits don't touch anything else.
+ * @param screen Screen buffer the surfaces are blitted onto.
+ * @param full Redraw the whole screen.
+ * @param area Returns the area to redraw.
+ * @return False if nothing needs to be redrawn.
+ */
+bool Surface::beginDamage(SDL_Surface *screen, bool full, SDL_Rect *area)
+{
+	SDL_Rect whole = { 0, 0, (Uint16)screen->w, (Uint16)screen->h };
+	if (full || screen != damageTarget)
+	{
+		damageArea = whole;
+	}
+	damageTarget = screen;
+	// clip to the screen
+	int x1 = std::max<int>(damageArea.x, 0);
+	int y1 = std::max<int>(damageArea.y, 0);
+	int x2 = std::min<int>(damageArea.x + damageArea.w, whole.w);
+	int y2 = std::min<int>(damageArea.y + damageArea.h, whole.h);
+	if (IsEmptyRect(damageArea) || x1 >= x2 || y1 >= y2)
+	{
+		damageArea = SDL_Rect{ };
+		return false;
+	}
+	damageClip.x = x1;
+	damageClip.y = y1;
+	damageClip.w = x2 - x1;
+	damageClip.h = y2 - y1;
+	damageArea = SDL_Rect{ };
+	damageDrawing = true;
+	_currentDamagePhase++;
+	SDL_SetClipRect(screen, &damageClip);
+	*area = damageClip;
+	return true;
+}
+
+/**
+ * Finishes drawing the screen. Surfaces damaged while it was
+ * drawn and not blitted afterwards, or blitted partly outside
+ * the redrawn area, are redrawn next frame.
+ */
+void Surface::endDamage()
+{
+	for (size_t i = 0; i < lateDamageCount; ++i)
+	{
+		UniteRect(damageArea, lateDamage[i].second);
+	}
+	lateDamageCount = 0;
+	damageDrawing = false;
+	_currentDamagePhase++;
+	SDL_SetClipRect(damageTarget, 0);
+}
+
+/**
+ * Adds the area the surface was last blitted to on the screen,
+ * and the one it covers now, to the area to redraw. Damage done
+ * while the screen is drawn is kept aside, as the surface may
+ * still be blitted in the same frame.
+ */
+void Surface::addDamage()
+{
+	_damagePhase = _currentDamagePhase;
+	if (IsEmptyRect(_lastBlit))
+	{
+		// not on screen, anything blitting it will find it's new
+		return;
+	}
+	SDL_Rect area = _lastBlit;
+	SDL_Rect current = { _x, _y, _width, _height };
+	UniteRect(area, current);
+	if (damageDrawing && lateDamageCount < MAX_LATE_DAMAGE)
+	{
+		lateDamage[lateDamageCount++] = std::make_pair(this, area);
+	}
+	else
+	{
+		UniteRect(damageArea, area);
+	}
+}
+
+/**
+ * Called when the surface is blitted. If that's onto the screen,
+ * a surface that is new there or moved, or was damaged while the
+ * screen was drawn, is presented now if it lies inside the redrawn
+ * area, otherwise its area is redrawn next frame.
+ * @param surface Pointer to surface blitted onto.
+ */
+void Surface::blitDamage(SDL_Surface *surface)
+{
+	if (surface != damageTarget || !damageDrawing)
+	{
+		return;
+	}
+	SDL_Rect target = { _x, _y, _width, _height };
+	bool moved = target.x != _lastBlit.x || target.y != _lastBlit.y || target.w != _lastBlit.w || target.h != _lastBlit.h;
+	bool late = damageDrawing && _damagePhase == _currentDamagePhase;
+	if (late)
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < lateDamageCount; ++i)
+		{
+			if (lateDamage[i].first != this)
+			{
+				lateDamage[kept++] = lateDamage[i];
+			}
+		}
+		lateDamageCount = kept;
+		// further changes in this frame have to be registered again
+		_damagePhase = 0;
+	}
+	if (moved || late)
+	{
+		if (!IsInsideRect(target, damageClip))
+		{
+			UniteRect(damageArea, target);
+		}
+		if (moved && !IsInsideRect(_lastBlit, damageClip))
+		{
+			UniteRect(damageArea, _lastBlit);
+		}
+		_lastBlit = target;
+	}
+}
+
 /**
  * Helper function creating aligned buffer
  * @param bpp bits per pixel
@@ -231,7 +424,7 @@ void Surface::UniqueSurfaceDeleter::operator ()(SDL_Surface* surf)
 /**
  * Default empty surface.
  */
-Surface::Surface() : _x{ }, _y{ }, _width{ }, _height{ }, _pitch{ }, _visible(true), _hidden(false), _redraw(false)
+Surface::Surface() : _x{ }, _y{ }, _width{ }, _height{ }, _pitch{ }, _visible(true), _hidden(false), _redraw(false), _lastBlit{ }, _damagePhase(0)
 {
 
 }
@@ -248,7 +441,7 @@ Surface::Surface() : _x{ }, _y{ }, _width{ }, _height{ }, _pitch{ }, _visible(tr
  * @param y Y position in pixels.
  * @param bpp Bits-per-pixel depth.
  */
-Surface::Surface(int width, int height, int x, int y) : _x(x), _y(y), _visible(true), _hidden(false), _redraw(false)
+Surface::Surface(int width, int height, int x, int y) : _x(x), _y(y), _visible(true), _hidden(false), _redraw(false), _lastBlit{ }, _damagePhase(0)
 {
 	std::tie(_alignedBuffer, _surface) = Surface::NewPair8Bit(width, height);
 	_width = _surface->w;
@@ -287,7 +480,8 @@ Surface::Surface(const Surface& other) : Surface{ }
  */
 Surface::~Surface()
 {
-
+	// whatever is under it has to be redrawn
+	addDamage();
 }
 
 /**
@@ -367,25 +561,20 @@ void Surface::loadImage(const std::string &filename)
 	_surface = nullptr;
 
 	Log(LOG_VERBOSE) << "Loading image: " << filename;
-	auto rw = FileMap::getRWops(filename);
-	if (!rw) { return; } // relevant message gets logged in FileMap.
+	// the whole file in one buffer (memory-mapped when possible), decoded in place
+	auto file = FileMap::getData(filename);
 
 	// Try loading with LodePNG first
 	if (CrossPlatform::compareExt(filename, "png"))
 	{
-		size_t size;
-		void *data = SDL_LoadFile_RW(rw, &size, SDL_FALSE);
-		if ((data != NULL) && (size > 8 + 12 + 12)) // minimal PNG file size: header and two empty chunks
+		size_t size = file->size();
+		if (size > 8 + 12 + 12) // minimal PNG file size: header and two empty chunks
 		{
-			std::vector<unsigned char> png;
-			png.resize(size);
-			memcpy(&png[0], data, size);
-
 			std::vector<unsigned char> image;
 			unsigned width, height;
 			lodepng::State state;
 			state.decoder.color_convert = 0;
-			unsigned error = lodepng::decode(image, width, height, state, png);
+			unsigned error = lodepng::decode(image, width, height, state, (const unsigned char *)file->data(), size);
 			if (!error)
 			{
 				LodePNGColorMode *color = &state.info_png.color;
@@ -423,16 +612,10 @@ void Surface::loadImage(const std::string &filename)
 				Log(LOG_ERROR) << "Image " << filename << " lodepng failed:" << lodepng_error_text(error);
 			}
 		}
-		if (data) { SDL_free(data); }
-	}
-	if (_surface)
-	{
-		SDL_RWclose(rw);
 	}
-	else // Otherwise default to SDL_Image
+	if (!_surface) // Otherwise default to SDL_Image
 	{
-		SDL_RWseek(rw, RW_SEEK_SET, 0); // rewind in case .png was no PNG at all
-		auto surface = NewSdlSurface(IMG_Load_RW(rw, SDL_TRUE));
+		auto surface = NewSdlSurface(IMG_Load_RW(file->getRWops(), SDL_TRUE));
 		if (!surface)
 		{
 			std::string err = filename + ":" + IMG_GetError();
@@ -540,6 +723,7 @@ void Surface::loadBdy(const std::string &filename)
  */
 void Surface::clear()
 {
+	damage();
 	CleanSdlSurface(_surface.get());
 }
 
@@ -712,6 +896,7 @@ void Surface::blit(SDL_Surface *surface)
 		SDL_Rect target {};
 		target.x = getX();
 		target.y = getY();
+		blitDamage(surface);
 		SDL_BlitSurface(_surface.get(), nullptr, surface, &target);
 	}
 }
@@ -749,7 +934,7 @@ void Surface::copy(Surface *surface)
 			dest = src;
 		},
 		ShaderMove<Uint8>(_surface.get(), from_x, from_y),
-		ShaderMove<Uint8>(surface, 0, 0)
+		ShaderMove<const Uint8>(static_cast<const Surface*>(surface), 0, 0)
 	);
 
 	unlock();
@@ -762,6 +947,7 @@ void Surface::copy(Surface *surface)
  */
 void Surface::drawRect(SDL_Rect *rect, Uint8 color)
 {
+	damage();
 	SDL_FillRect(_surface.get(), rect, color);
 }
 
@@ -780,6 +966,7 @@ void Surface::drawRect(Sint16 x, Sint16 y, Sint16 w, Sint16 h, Uint8 color)
 	rect.h = h;
 	rect.x = x;
 	rect.y = y;
+	damage();
 	SDL_FillRect(_surface.get(), &rect, color);
 }
 
@@ -793,6 +980,7 @@ void Surface::drawRect(Sint16 x, Sint16 y, Sint16 w, Sint16 h, Uint8 color)
  */
 void Surface::drawLine(Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint8 color)
 {
+	damage();
 	lineColor(_surface.get(), x1, y1, x2, y2, Palette::getRGBA(getPalette(), color));
 }
 
@@ -805,6 +993,7 @@ void Surface::drawLine(Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint8 color)
  */
 void Surface::drawCircle(Sint16 x, Sint16 y, Sint16 r, Uint8 color)
 {
+	damage();
 	filledCircleColor(_surface.get(), x, y, r, Palette::getRGBA(getPalette(), color));
 }
 
@@ -817,6 +1006,7 @@ void Surface::drawCircle(Sint16 x, Sint16 y, Sint16 r, Uint8 color)
  */
 void Surface::drawPolygon(Sint16 *x, Sint16 *y, int n, Uint8 color)
 {
+	damage();
 	filledPolygonColor(_surface.get(), x, y, n, Palette::getRGBA(getPalette(), color));
 }
 
@@ -831,7 +1021,8 @@ void Surface::drawPolygon(Sint16 *x, Sint16 *y, int n, Uint8 color)
  */
 void Surface::drawTexturedPolygon(Sint16 *x, Sint16 *y, int n, Surface *texture, int dx, int dy)
 {
-	texturedPolygon(_surface.get(), x, y, n, texture->getSurface(), dx, dy);
+	damage();
+	texturedPolygon(_surface.get(), x, y, n, texture->_surface.get(), dx, dy);
 }
 
 /**
@@ -843,6 +1034,7 @@ void Surface::drawTexturedPolygon(Sint16 *x, Sint16 *y, int n, Surface *texture,
  */
 void Surface::drawString(Sint16 x, Sint16 y, const char *s, Uint8 color)
 {
+	damage();
 	stringColor(_surface.get(), x, y, s, Palette::getRGBA(getPalette(), color));
 }
 
@@ -852,7 +1044,11 @@ void Surface::drawString(Sint16 x, Sint16 y, const char *s, Uint8 color)
  */
 void Surface::setX(int x)
 {
-	_x = x;
+	if (_x != x)
+	{
+		_x = x;
+		addDamage();
+	}
 }
 
 /**
@@ -861,7 +1057,11 @@ void Surface::setX(int x)
  */
 void Surface::setY(int y)
 {
-	_y = y;
+	if (_y != y)
+	{
+		_y = y;
+		addDamage();
+	}
 }
 
 /**
@@ -871,7 +1071,11 @@ void Surface::setY(int y)
  */
 void Surface::setVisible(bool visible)
 {
-	_visible = visible;
+	if (_visible != visible)
+	{
+		_visible = visible;
+		addDamage();
+	}
 }
 
 /**
@@ -900,6 +1104,7 @@ SurfaceCrop Surface::getCrop() const
  */
 void Surface::setPalette(const SDL_Color *colors, int firstcolor, int ncolors)
 {
+	damage();
 	if (_surface->format->BitsPerPixel == 8)
 		SDL_SetColors(_surface.get(), const_cast<SDL_Color *>(colors), firstcolor, ncolors);
 }
@@ -913,7 +1118,11 @@ void Surface::setPalette(const SDL_Color *colors, int firstcolor, int ncolors)
  */
 void Surface::setHidden(bool hidden)
 {
-	_hidden = hidden;
+	if (_hidden != hidden)
+	{
+		_hidden = hidden;
+		addDamage();
+	}
 }
 
 /**
@@ -924,6 +1133,7 @@ void Surface::setHidden(bool hidden)
  */
 void Surface::lock()
 {
+	damage();
 	SDL_LockSurface(_surface.get());
 }
 
@@ -1002,6 +1212,10 @@ void Surface::blitNShade(SurfaceRaw<Uint8> surface, int x, int y, int shade, Gra
 void Surface::invalidate(bool valid)
 {
 	_redraw = valid;
+	if (valid)
+	{
+		damage();
+	}
 }
 
 /**
@@ -1030,6 +1244,7 @@ void Surface::resize(int width, int height)
 	_width = _surface->w;
 	_height = _surface->h;
 	_pitch = _surface->pitch;
+	addDamage();
 }
 
 /**
@@ -1041,7 +1256,7 @@ void Surface::resize(int width, int height)
 void Surface::setWidth(int width)
 {
 	resize(width, getHeight());
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -1053,7 +1268,7 @@ void Surface::setWidth(int width)
 void Surface::setHeight(int height)
 {
 	resize(getWidth(), height);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -80,6 +80,10 @@ public:
 
 	/// Zero whole surface.
 	static void CleanSdlSurface(SDL_Surface* surface);
+	/// Starts drawing the damaged area of the screen.
+	static bool beginDamage(SDL_Surface *screen, bool full, SDL_Rect *area);
+	/// Finishes drawing the screen, keeping the damage left outside the drawn area.
+	static void endDamage();
 
 protected:
 	UniqueBufferPtr _alignedBuffer;
@@ -89,7 +93,23 @@ protected:
 	Uint8 _visible: 1;
 	Uint8 _hidden: 1;
 	Uint8 _redraw: 1;
+	SDL_Rect _lastBlit;
+	Uint32 _damagePhase;
 
+	/// Damage phase the screen is in, advanced when its drawing begins or ends.
+	static Uint32 _currentDamagePhase;
+	/// Adds the screen area covered by the surface to the damage.
+	void addDamage();
+	/// Marks the contents of the surface as changed.
+	void damage()
+	{
+		if (_damagePhase != _currentDamagePhase)
+		{
+			addDamage();
+		}
+	}
+	/// Records the surface being put on the screen.
+	void blitDamage(SDL_Surface *surface);
 	/// Copies raw pixels.
 	template <typename T>
 	void rawCopy(const std::vector<T> &bytes);
@@ -262,6 +282,7 @@ public:
 	 */
 	Uint8 *getRaw(int x, int y)
 	{
+		damage();
 		return (Uint8 *)_surface->pixels + (y * _surface->pitch + x * _surface->format->BytesPerPixel);
 	}
 	/**
@@ -270,6 +291,7 @@ public:
 	 */
 	SDL_Surface *getSurface()
 	{
+		damage();
 		return _surface.get();
 	}
 	/**
@@ -300,6 +322,7 @@ public:
 	/// Get pointer to buffer
 	Uint8* getBuffer()
 	{
+		damage();
 		return _alignedBuffer.get();
 	}
 	/// Get pointer to buffer
@@ -374,7 +397,10 @@ public:
 	{
 		if (surf)
 		{
-			*this = SurfaceRaw{ surf->getBuffer(), surf->getWidth(), surf->getHeight(), surf->getPitch() };
+			// only a writable view changes the surface
+			const Surface* constSurf = surf;
+			Pixel* buffer = std::is_const<Pixel>::value ? (Pixel*)constSurf->getBuffer() : (Pixel*)surf->getBuffer();
+			*this = SurfaceRaw{ buffer, surf->getWidth(), surf->getHeight(), surf->getPitch() };
 		}
 	}
 
@@ -287,6 +287,20 @@ size_t SurfaceSet::getTotalFrames() const
 	return _frames.size();
 }
 
+/**
+ * Gets the memory used by the pixels of all the frames in the set.
+ * @return Size in bytes.
+ */
+size_t SurfaceSet::getMemorySize() const
+{
+	size_t size = 0;
+	for (const auto &frame : _frames)
+	{
+		size += (size_t)frame.getPitch() * frame.getHeight();
+	}
+	return size;
+}
+
 /**
  * Replaces a certain amount of colors in all of the frames.
  * @param colors Pointer to the set of colors.
@@ -67,6 +67,8 @@ public:
 
 	/// Gets the total frames in the set.
 	size_t getTotalFrames() const;
+	/// Gets the memory used by the frames.
+	size_t getMemorySize() const;
 	/// Sets the surface set's palette.
 	void setPalette(const SDL_Color *colors, int firstcolor = 0, int ncolors = 256);
 };
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Timer.h"
+#include <algorithm>
 #include "Game.h"
 #include "Options.h"
 
@@ -41,6 +42,7 @@ Uint32 slowTick()
 
 Uint32 Timer::gameSlowSpeed = 1;
 int Timer::maxFrameSkip = 8; // this is a pretty good default at 60FPS.
+Sint64 Timer::_deadline = -1;
 
 
 /**
@@ -135,6 +137,15 @@ void Timer::think(State* state, Surface* surface)
 			if (_start > _frameSkipStart) _frameSkipStart = _start; // don't play animations in ffwd to catch up :P
 		}
 	}
+
+	if (_running)
+	{
+		Sint64 next = (Sint64)_frameSkipStart + _interval;
+		if (_deadline < 0 || next < _deadline)
+		{
+			_deadline = next;
+		}
+	}
 }
 
 /**
@@ -164,4 +175,33 @@ void Timer::onTimer(SurfaceHandler handler)
 	_surface = handler;
 }
 
+/**
+ * Forgets the deadlines noted by the running timers,
+ * before a new round of think() calls.
+ */
+void Timer::resetDeadline()
+{
+	_deadline = -1;
+}
+
+/**
+ * Returns the real time left until the earliest running timer
+ * that was advanced since the last reset wants to be called again,
+ * so the main loop knows how long it can sleep.
+ * @return Time in milliseconds, or -1 if no timer is waiting.
+ */
+int Timer::getTimeUntilDeadline()
+{
+	if (_deadline < 0)
+	{
+		return -1;
+	}
+	Sint64 left = _deadline - (Sint64)slowTick();
+	if (left <= 0)
+	{
+		return 0;
+	}
+	return (int)std::min<Sint64>(left * gameSlowSpeed, 1000);
+}
+
 }
@@ -39,6 +39,7 @@ public:
 	static Uint32 gameSlowSpeed;
 
 private:
+	static Sint64 _deadline;
 	Uint32 _start;
 	Uint32 _frameSkipStart;
 	int _interval;
@@ -67,6 +68,10 @@ public:
 	void onTimer(StateHandler handler);
 	/// Hooks a surface action handler to the timer interval.
 	void onTimer(SurfaceHandler handler);
+	/// Forgets the deadlines noted by the timers so far.
+	static void resetDeadline();
+	/// Gets the time until the earliest noted deadline.
+	static int getTimeUntilDeadline();
 };
 
 }
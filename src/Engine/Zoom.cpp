@@ -18,11 +18,18 @@
  */
 
 #include "Zoom.h"
+#include <vector>
+#include <cstring>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <functional>
 
 #include "Surface.h"
 #include "Logger.h"
 #include "Options.h"
 #include "Screen.h"
+#include "ScalerThreads.h"
 
 #include "OpenGL.h"
 
@@ -647,6 +654,142 @@ bool Zoom::haveSSE2()
 
 #endif
 
+/**
+ * 8-bit zoomer for resizing by a whole factor. Doesn't flip.
+ * Each source row is widened once and then copied to the other
+ * destination rows, so it only needs plain byte access and works
+ * on targets without SSE2 or unaligned loads (eg. MIPS, ARM).
+ * Used internally by _zoomSurfaceY() below.
+ *
+ * @param src The surface to zoom (input).
+ * @param dst The zoomed surface (output).
+ * @return 0 for success or -1 for error.
+ */
+template<int N>
+static int zoomSurfaceNX_8bit(SDL_Surface *src, SDL_Surface *dst)
+{
+	for (int y = 0; y < src->h; ++y)
+	{
+		const Uint8 *sp = (const Uint8*)src->pixels + y * src->pitch;
+		Uint8 *dp = (Uint8*)dst->pixels + y * N * dst->pitch;
+		Uint8 *out = dp;
+		for (int x = 0; x < src->w; ++x)
+		{
+			Uint8 pixel = sp[x];
+			for (int i = 0; i < N; ++i)
+			{
+				*out++ = pixel;
+			}
+		}
+		for (int i = 1; i < N; ++i)
+		{
+			memcpy(dp + i * dst->pitch, dp, dst->w);
+		}
+	}
+	return 0;
+}
+
+/**
+ * Source pixel and row offsets for every destination pixel and row,
+ * kept between frames since the resolution rarely changes.
+ */
+struct ZoomMap
+{
+	int srcW = 0, srcH = 0, srcPitch = 0, dstW = 0, dstH = 0, flipx = 0, flipy = 0;
+	std::vector<int> cols, rows;
+
+	/**
+	 * Rebuilds the offsets if the surfaces don't match the cached ones.
+	 * @param src The surface to zoom (input).
+	 * @param dst The zoomed surface (output).
+	 * @param fx Flag indicating if the image should be horizontally flipped.
+	 * @param fy Flag indicating if the image should be vertically flipped.
+	 */
+	void update(SDL_Surface *src, SDL_Surface *dst, int fx, int fy)
+	{
+		if (srcW == src->w && srcH == src->h && srcPitch == src->pitch && dstW == dst->w && dstH == dst->h && flipx == fx && flipy == fy)
+		{
+			return;
+		}
+		srcW = src->w;
+		srcH = src->h;
+		srcPitch = src->pitch;
+		dstW = dst->w;
+		dstH = dst->h;
+		flipx = fx;
+		flipy = fy;
+		cols.resize(dstW);
+		rows.resize(dstH);
+
+		// same stepping as the original SDL_gfx zoomer
+		int offset = 0, step = 0;
+		for (int x = 0; x < dstW; ++x)
+		{
+			cols[x] = offset;
+			step += srcW;
+			while (step >= dstW)
+			{
+				step -= dstW;
+				offset += flipx ? -1 : 1;
+			}
+		}
+		offset = 0;
+		step = 0;
+		for (int y = 0; y < dstH; ++y)
+		{
+			rows[y] = offset;
+			step += srcH;
+			while (step >= dstH)
+			{
+				step -= dstH;
+				offset += flipy ? -srcPitch : srcPitch;
+			}
+		}
+	}
+};
+
+/**
+ * 8-bit zoomer for any size, using cached offset tables.
+ * Destination rows showing the same source row as the
+ * one above are copied instead of being zoomed again.
+ * Used internally by _zoomSurfaceY() below.
+ *
+ * @param src The surface to zoom (input).
+ * @param dst The zoomed surface (output).
+ * @param flipx Flag indicating if the image should be horizontally flipped.
+ * @param flipy Flag indicating if the image should be vertically flipped.
+ * @return 0 for success or -1 for error.
+ */
+static int zoomSurfaceMapped_8bit(SDL_Surface *src, SDL_Surface *dst, int flipx, int flipy)
+{
+	static ZoomMap map;
+	map.update(src, dst, flipx, flipy);
+
+	const Uint8 *csp = (const Uint8*)src->pixels;
+	if (flipx) csp += (src->w-1);
+	if (flipy) csp += src->pitch*(src->h-1);
+
+	const int *cols = map.cols.data();
+	Uint8 *dp = (Uint8*)dst->pixels;
+	for (int y = 0; y < dst->h; ++y)
+	{
+		if (y > 0 && map.rows[y] == map.rows[y - 1])
+		{
+			memcpy(dp, dp - dst->pitch, dst->w);
+		}
+		else
+		{
+			const Uint8 *sp = csp + map.rows[y];
+			for (int x = 0; x < dst->w; ++x)
+			{
+				dp[x] = sp[cols[x]];
+			}
+		}
+		dp += dst->pitch;
+	}
+	return 0;
+}
+
 /**
  * Wrapper around various software and OpenGL screen buffer pushing functions which zoom.
  * Basically called just from Screen::flip()
@@ -657,9 +800,10 @@ bool Zoom::haveSSE2()
  * @param bottomBlackBand Size of bottom black band in pixels (letterboxing).
  * @param leftBlackBand Size of left black band in pixels (letterboxing).
  * @param rightBlackBand Size of right black band in pixels (letterboxing).
+ * @param letterbox Buffer for scalers that can't write between the black bands, (re)created as needed.
  * @param glOut OpenGL output.
  */
-void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, int bottomBlackBand, int leftBlackBand, int rightBlackBand, OpenGL *glOut)
+void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, int bottomBlackBand, int leftBlackBand, int rightBlackBand, Surface::UniqueSurfacePtr &letterbox, OpenGL *glOut)
 {
 	int dstWidth = dst->w - leftBlackBand - rightBlackBand;
 	int dstHeight = dst->h - topBlackBand - bottomBlackBand;
@@ -684,20 +828,55 @@ void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, in
 		SDL_Rect dstrect = {(Sint16)leftBlackBand, (Sint16)topBlackBand, (Uint16)src->w, (Uint16)src->h};
 		SDL_BlitSurface(src, NULL, dst, &dstrect);
 	}
-	else
+	else if (needsContiguousOutput(src, dstWidth, dstHeight))
 	{
-		SDL_Surface *tmp = SDL_CreateRGBSurface(dst->flags, dstWidth, dstHeight, dst->format->BitsPerPixel, 0, 0, 0, 0);
-		_zoomSurfaceY(src, tmp, 0, 0);
+		// xBRZ can't write to a pitch wider than its output, so it goes through a buffer kept between frames
+		if (!letterbox || letterbox->w != dstWidth || letterbox->h != dstHeight || letterbox->format->BitsPerPixel != dst->format->BitsPerPixel)
+		{
+			letterbox = Surface::NewSdlSurface(SDL_CreateRGBSurface(dst->flags, dstWidth, dstHeight, dst->format->BitsPerPixel, 0, 0, 0, 0));
+		}
+		_zoomSurfaceY(src, letterbox.get(), 0, 0);
 		if (src->format->palette != NULL)
 		{
-			SDL_SetPalette(tmp, SDL_LOGPAL|SDL_PHYSPAL, src->format->palette->colors, 0, src->format->palette->ncolors);
+			SDL_SetPalette(letterbox.get(), SDL_LOGPAL|SDL_PHYSPAL, src->format->palette->colors, 0, src->format->palette->ncolors);
 		}
-		SDL_Rect dstrect = {(Sint16)leftBlackBand, (Sint16)topBlackBand, (Uint16)tmp->w, (Uint16)tmp->h};
-		SDL_BlitSurface(tmp, NULL, dst, &dstrect);
-		SDL_FreeSurface(tmp);
+		SDL_Rect dstrect = {(Sint16)leftBlackBand, (Sint16)topBlackBand, (Uint16)letterbox->w, (Uint16)letterbox->h};
+		SDL_BlitSurface(letterbox.get(), NULL, dst, &dstrect);
+	}
+	else
+	{
+		// zoom straight into the area between the black bands, the zoomers only use the size, pitch and pixels
+		SDL_Surface view = *dst;
+		view.w = dstWidth;
+		view.h = dstHeight;
+		view.pixels = (Uint8*)dst->pixels + topBlackBand * dst->pitch + leftBlackBand * dst->format->BytesPerPixel;
+		_zoomSurfaceY(src, &view, 0, 0);
 	}
 }
 
+/**
+ * Checks if zooming to the given size uses a scaler that
+ * needs its output rows to follow each other without gaps.
+ * @param src The surface to zoom (input).
+ * @param width Width of the zoomed image.
+ * @param height Height of the zoomed image.
+ * @return True if the output can't be written inside a larger surface.
+ */
+bool Zoom::needsContiguousOutput(SDL_Surface *src, int width, int height)
+{
+	if (Screen::use32bitScaler() && Options::useXBRZFilter)
+	{
+		for (int factor = 2; factor <= 6; factor++)
+		{
+			if (width == src->w * factor && height == src->h * factor)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 
 /**
  * Internal 8-bit Zoomer without smoothing.
@@ -715,16 +894,14 @@ void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, in
  */
 int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int flipy)
 {
-	int x, y;
-	static Uint32 *sax, *say;
-	Uint32 *csax, *csay;
-	int csx, csy;
-	Uint8 *sp, *dp, *csp;
-	int dgap;
 	static bool proclaimed = false;
 
 	if (Screen::use32bitScaler())
 	{
+		ScalerThreads::setThreads(Options::oxceScalerThreads);
+		const uint32_t *srcPixels = (const uint32_t*)src->pixels;
+		uint32_t *dstPixels = (uint32_t*)dst->pixels;
+
 		if (Options::useXBRZFilter)
 		{
 			// check the resolution to see which scale we need
@@ -732,7 +909,10 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 			{
 				if (dst->w == src->w * (int)factor && dst->h == src->h * (int)factor)
 				{
-					xbrz::scale(factor, (uint32_t*)src->pixels, (uint32_t*)dst->pixels, src->w, src->h, xbrz::RGB);
+					ScalerThreads::run(src->h, [&](int yFirst, int yLast)
+					{
+						xbrz::scale(factor, srcPixels, dstPixels, src->w, src->h, xbrz::RGB, xbrz::ScalerCfg(), yFirst, yLast);
+					});
 					return 0;
 				}
 			}
@@ -748,23 +928,28 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 				initDone = true;
 			}
 
-			// HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height );
+			// HQX_API void HQX_CALLCONV hq2x_32_rb_slice( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height, int yFirst, int yLast );
+			decltype(&hq2x_32_rb_slice) hqx = 0;
 
 			if (dst->w == src->w * 2 && dst->h == src->h * 2)
 			{
-				hq2x_32_rb((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h);
-				return 0;
+				hqx = hq2x_32_rb_slice;
 			}
-
-			if (dst->w == src->w * 3 && dst->h == src->h * 3)
+			else if (dst->w == src->w * 3 && dst->h == src->h * 3)
 			{
-				hq3x_32_rb((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h);
-				return 0;
+				hqx = hq3x_32_rb_slice;
+			}
+			else if (dst->w == src->w * 4 && dst->h == src->h * 4)
+			{
+				hqx = hq4x_32_rb_slice;
 			}
 
-			if (dst->w == src->w * 4 && dst->h == src->h * 4)
+			if (hqx)
 			{
-				hq4x_32_rb((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h);
+				ScalerThreads::run(src->h, [&](int yFirst, int yLast)
+				{
+					hqx(srcPixels, src->pitch, dstPixels, dst->pitch, src->w, src->h, yFirst, yLast);
+				});
 				return 0;
 			}
 		}
@@ -837,99 +1022,77 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 		proclaimed = true;
 	}
 
-	/*
-	* Allocate memory for row increments
-	*/
-	if ((sax = (Uint32 *) realloc(sax, (dst->w + 1) * sizeof(Uint32))) == NULL) {
-		sax = 0;
-		return (-1);
-	}
-	if ((say = (Uint32 *) realloc(say, (dst->h + 1) * sizeof(Uint32))) == NULL) {
-		say = 0;
-		//free(sax);
-		return (-1);
+	if (!flipx && !flipy)
+	{
+		if (dst->w == src->w * 2 && dst->h == src->h * 2) return zoomSurfaceNX_8bit<2>(src, dst);
+		if (dst->w == src->w * 3 && dst->h == src->h * 3) return zoomSurfaceNX_8bit<3>(src, dst);
 	}
+	return zoomSurfaceMapped_8bit(src, dst, flipx, flipy);
+}
 
-	/*
-	* Pointer setup
-	*/
-	sp = csp = (Uint8 *) src->pixels;
-	dp = (Uint8 *) dst->pixels;
-	dgap = dst->pitch - dst->w;
-
-	if (flipx) csp += (src->w-1);
-	if (flipy) csp  = ( (Uint8*)csp + src->pitch*(src->h-1) );
 
-	/*
-	* Precalculate row increments
-	*/
-	csx = 0;
-	csax = sax;
-	for (x = 0; x < dst->w; x++) {
-		csx += src->w;
-		*csax = 0;
-		while (csx >= dst->w) {
-			csx -= dst->w;
-			(*csax)++;
-		}
-		(*csax) *= (flipx ? -1 : 1);
-		csax++;
-	}
-	csy = 0;
-	csay = say;
-	for (y = 0; y < dst->h; y++) {
-		csy += src->h;
-		*csay = 0;
-		while (csy >= dst->h) {
-			csy -= dst->h;
-			(*csay)++;
+/**
+ * Times the 32-bit scalers on a generated 320x200 image, on a single
+ * thread and split between the scaler threads, and prints the average
+ * time per frame of each filter and factor.
+ * @param frames Number of frames to scale with each filter.
+ */
+void Zoom::benchmarkScalers(int frames)
+{
+	const int width = 320, height = 200;
+	std::vector<uint32_t> src(width * height);
+	// palette-like image with flat areas, edges and noise, so every scaler path gets used
+	Uint32 seed = 1;
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			seed = seed * 1103515245 + 12345;
+			Uint32 color = ((x / 8 + y / 8) % 2) ? 0x203040 : 0xC0A080;
+			if ((seed >> 16) % 8 == 0)
+			{
+				color = (seed >> 8) & 0xFFFFFF;
+			}
+			src[y * width + x] = color;
 		}
-		(*csay) *= src->pitch * (flipy ? -1 : 1);
-		csay++;
 	}
-	/*
-	* Draw
-	*/
-	csay = say;
-	for (y = 0; y < dst->h; y++) {
-		csax = sax;
-		sp = csp;
-		for (x = 0; x < dst->w; x++) {
-			/*
-			* Draw
-			*/
-			*dp = *sp;
-			/*
-			* Advance source pointers
-			*/
-			sp += (*csax);
-			csax++;
-			/*
-			* Advance destination pointer
-			*/
-			dp++;
+	std::vector<uint32_t> dst(width * height * 6 * 6);
+	hqxInit();
+
+	auto time = [&](const std::string &name, const std::function<void(int, int)> &scale)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < frames; ++i)
+		{
+			ScalerThreads::run(height, scale);
 		}
-		/*
-		* Advance source pointer (for row)
-		*/
-		csp += (*csay);
-		csay++;
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "  " << std::left << std::setw(8) << name << std::fixed << std::setprecision(2) << ms / frames << " ms/frame" << std::endl;
+	};
 
-		/*
-		* Advance destination pointers
-		*/
-		dp += dgap;
+	int threadCounts[] = { 1, 0 };
+	for (int threads : threadCounts)
+	{
+		ScalerThreads::setThreads(threads);
+		std::cout << width << "x" << height << " source, " << frames << " frames, " << ScalerThreads::getThreads() << " thread(s):" << std::endl;
+		for (size_t factor = 2; factor <= 6; factor++)
+		{
+			time("xBRZ " + std::to_string(factor) + "x", [&](int yFirst, int yLast)
+			{
+				xbrz::scale(factor, src.data(), dst.data(), width, height, xbrz::RGB, xbrz::ScalerCfg(), yFirst, yLast);
+			});
+		}
+		decltype(&hq2x_32_rb_slice) hqx[] = { hq2x_32_rb_slice, hq3x_32_rb_slice, hq4x_32_rb_slice };
+		for (int factor = 2; factor <= 4; factor++)
+		{
+			time("HQ" + std::to_string(factor) + "x", [&](int yFirst, int yLast)
+			{
+				hqx[factor - 2](src.data(), width * 4, dst.data(), width * factor * 4, width, height, yFirst, yLast);
+			});
+		}
 	}
-
-	/*
-	* Never remove temp arrays
-	*/
-	//free(sax);
-	//free(say);
-
-	return 0;
+	ScalerThreads::setThreads(Options::oxceScalerThreads);
 }
 
-
 }
 
@@ -19,6 +19,7 @@
  */
 #include <SDL.h>
 #include "OpenGL.h"
+#include "Surface.h"
 
 namespace OpenXcom
 {
@@ -29,11 +30,15 @@ class Zoom
 
 	public:
 	/// Flip screen given src and dst; might use software or OpenGL.
-	static void flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, int bottomBlackBand, int leftBlackBand, int rightBlackBand, OpenGL *glOut);
+	static void flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, int bottomBlackBand, int leftBlackBand, int rightBlackBand, Surface::UniqueSurfacePtr &letterbox, OpenGL *glOut);
 	/// Copy src to dst, resizing as needed. Please don't use flipx or flipy as the optimized functions ignore these parameters.
 	static int _zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int flipy);
+	/// Checks if a zoom needs an output surface without padding between rows.
+	static bool needsContiguousOutput(SDL_Surface *src, int width, int height);
 	/// Check for SSE2 instructions using CPUID.
 	static bool haveSSE2();
+	/// Prints the time per frame of each 32-bit scaler.
+	static void benchmarkScalers(int frames);
 
 private:
 
@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <SDL_types.h>
 #include "../fmath.h"
 
 namespace OpenXcom
@@ -118,6 +119,36 @@ struct Cord
 	}
 };
 
+/**
+ * Unit vector stored in fixed point, three times smaller than `Cord`.
+ */
+struct CordFixed
+{
+	static const int Shift = 14;
+	static const int One = 1 << Shift;
+
+	Sint16 x, y, z;
+
+	inline CordFixed()
+	{
+		x = 0;
+		y = 0;
+		z = 0;
+	}
+	explicit inline CordFixed(const Cord& c)
+	{
+		x = (Sint16)std::lround(c.x * One);
+		y = (Sint16)std::lround(c.y * One);
+		z = (Sint16)std::lround(c.z * One);
+	}
+
+	/// Dot product, scaled by `One * One`.
+	inline int dot(const CordFixed& c) const
+	{
+		return x * c.x + y * c.y + z * c.z;
+	}
+};
+
 inline Cord::Cord(const CordPolar& pol)
 {
 	x = std::sin(pol.lon) * std::cos(pol.lat);
@@ -836,6 +836,29 @@ void GeoscapeState::timeAdvance()
 
 	for (int i = 0; i < timeSpan && !_pause; ++i)
 	{
+		// fast forward over steps that would only tick the clock,
+		// but always run the first one so all state is settled
+		if (i > 0)
+		{
+			int quiet = getQuietSteps(std::min(timeSpan - i, _game->getSavedGame()->getTime()->getStepsToNextTrigger() - 1));
+			for (int j = 0; j < quiet; ++j)
+			{
+				_game->getSavedGame()->getTime()->advance();
+			}
+			for (auto* ufo : *_game->getSavedGame()->getUfos())
+			{
+				if (ufo->getStatus() == Ufo::LANDED)
+				{
+					ufo->setSecondsRemaining(ufo->getSecondsRemaining() - 5 * quiet);
+				}
+			}
+			i += quiet;
+			if (i >= timeSpan)
+			{
+				break;
+			}
+		}
+
 		TimeTrigger trigger;
 		trigger = _game->getSavedGame()->getTime()->advance();
 		switch (trigger)
@@ -866,6 +889,72 @@ void GeoscapeState::timeAdvance()
 	_globe->draw();
 }
 
+/**
+ * Counts how many of the next 5 second steps would change nothing but
+ * the clock and the timers of landed UFOs, so they can be skipped without
+ * running time5Seconds(). Anything flying, fighting or recharging shields
+ * (which rolls the RNG) makes every step count, so skipping never changes
+ * the outcome or the RNG sequence.
+ * @param maxSteps Maximum number of steps to skip.
+ * @return Number of steps that can be skipped.
+ */
+int GeoscapeState::getQuietSteps(int maxSteps) const
+{
+	SavedGame *save = _game->getSavedGame();
+	if (maxSteps <= 0 || !_dogfights.empty() || !_dogfightsToBeStarted.empty())
+	{
+		return 0;
+	}
+	if (save->getBases()->empty() || save->getEnding() == END_LOSE)
+	{
+		return 0;
+	}
+	if ((_timeSpeed == _btn5Secs || _timeSpeed == _btn1Min) && _game->getMod()->getHunterKillerFastRetarget())
+	{
+		return 0;
+	}
+	for (auto* ufo : *save->getUfos())
+	{
+		switch (ufo->getStatus())
+		{
+		case Ufo::LANDED:
+			// the step that runs out of time has to lift the UFO
+			maxSteps = std::min(maxSteps, (int)(ufo->getSecondsRemaining() / 5) - 1);
+			break;
+		case Ufo::CRASHED:
+			if (!ufo->getDetected() || ufo->getSecondsRemaining() == 0)
+			{
+				return 0;
+			}
+			break;
+		default:
+			return 0;
+		}
+	}
+	for (auto* base : *save->getBases())
+	{
+		for (auto* craft : *base->getCrafts())
+		{
+			if (craft->isDestroyed() || craft->getDestination() != 0 || craft->isTakingOff())
+			{
+				return 0;
+			}
+			if (craft->getShield() < craft->getCraftStats().shieldCapacity && craft->getCraftStats().shieldRechargeInGeoscape != 0)
+			{
+				return 0;
+			}
+		}
+	}
+	for (auto* waypoint : *save->getWaypoints())
+	{
+		if (waypoint->getFollowers()->empty())
+		{
+			return 0;
+		}
+	}
+	return std::max(0, maxSteps);
+}
+
 /**
  * Update list of active crafts.
  * @return Const pointer to updated list.
@@ -2106,10 +2195,9 @@ void GeoscapeState::time1Hour()
 			{
 				_game->getSavedGame()->setAlienContainmentChecked(true);
 				std::map<int, int> prisonTypes;
-				RuleItem *rule = nullptr;
-				for (auto &item : *(*i)->getStorageItems()->getContents())
+				for (auto &item : (*i)->getStorageItems()->getContents())
 				{
-					rule = _game->getMod()->getItem(item.first, true);
+					RuleItem *rule = item.first;
 					if (rule->isAlien())
 					{
 						prisonTypes[rule->getPrisonType()] += 1;
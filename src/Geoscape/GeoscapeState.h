@@ -84,6 +84,8 @@ public:
 	void timeDisplay();
 	/// Advances the game timer.
 	void timeAdvance();
+	/// Counts the next 5 second steps where nothing can happen.
+	int getQuietSteps(int maxSteps) const;
 	/// Trigger whenever 5 seconds pass.
 	void time5Seconds();
 	/// Trigger whenever 10 minutes pass.
@@ -267,6 +267,34 @@ struct CreateShadow
 		return Clamp(i, 0, 31);
 	}
 
+	/**
+	 * Same as the `Cord` version but in fixed point with 12 bits of fraction.
+	 * For unit vectors the squared distance is `2 - 2 * dot`,
+	 * so only one dot product is needed per pixel.
+	 */
+	static inline Uint8 getShadowValue(const CordFixed& earth, const CordFixed& sun, const Sint16& noise)
+	{
+		const int fraction = 12;
+		const int one = 1 << fraction;
+		const int half = one * GlobeStaticData::shade_gradient_max / 2;
+
+		//drop some bits first, otherwise it would overflow
+		int x = half - (((earth.dot(sun) >> 6) * 250) >> (2 * CordFixed::Shift - 6 - fraction));
+		x -= static_data.getDistanceNoise(noise) * one;
+		x += static_data.getMultiplierNoise(noise) * 4 * (x - half) / GlobeStaticData::shade_gradient_max;
+
+		int full = x / one;
+		int rem = x % one;
+		int offset = Clamp(full, 0, GlobeStaticData::shade_gradient_max - 1);
+		int i = static_data.shade_gradient[offset];
+
+		int middle = (static_data.shade_seq[offset] * one + static_data.shade_step[offset] * rem - one * GlobeStaticData::shade_step_max / 2) / one;
+		i += middle / GlobeStaticData::shade_step_max;
+		i += (static_data.getValueNoise(noise) < (middle % GlobeStaticData::shade_step_max));
+
+		return Clamp(i, 0, 31);
+	}
+
 	static inline Uint8 getOceanShadow(const Uint8& shadow)
 	{
 		return Globe::OCEAN_COLOR + shadow;
@@ -288,7 +316,8 @@ struct CreateShadow
 		return Globe::OCEAN_SHADING && dest >= Globe::OCEAN_COLOR && dest < Globe::OCEAN_COLOR + 32;
 	}
 
-	static inline void func(Uint8& dest, const Cord& earth, const Cord& sun, const Sint16& noise)
+	template<typename CordType>
+	static inline void func(Uint8& dest, const CordType& earth, const CordType& sun, const Sint16& noise)
 	{
 		if (dest && earth.z)
 		{
@@ -451,7 +480,8 @@ Polygon* Globe::getPolygonFromLonLat(double lon, double lat) const
 	double coslat = cos(lat);
 	double sinlat = sin(lat);
 
-	for (std::list<Polygon*>::iterator i = _rules->getPolygons()->begin(); i != _rules->getPolygons()->end(); ++i)
+	const std::vector<Polygon*> &candidates = _rules->getPolygonsNear(lon, lat);
+	for (std::vector<Polygon*>::const_iterator i = candidates.begin(); i != candidates.end(); ++i)
 	{
 		double x, y, z, x2, y2;
 		double clat, clon;
@@ -1052,13 +1082,24 @@ Cord Globe::getSunDirection(double lon, double lat) const
 
 void Globe::drawShadow()
 {
-	auto earth = ShaderMove<Cord>(SurfaceRaw<Cord>(_earthData[_zoom], getWidth(), getHeight()));
-	auto noise = ShaderRepeat<Sint16>(SurfaceRaw<Sint16>(static_data.random_noise, static_data.random_surf_size, static_data.random_surf_size));
+	const bool fixed = Options::oxceGlobeFixedShading;
+	setupEarthData(fixed);
 
-	earth.setMove(_cenX-getWidth()/2, _cenY-getHeight()/2);
+	auto noise = ShaderRepeat<Sint16>(SurfaceRaw<Sint16>(static_data.random_noise, static_data.random_surf_size, static_data.random_surf_size));
 
 	lock();
-	ShaderDraw<CreateShadow>(ShaderSurface(this), earth, ShaderScalar(getSunDirection(_cenLon, _cenLat)), noise);
+	if (fixed)
+	{
+		auto earth = ShaderMove<CordFixed>(SurfaceRaw<CordFixed>(_earthDataFixed[_zoom], getWidth(), getHeight()));
+		earth.setMove(_cenX-getWidth()/2, _cenY-getHeight()/2);
+		ShaderDraw<CreateShadow>(ShaderSurface(this), earth, ShaderScalar(CordFixed(getSunDirection(_cenLon, _cenLat))), noise);
+	}
+	else
+	{
+		auto earth = ShaderMove<Cord>(SurfaceRaw<Cord>(_earthData[_zoom], getWidth(), getHeight()));
+		earth.setMove(_cenX-getWidth()/2, _cenY-getHeight()/2);
+		ShaderDraw<CreateShadow>(ShaderSurface(this), earth, ShaderScalar(getSunDirection(_cenLon, _cenLat)), noise);
+	}
 	unlock();
 
 }
@@ -2078,18 +2119,65 @@ void Globe::setupRadii(int width, int height)
 	_radius = _zoomRadius[_zoom];
 	_radiusStep = (_zoomRadius[DOGFIGHT_ZOOM] - _zoomRadius[0]) / 10.0;
 
+	//normals are filled when each zoom level is drawn
+	_earthData.clear();
 	_earthData.resize(_zoomRadius.size());
-	//filling normal field for each radius
+	_earthDataFixed.clear();
+	_earthDataFixed.resize(_zoomRadius.size());
+}
 
-	for (size_t r = 0; r<_zoomRadius.size(); ++r)
+/**
+ * Fills the normal field of the earth for the current zoom level,
+ * in the format used by the shading, unless it was already filled.
+ * Switching formats frees the levels filled in the other one.
+ * @param fixed Use fixed point normals.
+ */
+void Globe::setupEarthData(bool fixed)
+{
+	if (fixed ? !_earthDataFixed[_zoom].empty() : !_earthData[_zoom].empty())
+	{
+		return;
+	}
+	const int width = getWidth();
+	const int height = getHeight();
+	const double radius = _zoomRadius[_zoom];
+
+	if (fixed)
 	{
-		_earthData[r].resize(width * height);
-		for (int j=0; j<height; ++j)
-			for (int i=0; i<width; ++i)
+		for (auto &level : _earthData)
+		{
+			std::vector<Cord>().swap(level);
+		}
+		_earthDataFixed[_zoom].resize(width * height);
+	}
+	else
+	{
+		for (auto &level : _earthDataFixed)
+		{
+			std::vector<CordFixed>().swap(level);
+		}
+		_earthData[_zoom].resize(width * height);
+	}
+
+	for (int j=0; j<height; ++j)
+		for (int i=0; i<width; ++i)
+		{
+			Cord norm = static_data.circle_norm(width/2, height/2, radius, i+.5, j+.5);
+			if (fixed)
 			{
-				_earthData[r][width*j + i] = static_data.circle_norm(width/2, height/2, _zoomRadius[r], i+.5, j+.5);
+				CordFixed &normFixed = _earthDataFixed[_zoom][width*j + i];
+				normFixed = CordFixed(norm);
+				//zero is outside of the globe, keep pixels on the edge
+				if (norm.z && !normFixed.z)
+				{
+					normFixed.z = 1;
+				}
 			}
-	}
+			else
+			{
+				_earthData[_zoom][width*j + i] = norm;
+			}
+		}
 }
 
 /**
@@ -67,8 +67,10 @@ private:
 	std::list<Polygon*> _cacheLand;
 	FastLineClip *_clipper;
 	double _radius, _radiusStep;
-	///normal of each pixel in earth globe per zoom level
+	///normal of each pixel in earth globe per zoom level, filled when the level is first drawn
 	std::vector<std::vector<Cord> > _earthData;
+	///same as `_earthData` but in fixed point
+	std::vector<std::vector<CordFixed> > _earthDataFixed;
 	///list of dimension of earth on screen per zoom level
 	std::vector<double> _zoomRadius;
 
@@ -103,6 +105,8 @@ private:
 	void drawTarget(Target *target, Surface *surface);
 	/// Set up the radius of earth and stuff.
 	void setupRadii(int width, int height);
+	/// Fills the normals of the earth for the current zoom level, if needed.
+	void setupEarthData(bool fixed);
 public:
 	static Uint8 OCEAN_COLOR;
 	static bool OCEAN_SHADING;
@@ -65,7 +65,7 @@ bool ArrowButton::isButtonHandled(Uint8 button)
 void ArrowButton::setColor(Uint8 color)
 {
 	ImageButton::setColor(color);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -75,7 +75,7 @@ void ArrowButton::setColor(Uint8 color)
 void ArrowButton::setShape(ArrowShape shape)
 {
 	_shape = shape;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -48,7 +48,7 @@ Bar::~Bar()
 void Bar::setColor(Uint8 color)
 {
 	_color = color;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -67,7 +67,7 @@ Uint8 Bar::getColor() const
 void Bar::setSecondaryColor(Uint8 color)
 {
 	_color2 = color;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -86,7 +86,7 @@ Uint8 Bar::getSecondaryColor() const
 void Bar::setScale(double scale)
 {
 	_scale = scale;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -105,7 +105,7 @@ double Bar::getScale() const
 void Bar::setMax(double max)
 {
 	_max = max;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -124,7 +124,7 @@ double Bar::getMax() const
 void Bar::setValue(double value)
 {
 	_value = (value < 0.0)? 0.0 : value;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -143,7 +143,7 @@ double Bar::getValue() const
 void Bar::setValue2(double value)
 {
 	_value2 = (value < 0.0)? 0.0 : value;
-	_redraw = true;
+	invalidate();
 }
 
 /**
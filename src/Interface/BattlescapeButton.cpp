@@ -68,7 +68,10 @@ void BattlescapeButton::setGroup(BattlescapeButton **group)
 {
 	_group = group;
 	if (_group != 0 && *_group == this)
+	{
 		_inverted = true;
+		damage();
+	}
 }
 
 /**
@@ -86,11 +89,13 @@ void BattlescapeButton::mousePress(Action *action, State *state)
 			(*_group)->toggle(false);
 			*_group = this;
 			_inverted = true;
+			damage();
 		}
 	}
 	else if ((_tftdMode || _toggleMode == INVERT_CLICK ) && !_inverted && isButtonPressed() && isButtonHandled(action->getDetails()->button.button))
 	{
 		_inverted = true;
+		damage();
 	}
 	InteractiveSurface::mousePress(action, state);
 }
@@ -105,6 +110,7 @@ void BattlescapeButton::mouseRelease(Action *action, State *state)
 	if (_inverted && isButtonHandled(action->getDetails()->button.button))
 	{
 		_inverted = false;
+		damage();
 	}
 	InteractiveSurface::mouseRelease(action, state);
 }
@@ -118,6 +124,7 @@ void BattlescapeButton::toggle(bool press)
 	if (_tftdMode || _toggleMode == INVERT_TOGGLE || _inverted)
 	{
 		_inverted = press;
+		damage();
 	}
 }
 
@@ -202,6 +209,11 @@ void BattlescapeButton::blit(SDL_Surface *surface)
 {
 	if (_inverted)
 	{
+		// the inverted copy stands in for the button on screen
+		if (_visible && !_hidden)
+		{
+			blitDamage(surface);
+		}
 		_altSurface->blit(surface);
 	}
 	else
@@ -338,9 +338,12 @@ void ComboBox::setOptions(const std::vector<std::string> &options, bool translat
 void ComboBox::blit(SDL_Surface *surface)
 {
 	Surface::blit(surface);
-	_list->invalidate();
 	if (_visible && !_hidden)
 	{
+		if (_list->getVisible())
+		{
+			_list->invalidate();
+		}
 		_button->blit(surface);
 		_arrow->blit(surface);
 		_window->blit(surface);
@@ -66,7 +66,7 @@ void Cursor::handle(Action *action)
 void Cursor::setColor(Uint8 color)
 {
 	_color = color;
-	_redraw = true;
+	invalidate();
 }
 
 /**
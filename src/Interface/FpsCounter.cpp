@@ -104,7 +104,7 @@ void FpsCounter::update()
 	int fps = (int)floor((double)_frames / _timer->getTime() * 1000);
 	_text->setValue(fps);
 	_frames = 0;
-	_redraw = true;
+	invalidate();
 }
 
 /**
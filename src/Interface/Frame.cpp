@@ -47,7 +47,7 @@ Frame::~Frame()
 void Frame::setColor(Uint8 color)
 {
 	_color = color;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -78,7 +78,7 @@ Uint8 Frame::getColor() const
 void Frame::setSecondaryColor(Uint8 bg)
 {
 	_bg = bg;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -98,7 +98,7 @@ Uint8 Frame::getSecondaryColor() const
 void Frame::setHighContrast(bool contrast)
 {
 	_contrast = contrast;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -108,7 +108,7 @@ void Frame::setHighContrast(bool contrast)
 void Frame::setThickness(int thickness)
 {
 	_thickness = thickness;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -220,7 +220,7 @@ NumberText::~NumberText()
 void NumberText::setValue(unsigned int value)
 {
 	_value = value;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -239,7 +239,7 @@ unsigned int NumberText::getValue() const
 void NumberText::setColor(Uint8 color)
 {
 	_color = color;
-	_redraw = true;
+	invalidate();
 }
 
 /**
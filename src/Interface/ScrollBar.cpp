@@ -83,7 +83,7 @@ void ScrollBar::setHeight(int height)
 	Surface::setHeight(height);
 	_track->setHeight(height);
 	_thumb->setHeight(height);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -93,6 +93,7 @@ void ScrollBar::setHeight(int height)
 void ScrollBar::setColor(Uint8 color)
 {
 	_color = color;
+	invalidate();
 }
 
 /**
@@ -131,6 +132,7 @@ void ScrollBar::setTextList(TextList *list)
 void ScrollBar::setBackground(Surface *bg)
 {
 	_bg = bg;
+	invalidate();
 }
 
 /**
@@ -171,12 +173,20 @@ void ScrollBar::handle(Action *action, State *state)
  */
 void ScrollBar::blit(SDL_Surface *surface)
 {
+	if (_visible && !_hidden && _list)
+	{
+		// follow the list without redrawing on every frame
+		double scale = (double)getHeight() / _list->getRowsDoNotUse();
+		if (_thumbRect.w == 0 || _thumbRect.y != (int)floor(_list->getScroll() * scale) || _thumbRect.h != (int)ceil(_list->getVisibleRows() * scale))
+		{
+			invalidate();
+		}
+	}
 	Surface::blit(surface);
 	if (_visible && !_hidden)
 	{
 		_track->blit(surface);
 		_thumb->blit(surface);
-		invalidate();
 	}
 }
 
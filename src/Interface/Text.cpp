@@ -143,7 +143,7 @@ void Text::setWordWrap(bool wrap, bool indent, bool ignoreSeparators)
 void Text::setInvert(bool invert)
 {
 	_invert = invert;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -154,7 +154,7 @@ void Text::setInvert(bool invert)
 void Text::setHighContrast(bool contrast)
 {
 	_contrast = contrast;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -165,7 +165,7 @@ void Text::setHighContrast(bool contrast)
 void Text::setAlign(TextHAlign align)
 {
 	_align = align;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -186,7 +186,7 @@ TextHAlign Text::getAlign() const
 void Text::setVerticalAlign(TextVAlign valign)
 {
 	_valign = valign;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -209,7 +209,7 @@ void Text::setColor(Uint8 color)
 {
 	_color = color;
 	_color2 = color;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -230,7 +230,7 @@ Uint8 Text::getColor() const
 void Text::setSecondaryColor(Uint8 color)
 {
 	_color2 = color;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -410,7 +410,7 @@ void Text::processText()
 		}
 	}
 
-	_redraw = true;
+	invalidate();
 }
 
 namespace
@@ -74,7 +74,7 @@ void TextButton::setColor(Uint8 color)
 {
 	_color = color;
 	_text->setColor(color);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -93,7 +93,7 @@ Uint8 TextButton::getColor() const
 void TextButton::setTextColor(Uint8 color)
 {
 	_text->setColor(color);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -102,7 +102,7 @@ void TextButton::setTextColor(Uint8 color)
 void TextButton::setBig()
 {
 	_text->setBig();
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -111,7 +111,7 @@ void TextButton::setBig()
 void TextButton::setSmall()
 {
 	_text->setSmall();
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -135,7 +135,7 @@ Font *TextButton::getFont() const
 void TextButton::initText(Font *big, Font *small, Language *lang)
 {
 	_text->initText(big, small, lang);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -147,7 +147,7 @@ void TextButton::setHighContrast(bool contrast)
 {
 	_contrast = contrast;
 	_text->setHighContrast(contrast);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -157,7 +157,7 @@ void TextButton::setHighContrast(bool contrast)
 void TextButton::setText(const std::string &text)
 {
 	_text->setText(text);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -177,7 +177,7 @@ std::string TextButton::getText() const
 void TextButton::setGroup(TextButton **group)
 {
 	_group = group;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -304,7 +304,7 @@ void TextButton::mousePress(Action *action, State *state)
 		}
 
 		draw();
-		//_redraw = true;
+		//invalidate();
 	}
 	InteractiveSurface::mousePress(action, state);
 }
@@ -319,7 +319,7 @@ void TextButton::mouseRelease(Action *action, State *state)
 	if (isButtonHandled(action->getDetails()->button.button))
 	{
 		draw();
-		//_redraw = true;
+		//invalidate();
 	}
 	InteractiveSurface::mouseRelease(action, state);
 }
@@ -85,7 +85,7 @@ void TextEdit::setFocus(bool focus, bool modal)
 	_modal = modal;
 	if (focus != _isFocused)
 	{
-		_redraw = true;
+		invalidate();
 		InteractiveSurface::setFocus(focus);
 		if (_isFocused)
 		{
@@ -147,7 +147,7 @@ void TextEdit::setText(const std::string &text)
 {
 	_value = Unicode::convUtf8ToUtf32(text);
 	_caretPos = _value.length();
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -290,7 +290,7 @@ void TextEdit::think()
 void TextEdit::blink()
 {
 	_blink = !_blink;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -562,7 +562,7 @@ void TextEdit::keyboardPress(Action *action, State *state)
 			break;
 		}
 	}
-	_redraw = true;
+	invalidate();
 	if (_change)
 	{
 		(state->*_change)(action);
@@ -156,7 +156,7 @@ void TextList::unpress(State *state)
 void TextList::setCellColor(size_t row, size_t column, Uint8 color)
 {
 	_texts[row][column]->setColor(color);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -170,7 +170,7 @@ void TextList::setRowColor(size_t row, Uint8 color)
 	{
 		(*i)->setColor(color);
 	}
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -193,7 +193,7 @@ std::string TextList::getCellText(size_t row, size_t column) const
 void TextList::setCellText(size_t row, size_t column, const std::string &text)
 {
 	_texts[row][column]->setText(text);
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -420,7 +420,7 @@ void TextList::addRow(int cols, ...)
 		_arrowRight.push_back(a2);
 	}
 
-	_redraw = true;
+	invalidate();
 	va_end(args);
 	updateArrows();
 }
@@ -453,7 +453,7 @@ void TextList::removeLastRow()
 			_arrowRight.pop_back();
 		}
 	}
-	_redraw = true;
+	invalidate();
 	updateArrows();
 }
 
@@ -894,7 +894,7 @@ void TextList::clearList()
 	scrollUp(true, false);
 	_texts.clear();
 	_rows.clear();
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -57,7 +57,7 @@ void ToggleTextButton::setPressed(bool pressed)
 	_fakeGroup = _isPressed ? this : 0;
 	if (_isPressed && _invertedColor > -1) TextButton::setColor(_invertedColor);
 	else TextButton::setColor(_originalColor);
-	_redraw = true;
+	invalidate();
 }
 
 void ToggleTextButton::setColor(Uint8 color)
@@ -71,7 +71,7 @@ void ToggleTextButton::setInvertColor(Uint8 color)
 {
 	_invertedColor = color;
 	_fakeGroup = 0;
-	_redraw = true;
+	invalidate();
 }
 
 /// handle draw() in case we need to paint the button a garish color
@@ -78,7 +78,7 @@ Window::~Window()
 void Window::setBackground(const Surface *bg)
 {
 	_bg = bg;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -88,7 +88,7 @@ void Window::setBackground(const Surface *bg)
 void Window::setColor(Uint8 color)
 {
 	_color = color;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -108,7 +108,7 @@ Uint8 Window::getColor() const
 void Window::setHighContrast(bool contrast)
 {
 	_contrast = contrast;
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -152,7 +152,7 @@ void Window::popup()
 		_popupStep = 1.0;
 		_timer->stop();
 	}
-	_redraw = true;
+	invalidate();
 }
 
 /**
@@ -160,7 +160,7 @@ void LoadGameState::think()
 		}
 
 		// Load the game
-		SavedGame *s = new SavedGame();
+		SavedGame *s = new SavedGame(_game->getMod());
 		try
 		{
 			s->load(_filename, _game->getMod(), _game->getLanguage());
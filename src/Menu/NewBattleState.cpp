@@ -288,7 +288,7 @@ void NewBattleState::load(const std::string &filename)
 			if (doc["base"])
 			{
 				const Mod *mod = _game->getMod();
-				SavedGame *save = new SavedGame();
+				SavedGame *save = new SavedGame(mod);
 
 				Base *base = new Base(mod);
 				base->load(doc["base"], save, false);
@@ -301,7 +301,7 @@ void NewBattleState::load(const std::string &filename)
 				}
 
 				// Generate items
-				base->getStorageItems()->getContents()->clear();
+				base->getStorageItems()->clear();
 				const std::vector<std::string> &items = mod->getItemsList();
 				for (std::vector<std::string>::const_iterator i = items.begin(); i != items.end(); ++i)
 				{
@@ -316,20 +316,13 @@ void NewBattleState::load(const std::string &filename)
 				if (base->getCrafts()->empty())
 				{
 					std::string craftType = _crafts[_cbxCraft->getSelected()];
-					_craft = new Craft(_game->getMod()->getCraft(craftType), base, save->getId(craftType));
+					_craft = new Craft(_game->getMod()->getCraft(craftType), _game->getMod(), base, save->getId(craftType));
 					base->getCrafts()->push_back(_craft);
 				}
 				else
 				{
+					// invalid items were already dropped when loading the craft
 					_craft = base->getCrafts()->front();
-					for (std::map<std::string, int>::iterator i = _craft->getItems()->getContents()->begin(); i != _craft->getItems()->getContents()->end(); ++i)
-					{
-						RuleItem *rule = _game->getMod()->getItem(i->first);
-						if (!rule)
-						{
-							i->second = 0;
-						}
-					}
 				}
 
 				_game->setSavedGame(save);
@@ -380,7 +373,7 @@ void NewBattleState::save(const std::string &filename)
 void NewBattleState::initSave()
 {
 	const Mod *mod = _game->getMod();
-	SavedGame *save = new SavedGame();
+	SavedGame *save = new SavedGame(mod);
 	Base *base = new Base(mod);
 	const YAML::Node &starter = _game->getMod()->getDefaultStartingBase();
 	base->load(starter, save, true, true);
@@ -391,9 +384,9 @@ void NewBattleState::initSave()
 	base->getSoldiers()->clear();
 	for (std::vector<Craft*>::iterator i = base->getCrafts()->begin(); i != base->getCrafts()->end(); ++i) delete (*i);
 	base->getCrafts()->clear();
-	base->getStorageItems()->getContents()->clear();
+	base->getStorageItems()->clear();
 
-	_craft = new Craft(mod->getCraft(_crafts[_cbxCraft->getSelected()]), base, 1);
+	_craft = new Craft(mod->getCraft(_crafts[_cbxCraft->getSelected()]), mod, base, 1);
 	base->getCrafts()->push_back(_craft);
 
 	// Generate soldiers
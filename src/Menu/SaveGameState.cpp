@@ -26,10 +26,12 @@
 #include "../Engine/CrossPlatform.h"
 #include "../Engine/LocalizedText.h"
 #include "../Engine/Unicode.h"
+#include "../Engine/Language.h"
 #include "../Interface/Text.h"
 #include "ErrorMessageState.h"
 #include "MainMenuState.h"
 #include "../Savegame/SavedGame.h"
+#include "../Savegame/SaveWriter.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleInterface.h"
 
@@ -158,13 +160,35 @@ void SaveGameState::think()
 		// Save the game
 		try
 		{
-			std::string backup = _filename + ".bak";
-			_game->getSavedGame()->save(backup, _game->getMod());
-			std::string fullPath = Options::getMasterUserFolder() + _filename;
-			std::string bakPath = Options::getMasterUserFolder() + backup;
-			if (!CrossPlatform::moveFile(bakPath, fullPath))
+			if (_type == SAVE_DEFAULT)
 			{
-				throw Exception("Save backed up in " + backup);
+				// don't race a background save
+				SaveWriter::wait();
+				std::string backup = _filename + ".bak";
+				std::vector<YAML::Node> docs = _game->getSavedGame()->saveDocuments(_game->getMod());
+				SavedGame::writeDocuments(backup, docs);
+				std::string fullPath = Options::getMasterUserFolder() + _filename;
+				std::string bakPath = Options::getMasterUserFolder() + backup;
+				if (!CrossPlatform::moveFile(bakPath, fullPath))
+				{
+					throw Exception("Save backed up in " + backup);
+				}
+				// only list it under its real name once it's there
+				SavedGame::updateSaveIndex(_filename, docs[0]);
+			}
+			else
+			{
+				// automatic saves are only snapshotted here and written in the background
+				OptionsOrigin origin = _origin;
+				std::vector<SDL_Color> palette(_palette, _palette + 256);
+				SaveWriter::start(_filename, _game->getSavedGame()->saveDocuments(_game->getMod()),
+					[origin, palette](const std::string &err) mutable
+					{
+						if (!err.empty())
+						{
+							error(origin, palette.data(), err);
+						}
+					});
 			}
 
 			if (_type == SAVE_IRONMAN_END)
@@ -199,14 +223,26 @@ void SaveGameState::think()
  * @param msg Error message.
  */
 void SaveGameState::error(const std::string &msg)
+{
+	error(_origin, _palette, msg);
+}
+
+/**
+ * Pops up a window with an error message,
+ * also used once a background save fails.
+ * @param origin Game section that originated the save.
+ * @param palette Palette of the save screen.
+ * @param msg Error message.
+ */
+void SaveGameState::error(OptionsOrigin origin, SDL_Color *palette, const std::string &msg)
 {
 	Log(LOG_ERROR) << msg;
 	std::ostringstream error;
-	error << tr("STR_SAVE_UNSUCCESSFUL") << Unicode::TOK_NL_SMALL << msg;
-	if (_origin != OPT_BATTLESCAPE)
-		_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("geoscapeColor")->color, "BACK01.SCR", _game->getMod()->getInterface("errorMessages")->getElement("geoscapePalette")->color));
+	error << _game->getLanguage()->getString("STR_SAVE_UNSUCCESSFUL") << Unicode::TOK_NL_SMALL << msg;
+	if (origin != OPT_BATTLESCAPE)
+		_game->pushState(new ErrorMessageState(error.str(), palette, _game->getMod()->getInterface("errorMessages")->getElement("geoscapeColor")->color, "BACK01.SCR", _game->getMod()->getInterface("errorMessages")->getElement("geoscapePalette")->color));
 	else
-		_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
+		_game->pushState(new ErrorMessageState(error.str(), palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
 }
 
 }
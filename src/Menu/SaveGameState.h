@@ -52,6 +52,8 @@ public:
 	void think() override;
 	/// Shows an error message.
 	void error(const std::string &msg);
+	/// Shows an error message for a save from the given section.
+	static void error(OptionsOrigin origin, SDL_Color *palette, const std::string &msg);
 };
 
 }
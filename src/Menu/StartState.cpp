@@ -30,11 +30,13 @@
 #include "../Engine/Font.h"
 #include "../Engine/Timer.h"
 #include "../Engine/CrossPlatform.h"
+#include "../Engine/Profiler.h"
 #include "../Interface/FpsCounter.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/Text.h"
 #include "MainMenuState.h"
 #include "CutsceneState.h"
+#include "../Battlescape/BenchmarkState.h"
 #include <SDL_mixer.h>
 #include <SDL_thread.h>
 
@@ -174,6 +176,12 @@ void StartState::think()
 	case LOADING_SUCCESSFUL:
 		CrossPlatform::flashWindow();
 		Log(LOG_INFO) << "OpenXcom started successfully!";
+		Profiler::report("startup");
+		if (BenchmarkState::isRequested())
+		{
+			_game->setState(new BenchmarkState);
+			break;
+		}
 		_game->setState(new GoToMainMenuState(true));
 		if (_oldMaster != Options::getActiveMaster() && Options::playIntro)
 		{
@@ -305,13 +313,16 @@ int StartState::load(void *game_ptr)
 	Game *game = (Game*)game_ptr;
 	try
 	{
-		Log(LOG_INFO) << "Loading data...";
-		Options::updateMods();
-		game->loadMods();
-		Log(LOG_INFO) << "Data loaded successfully.";
-		Log(LOG_INFO) << "Loading language...";
-		game->loadLanguages();
-		Log(LOG_INFO) << "Language loaded successfully.";
+		{
+			Profiler::ScopedTimer timer("Startup");
+			Log(LOG_INFO) << "Loading data...";
+			Options::updateMods();
+			game->loadMods();
+			Log(LOG_INFO) << "Data loaded successfully.";
+			Log(LOG_INFO) << "Loading language...";
+			game->loadLanguages();
+			Log(LOG_INFO) << "Language loaded successfully.";
+		}
 		loading = LOADING_SUCCESSFUL;
 	}
 	catch (std::exception &e)
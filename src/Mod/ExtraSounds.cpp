@@ -146,7 +146,7 @@ void ExtraSounds::loadSound(SoundSet *set, int index, const std::string &fileNam
 		Log(LOG_VERBOSE) << "Adding sound: " << index << ", using index: " << indexWithOffset;
 		sound = set->addSound(indexWithOffset);
 	}
-	sound->load(fileName);
+	sound->setFile(fileName);
 }
 
 }
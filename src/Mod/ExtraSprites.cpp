@@ -151,6 +151,15 @@ bool ExtraSprites::isLoaded() const
 	return _loaded;
 }
 
+/**
+ * Marks the sprite as not loaded, so it gets loaded again
+ * into a new target after the old one was freed.
+ */
+void ExtraSprites::resetLoaded()
+{
+	_loaded = false;
+}
+
 /**
  * Determines if an image file is an acceptable format for the game.
  * @param filename Image filename.
@@ -0,0 +1,184 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "../fmath.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Spatial index of things on the globe, eg. polygons or regions.
+ * The globe is split into cells of equal longitude and latitude and
+ * every cell keeps the things whose bounding box touch it, in the
+ * order they were added. Point queries only return things of one cell.
+ */
+template<typename T>
+class LonLatGrid
+{
+	static constexpr int CELLS_LON = 72;
+	static constexpr int CELLS_LAT = 36;
+	static constexpr double CELL_SIZE = 2 * M_PI / CELLS_LON;
+
+	std::vector<std::vector<T>> _cells;
+
+	/// Gets the column of a longitude, wrapped around the globe.
+	static int getColumn(double lon)
+	{
+		int x = (int)std::floor(lon / CELL_SIZE) % CELLS_LON;
+		return x < 0 ? x + CELLS_LON : x;
+	}
+	/// Gets the row of a latitude, clamped to the poles.
+	static int getRow(double lat)
+	{
+		return std::min(CELLS_LAT - 1, std::max(0, (int)std::floor((lat + M_PI / 2) / CELL_SIZE)));
+	}
+
+public:
+	/// Creates an empty grid.
+	LonLatGrid() : _cells(CELLS_LON * CELLS_LAT)
+	{
+	}
+
+	/// Removes everything from the grid.
+	void clear()
+	{
+		for (auto &cell : _cells)
+		{
+			cell.clear();
+		}
+	}
+
+	/**
+	 * Adds a thing covering a box of the globe.
+	 * @param value Thing to add.
+	 * @param lonMin Western edge, can be bigger than lonMax if the box crosses longitude 0.
+	 * @param lonMax Eastern edge.
+	 * @param latMin Southern edge.
+	 * @param latMax Northern edge.
+	 */
+	void addBox(const T &value, double lonMin, double lonMax, double latMin, double latMax)
+	{
+		int x1 = getColumn(lonMin);
+		int x2 = getColumn(lonMax);
+		int cols = (x2 - x1 + CELLS_LON) % CELLS_LON + 1;
+		if (lonMax - lonMin >= 2 * M_PI)
+		{
+			cols = CELLS_LON;
+		}
+		for (int y = getRow(latMin); y <= getRow(latMax); ++y)
+		{
+			for (int i = 0; i < cols; ++i)
+			{
+				auto &cell = _cells[y * CELLS_LON + (x1 + i) % CELLS_LON];
+				if (cell.empty() || cell.back() != value)
+				{
+					cell.push_back(value);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Adds a thing around a set of points on the globe, like the
+	 * corners of a polygon. The box is the smallest one containing
+	 * all points, grown by a margin on each side. If the points, in
+	 * order, go all the way around the globe, the outline encircles
+	 * a pole and the box is extended to it.
+	 * @param value Thing to add.
+	 * @param lon Longitudes of the points, in order along the outline.
+	 * @param lat Latitudes of the points.
+	 * @param margin Margin added around the points, in radians.
+	 */
+	void addPoints(const T &value, std::vector<double> lon, const std::vector<double> &lat, double margin)
+	{
+		if (lon.empty())
+		{
+			return;
+		}
+		double latMin = *std::min_element(lat.begin(), lat.end()) - margin;
+		double latMax = *std::max_element(lat.begin(), lat.end()) + margin;
+
+		// the longitudes span 360 degrees if the outline winds around a pole
+		double winding = 0, latSum = 0;
+		for (size_t i = 0; i < lon.size(); ++i)
+		{
+			double step = std::remainder(lon[(i + 1) % lon.size()] - lon[i], 2 * M_PI);
+			winding += step;
+			latSum += lat[i];
+		}
+		if (std::fabs(winding) > M_PI)
+		{
+			if (latSum >= 0)
+			{
+				latMax = M_PI / 2;
+			}
+			else
+			{
+				latMin = -M_PI / 2;
+			}
+		}
+
+		// the shortest longitude range is the one outside the biggest gap between points
+		for (auto &l : lon)
+		{
+			l = std::fmod(l, 2 * M_PI);
+			if (l < 0)
+			{
+				l += 2 * M_PI;
+			}
+		}
+		std::sort(lon.begin(), lon.end());
+		double gap = lon.front() + 2 * M_PI - lon.back();
+		double lonMin = lon.front(), lonMax = lon.back();
+		for (size_t i = 1; i < lon.size(); ++i)
+		{
+			if (lon[i] - lon[i - 1] > gap)
+			{
+				gap = lon[i] - lon[i - 1];
+				lonMin = lon[i];
+				lonMax = lon[i - 1];
+			}
+		}
+		if (latMin <= -M_PI / 2 || latMax >= M_PI / 2 || gap <= 2 * margin)
+		{
+			// around a pole every longitude is close
+			addBox(value, 0, 2 * M_PI, latMin, latMax);
+		}
+		else
+		{
+			addBox(value, lonMin - margin, lonMax + margin, latMin, latMax);
+		}
+	}
+
+	/**
+	 * Gets the things that can contain a point.
+	 * @param lon Longitude of the point.
+	 * @param lat Latitude of the point.
+	 * @return Candidates, in the order they were added.
+	 */
+	const std::vector<T> &get(double lon, double lat) const
+	{
+		return _cells[getRow(lat) * CELLS_LON + getColumn(lon)];
+	}
+};
+
+}
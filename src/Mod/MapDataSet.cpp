@@ -260,6 +260,7 @@ void MapDataSet::unloadData()
 		}
 		_objects.clear();
 		delete _surfaceSet;
+		_surfaceSet = 0;
 		_loaded = false;
 	}
 }
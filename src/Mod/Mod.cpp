@@ -25,6 +25,8 @@
 #include <cassert>
 #include "../Engine/CrossPlatform.h"
 #include "../Engine/FileMap.h"
+#include "../Engine/BinaryYaml.h"
+#include "../version.h"
 #include "../Engine/SDL2Helpers.h"
 #include "../Engine/Palette.h"
 #include "../Engine/Font.h"
@@ -42,6 +44,7 @@
 #include "../Engine/ShaderMove.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Logger.h"
+#include "../Engine/Profiler.h"
 #include "../Engine/ScriptBind.h"
 #include "../Engine/Collections.h"
 #include "SoundDefinition.h"
@@ -91,6 +94,7 @@
 #include "../Savegame/Country.h"
 #include "../Savegame/Soldier.h"
 #include "../Savegame/BattleUnit.h"
+#include "../Savegame/BattleItem.h"
 #include "../Savegame/Craft.h"
 #include "../Savegame/Transfer.h"
 #include "../Ufopaedia/Ufopaedia.h"
@@ -326,7 +330,7 @@ public:
  * Creates an empty mod.
  */
 Mod::Mod() :
-	_inventoryOverlapsPaperdoll(false),
+	_battlescapeLoaded(false), _inventoryOverlapsPaperdoll(false),
 	_maxViewDistance(20), _maxDarknessToSeeUnits(9), _maxStaticLightDistance(16), _maxDynamicLightDistance(24), _enhancedLighting(0),
 	_costHireEngineer(0), _costHireScientist(0),
 	_costEngineer(0), _costScientist(0), _timePersonnel(0), _initialFunding(0),
@@ -779,6 +783,10 @@ void Mod::lazyLoadSurface(const std::string &name)
  */
 Surface *Mod::getSurface(const std::string &name, bool error)
 {
+	if (!_battlescapeLoaded)
+	{
+		loadScopeResource(name);
+	}
 	lazyLoadSurface(name);
 	return getRule(name, "Sprite", _surfaces, error);
 }
@@ -790,10 +798,204 @@ Surface *Mod::getSurface(const std::string &name, bool error)
  */
 SurfaceSet *Mod::getSurfaceSet(const std::string &name, bool error)
 {
+	if (!_battlescapeLoaded)
+	{
+		loadScopeResource(name);
+	}
 	lazyLoadSurface(name);
 	return getRule(name, "Sprite Set", _sets, error);
 }
 
+/**
+ * Marks all the vanilla resources loaded so far that don't
+ * have a scope yet, so they can be released with it.
+ * @param scope Scope of the new resources.
+ */
+void Mod::markResourceScope(ResourceScope scope)
+{
+	for (const auto &i : _surfaces)
+	{
+		_resourceScopes.emplace(i.first, scope);
+	}
+	for (const auto &i : _sets)
+	{
+		_resourceScopes.emplace(i.first, scope);
+	}
+	for (const auto &i : _sounds)
+	{
+		_resourceScopes.emplace(i.first, scope);
+	}
+}
+
+/**
+ * Gets the scope of a resource. Resources that only
+ * come from mods are always global.
+ * @param name Name of the resource.
+ * @return Scope of the resource.
+ */
+ResourceScope Mod::getResourceScope(const std::string &name) const
+{
+	auto i = _resourceScopes.find(name);
+	if (i != _resourceScopes.end())
+	{
+		return i->second;
+	}
+	return RESOURCE_GLOBAL;
+}
+
+/**
+ * Loads a released battlescape resource again, along with any
+ * mod sprites added to it, so something outside of a battle
+ * can use it without loading all the others.
+ * @param name Name of the resource.
+ */
+void Mod::loadScopeResource(const std::string &name)
+{
+	auto loader = _scopeLoaders.find(name);
+	if (loader == _scopeLoaders.end() || _sets.find(name) != _sets.end() || _surfaces.find(name) != _surfaces.end())
+	{
+		return;
+	}
+	loader->second();
+
+	auto shared = _scopeSharedFrames.find(name);
+	if (shared != _scopeSharedFrames.end())
+	{
+		_sets[name]->setMaxSharedFrames(shared->second);
+	}
+	auto extra = _extraSprites.find(name);
+	if (!Options::lazyLoadResources && extra != _extraSprites.end())
+	{
+		for (auto *i : extra->second)
+		{
+			loadExtraSprite(i);
+		}
+	}
+	if (name == "UNIBORD.PCK")
+	{
+		modBattlescapeResources();
+	}
+}
+
+/**
+ * Loads all the battlescape resources that were released.
+ * Called when a battle starts.
+ */
+void Mod::loadBattlescapeScope()
+{
+	if (_battlescapeLoaded)
+	{
+		return;
+	}
+	_battlescapeLoaded = true;
+
+	Profiler::ScopedTimer timer("Battlescape resources");
+	for (const auto &i : _scopeLoaders)
+	{
+		loadScopeResource(i.first);
+	}
+	reportResourceMemory();
+}
+
+/**
+ * Releases the battlescape resources and terrain, so the geoscape
+ * doesn't keep them in memory between battles. The battlescape
+ * sound sets stay, only their decoded sounds are freed.
+ * Called whenever the battle is deleted.
+ */
+void Mod::unloadBattlescapeScope()
+{
+	if (!Options::oxceUnloadBattlescapeResources)
+	{
+		return;
+	}
+
+	// resources loaded one by one outside of a battle are released too
+	bool released = _battlescapeLoaded;
+	for (const auto &i : _resourceScopes)
+	{
+		if (i.second != RESOURCE_BATTLESCAPE)
+		{
+			continue;
+		}
+		auto set = _sets.find(i.first);
+		if (set != _sets.end())
+		{
+			_scopeSharedFrames[i.first] = set->second->getMaxSharedFrames();
+			delete set->second;
+			_sets.erase(set);
+			released = true;
+		}
+		auto surface = _surfaces.find(i.first);
+		if (surface != _surfaces.end())
+		{
+			delete surface->second;
+			_surfaces.erase(surface);
+			released = true;
+		}
+		auto sound = _sounds.find(i.first);
+		if (sound != _sounds.end())
+		{
+			sound->second->releaseSounds();
+		}
+		auto extra = _extraSprites.find(i.first);
+		if (extra != _extraSprites.end())
+		{
+			for (auto *j : extra->second)
+			{
+				j->resetLoaded();
+			}
+		}
+	}
+	// the battle unloads its own terrain, this catches any loaded outside of it
+	for (const auto &i : _mapDataSets)
+	{
+		i.second->unloadData();
+	}
+	_battlescapeLoaded = false;
+	if (released)
+	{
+		reportResourceMemory();
+	}
+}
+
+/**
+ * Writes the memory used by the pixels and samples
+ * of each resource scope to the log.
+ */
+void Mod::reportResourceMemory() const
+{
+	static const char *names[RESOURCE_SCOPE_MAX] = { "global", "geoscape", "battlescape", "terrain" };
+	size_t sizes[RESOURCE_SCOPE_MAX] = {};
+	for (const auto &i : _surfaces)
+	{
+		sizes[getResourceScope(i.first)] += (size_t)i.second->getPitch() * i.second->getHeight();
+	}
+	for (const auto &i : _sets)
+	{
+		sizes[getResourceScope(i.first)] += i.second->getMemorySize();
+	}
+	for (const auto &i : _sounds)
+	{
+		sizes[getResourceScope(i.first)] += i.second->getMemorySize();
+	}
+	for (const auto &i : _mapDataSets)
+	{
+		if (i.second->getSurfaceset())
+		{
+			sizes[RESOURCE_TERRAIN] += i.second->getSurfaceset()->getMemorySize();
+		}
+	}
+
+	std::ostringstream ss;
+	ss << "Resource memory:";
+	for (int i = 0; i < RESOURCE_SCOPE_MAX; ++i)
+	{
+		ss << " " << names[i] << " " << sizes[i] / 1024 << " KB";
+	}
+	Log(LOG_INFO) << ss.str();
+}
+
 /**
  * Returns a specific music from the mod.
  * @param name Name of the music.
@@ -965,6 +1167,69 @@ Sound *Mod::getSoundByDepth(unsigned int depth, unsigned int sound, bool error)
 		return getSound("BATTLE2.CAT", sound, error);
 }
 
+/**
+ * Decodes the sounds used by the armors and items of a battle
+ * ahead of time, so they don't stall the first shot or step.
+ * Stops when the sound cache is full.
+ * @param battle Battle about to start.
+ */
+void Mod::preloadBattleSounds(SavedBattleGame *battle) const
+{
+	if (!Options::oxceSoundPreload || Options::mute)
+	{
+		return;
+	}
+
+	std::set<int> sounds;
+	auto add = [&](const std::vector<int> &list)
+	{
+		sounds.insert(list.begin(), list.end());
+	};
+	for (auto *unit : *battle->getUnits())
+	{
+		const Armor *armor = unit->getArmor();
+		sounds.insert(armor->getMoveSound());
+		add(armor->getMaleDeathSounds());
+		add(armor->getFemaleDeathSounds());
+		add(armor->getMaleSelectUnitSounds());
+		add(armor->getFemaleSelectUnitSounds());
+		add(armor->getMaleStartMovingSounds());
+		add(armor->getFemaleStartMovingSounds());
+		add(armor->getMaleSelectWeaponSounds());
+		add(armor->getFemaleSelectWeaponSounds());
+		add(armor->getMaleAnnoyedSounds());
+		add(armor->getFemaleAnnoyedSounds());
+	}
+	for (auto *item : *battle->getItems())
+	{
+		const RuleItem *rule = item->getRules();
+		add(rule->getReloadSoundRaw());
+		add(rule->getFireSoundRaw());
+		add(rule->getHitSoundRaw());
+		add(rule->getHitMissSoundRaw());
+		add(rule->getMeleeSoundRaw());
+		add(rule->getMeleeMissSoundRaw());
+		add(rule->getMeleeHitSoundRaw());
+		add(rule->getExplosionHitSoundRaw());
+		add(rule->getPsiSoundRaw());
+		add(rule->getPsiMissSoundRaw());
+	}
+
+	Profiler::ScopedTimer timer("Battle sounds");
+	for (int i : sounds)
+	{
+		if (i < 0)
+		{
+			continue;
+		}
+		Sound *sound = getSoundByDepth(battle->getDepth(), i, false);
+		if (sound && !sound->preload())
+		{
+			break;
+		}
+	}
+}
+
 /**
  * Returns the list of color LUTs in the mod.
  * @return Pointer to the list of LUTs.
@@ -1616,6 +1881,7 @@ static void throwModOnErrorHelper(const std::string& modId, const std::string& e
  */
 void Mod::loadAll()
 {
+	Profiler::ScopedTimer timer("Mod::loadAll");
 	ModScript parser{ _scriptGlobal, this };
 	auto mods = FileMap::getRulesets();
 
@@ -1652,6 +1918,7 @@ void Mod::loadAll()
 	// load rulesets that can affect loading vanilla resources
 	for (size_t i = 0; _modData.size() > i; ++i)
 	{
+		Profiler::ScopedTimer modTimer("Resource config: " + _modData[i].name);
 		_modCurrent = &_modData.at(i);
 		//if (_modCurrent->info->isMaster())
 		{
@@ -1666,7 +1933,10 @@ void Mod::loadAll()
 	Log(LOG_INFO) << "Loading vanilla resources...";
 	// vanilla resources load
 	_modCurrent = &_modData.at(0);
-	loadVanillaResources();
+	{
+		Profiler::ScopedTimer vanillaTimer("Vanilla resources");
+		loadVanillaResources();
+	}
 	_surfaceOffsetBasebits = _sets["BASEBITS.PCK"]->getMaxSharedFrames();
 	_surfaceOffsetBigobs = _sets["BIGOBS.PCK"]->getMaxSharedFrames();
 	_surfaceOffsetFloorob = _sets["FLOOROB.PCK"]->getMaxSharedFrames();
@@ -1683,6 +1953,7 @@ void Mod::loadAll()
 	{
 		try
 		{
+			Profiler::ScopedTimer modTimer("Rulesets: " + mods[i].first);
 			_modCurrent = &_modData.at(i);
 			_scriptGlobal->setMod((int)_modCurrent->offset);
 			loadMod(mods[i].second, parser);
@@ -1738,19 +2009,36 @@ void Mod::loadAll()
 	}
 
 	// cross link rule objects
+	{
+		Profiler::ScopedTimer afterLoadTimer("Cross linking rules");
+		afterLoadHelper("research", this, _research, &RuleResearch::afterLoad);
+		afterLoadHelper("items", this, _items, &RuleItem::afterLoad);
+		afterLoadHelper("manufacture", this, _manufacture, &RuleManufacture::afterLoad);
+		afterLoadHelper("units", this, _units, &Unit::afterLoad);
+		afterLoadHelper("armors", this, _armors, &Armor::afterLoad);
+		afterLoadHelper("soldiers", this, _soldiers, &RuleSoldier::afterLoad);
+		afterLoadHelper("facilities", this, _facilities, &RuleBaseFacility::afterLoad);
+		afterLoadHelper("enviroEffects", this, _enviroEffects, &RuleEnviroEffects::afterLoad);
+		afterLoadHelper("commendations", this, _commendations, &RuleCommendations::afterLoad);
+		afterLoadHelper("skills", this, _skills, &RuleSkill::afterLoad);
+		afterLoadHelper("craftWeapons", this, _craftWeapons, &RuleCraftWeapon::afterLoad);
+		afterLoadHelper("countries", this, _countries, &RuleCountry::afterLoad);
+	}
 
-	afterLoadHelper("research", this, _research, &RuleResearch::afterLoad);
-	afterLoadHelper("items", this, _items, &RuleItem::afterLoad);
-	afterLoadHelper("manufacture", this, _manufacture, &RuleManufacture::afterLoad);
-	afterLoadHelper("units", this, _units, &Unit::afterLoad);
-	afterLoadHelper("armors", this, _armors, &Armor::afterLoad);
-	afterLoadHelper("soldiers", this, _soldiers, &RuleSoldier::afterLoad);
-	afterLoadHelper("facilities", this, _facilities, &RuleBaseFacility::afterLoad);
-	afterLoadHelper("enviroEffects", this, _enviroEffects, &RuleEnviroEffects::afterLoad);
-	afterLoadHelper("commendations", this, _commendations, &RuleCommendations::afterLoad);
-	afterLoadHelper("skills", this, _skills, &RuleSkill::afterLoad);
-	afterLoadHelper("craftWeapons", this, _craftWeapons, &RuleCraftWeapon::afterLoad);
-	afterLoadHelper("countries", this, _countries, &RuleCountry::afterLoad);
+	// dense indexes used by saved game to keep research state in bitsets and items in flat containers
+	{
+		int index = 0;
+		for (auto& r : _research)
+		{
+			r.second->setIndex(index++);
+		}
+		index = 0;
+		for (auto& i : _items)
+		{
+			i.second->setIndex(index++);
+			_itemsByIndexCache.push_back(i.second);
+		}
+	}
 
 	for (auto& a : _armors)
 	{
@@ -1869,8 +2157,12 @@ void Mod::loadAll()
 	Log(LOG_INFO) << "Loading ended.";
 
 	sortLists();
-	loadExtraResources();
+	{
+		Profiler::ScopedTimer extraTimer("Extra resources");
+		loadExtraResources();
+	}
 	modResources();
+	unloadBattlescapeScope();
 }
 
 /**
@@ -1881,17 +2173,16 @@ void Mod::loadAll()
  */
 void Mod::loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers)
 {
-	for (auto i = rulesetFiles.begin(); i != rulesetFiles.end(); ++i)
+	bool cached = false;
+	if (Options::oxceRulesetCache)
 	{
-		Log(LOG_VERBOSE) << "- " << i->fullpath;
-		try
-		{
-			loadFile(*i, parsers);
-		}
-		catch (YAML::Exception &e)
-		{
-			throw Exception(i->fullpath + ": " + std::string(e.what()));
-		}
+		Profiler::ScopedTimer timer("Ruleset cache");
+		cached = loadRulesetCache(rulesetFiles, parsers);
+	}
+	if (!cached)
+	{
+		Profiler::ScopedTimer timer("Ruleset parsing");
+		parseRulesets(rulesetFiles, parsers);
 	}
 
 	// these need to be validated, otherwise we're gonna get into some serious trouble down the line.
@@ -1952,6 +2243,190 @@ void Mod::loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScrip
 	}
 }
 
+/**
+ * Gets the ruleset cache file of the current mod, and the key describing
+ * the engine, the mod and the state of its ruleset files when the cache was made.
+ * @param rulesetFiles List of rulesets of the mod.
+ * @param key Receives the cache key.
+ * @return Full path to the cache file.
+ */
+std::string Mod::getRulesetCacheFile(const std::vector<FileMap::FileRecord> &rulesetFiles, std::string &key) const
+{
+	std::ostringstream ss;
+	ss << OPENXCOM_VERSION_SHORT << OPENXCOM_VERSION_GIT << " " << BinaryYaml::getFormatVersion() << "\n";
+	ss << _modCurrent->name << " " << _modCurrent->info->getVersion() << "\n";
+	for (auto i = rulesetFiles.begin(); i != rulesetFiles.end(); ++i)
+	{
+		ss << i->fullpath << " " << i->getStamp() << "\n";
+	}
+	key = ss.str();
+	return Options::getUserFolder() + "cache/" + CrossPlatform::sanitizeFilename(_modCurrent->name) + ".rulcache";
+}
+
+/**
+ * Loads the rulesets of the current mod from the ruleset cache,
+ * skipping the YAML parsing, if the cache is up to date.
+ * @param rulesetFiles List of rulesets to load.
+ * @param parsers Object with all available parsers.
+ * @return False if there's no valid cache and nothing was loaded.
+ */
+bool Mod::loadRulesetCache(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers)
+{
+	std::string key;
+	std::string cacheFile = getRulesetCacheFile(rulesetFiles, key);
+	if (!CrossPlatform::fileExists(cacheFile))
+	{
+		return false;
+	}
+	std::unique_ptr<BinaryYaml::FileReader> reader;
+	YAML::Node doc;
+	try
+	{
+		reader.reset(new BinaryYaml::FileReader(cacheFile));
+		if (!reader->read(doc) || doc["key"].as<std::string>("") != key)
+		{
+			Log(LOG_INFO) << "Ruleset cache of " << _modCurrent->name << " is out of date.";
+			return false;
+		}
+	}
+	catch (std::exception &e)
+	{
+		Log(LOG_WARNING) << cacheFile << ": " << e.what();
+		return false;
+	}
+
+	Uint32 start = SDL_GetTicks();
+	for (auto i = rulesetFiles.begin(); i != rulesetFiles.end(); ++i)
+	{
+		Log(LOG_VERBOSE) << "- " << i->fullpath << " (cached)";
+		try
+		{
+			if (!reader->read(doc))
+			{
+				throw Exception("truncated cache");
+			}
+		}
+		catch (Exception &e)
+		{
+			// some rules are applied already, so we can't fall back to parsing anymore
+			reader.reset();
+			CrossPlatform::deleteFile(cacheFile);
+			throw Exception(cacheFile + ": " + e.what() + "; the ruleset cache was deleted, please restart the game");
+		}
+		try
+		{
+			loadFile(doc, parsers);
+		}
+		catch (YAML::Exception &e)
+		{
+			throw Exception(i->fullpath + ": " + std::string(e.what()));
+		}
+	}
+	Log(LOG_INFO) << "Loaded " << rulesetFiles.size() << " ruleset files of " << _modCurrent->name << " from the cache in " << SDL_GetTicks() - start << " ms";
+	return true;
+}
+
+/**
+ * Parses and loads the rulesets of the current mod, and stores
+ * the parsed files in the ruleset cache for the next start.
+ * @param rulesetFiles List of rulesets to load.
+ * @param parsers Object with all available parsers.
+ */
+void Mod::parseRulesets(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers)
+{
+	std::unique_ptr<BinaryYaml::FileWriter> cache;
+	std::string key, cacheFile;
+	if (Options::oxceRulesetCache)
+	{
+		cacheFile = getRulesetCacheFile(rulesetFiles, key);
+		try
+		{
+			std::string cacheFolder = Options::getUserFolder() + "cache/";
+			if (!CrossPlatform::folderExists(cacheFolder))
+			{
+				CrossPlatform::createFolder(cacheFolder);
+			}
+			cache.reset(new BinaryYaml::FileWriter(cacheFile + ".tmp"));
+			YAML::Node header;
+			header["key"] = key;
+			cache->write(header, false);
+		}
+		catch (Exception &e)
+		{
+			Log(LOG_WARNING) << e.what();
+			cache.reset();
+		}
+	}
+
+	// parsing is independent per file, so a few files are parsed ahead
+	// on worker threads, but they are still applied in the original order
+	int threads = Options::oxceRulesetLoadThreads;
+	if (threads <= 0)
+	{
+#ifdef DINGOO
+		threads = 1;
+#else
+		threads = 4;
+#endif
+	}
+	static const Uint32 SLOW_RULESET_PARSE_TIME = 100;
+	const size_t batchSize = threads * 2;
+	Uint32 parseTime = 0;
+	for (size_t batch = 0; batch < rulesetFiles.size(); batch += batchSize)
+	{
+		std::vector<const FileMap::FileRecord *> files;
+		for (size_t i = batch; i < rulesetFiles.size() && i < batch + batchSize; ++i)
+		{
+			files.push_back(&rulesetFiles[i]);
+		}
+		std::vector<FileMap::ParsedYAML> docs;
+		{
+			Profiler::ScopedTimer timer("YAML parsing");
+			docs = FileMap::parseYAML(files, threads);
+		}
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			Log(LOG_VERBOSE) << "- " << files[i]->fullpath << " (parsed in " << docs[i].parseTime << " ms)";
+			if (docs[i].parseTime >= SLOW_RULESET_PARSE_TIME)
+			{
+				Log(LOG_INFO) << "Slow ruleset: " << files[i]->fullpath << " took " << docs[i].parseTime << " ms to parse";
+			}
+			parseTime += docs[i].parseTime;
+			if (!docs[i].error.empty())
+			{
+				Log(LOG_FATAL) << "Error loading file '" << files[i]->fullpath << "'";
+				throw Exception(files[i]->fullpath + ": " + docs[i].error);
+			}
+			if (cache)
+			{
+				cache->write(docs[i].doc, true);
+			}
+			try
+			{
+				Profiler::ScopedTimer timer("Ruleset loading");
+				loadFile(docs[i].doc, parsers);
+			}
+			catch (YAML::Exception &e)
+			{
+				throw Exception(files[i]->fullpath + ": " + std::string(e.what()));
+			}
+		}
+	}
+	Log(LOG_INFO) << "Parsed " << rulesetFiles.size() << " ruleset files of " << _modCurrent->name << " in " << parseTime << " ms (cpu time, " << threads << " threads)";
+
+	if (cache)
+	{
+		if (cache->close() && CrossPlatform::moveFile(cacheFile + ".tmp", cacheFile))
+		{
+			Log(LOG_INFO) << "Stored ruleset cache of " << _modCurrent->name;
+		}
+		else
+		{
+			CrossPlatform::deleteFile(cacheFile + ".tmp");
+		}
+	}
+}
+
 /**
  * Loads a ruleset from a YAML file that have basic resources configuration.
  * @param filename YAML filename.
@@ -2042,14 +2517,13 @@ void Mod::loadConstants(const YAML::Node &node)
 }
 
 /**
- * Loads a ruleset's contents from a YAML file.
+ * Loads a ruleset's contents from a parsed YAML file.
  * Rules that match pre-existing rules overwrite them.
- * @param filename YAML filename.
+ * @param doc Parsed YAML file.
  * @param parsers Object with all available parsers.
  */
-void Mod::loadFile(const FileMap::FileRecord &filerec, ModScript &parsers)
+void Mod::loadFile(YAML::Node doc, ModScript &parsers)
 {
-	auto doc = filerec.getYAML();
 
 	if (const YAML::Node &extended = doc["extended"])
 	{
@@ -2864,7 +3338,7 @@ T *Mod::loadRule(const YAML::Node &node, std::map<std::string, T*> *map, std::ve
  */
 SavedGame *Mod::newSave(GameDifficulty diff) const
 {
-	SavedGame *save = new SavedGame();
+	SavedGame *save = new SavedGame(this);
 	save->setDifficulty(diff);
 
 	// Add countries
@@ -4407,6 +4881,7 @@ void Mod::loadVanillaResources()
 	_sets["CustomArmorPreviews"] = new SurfaceSet(12, 20);
 	_sets["CustomItemPreviews"] = new SurfaceSet(12, 20);
 	_sets["TinyRanks"] = new SurfaceSet(7, 7);
+	markResourceScope(RESOURCE_GLOBAL);
 
 	// Load palettes
 	const char *pal[] = { "PAL_GEOSCAPE", "PAL_BASESCAPE", "PAL_GRAPHS", "PAL_UFOPAEDIA", "PAL_BATTLEPEDIA" };
@@ -4531,6 +5006,7 @@ void Mod::loadVanillaResources()
 
 	if (!Options::mute) // TBD: ain't it wrong? can Options::mute be reset without a reload?
 	{
+		Profiler::ScopedTimer timer("Vanilla sound sets");
 		// Load sounds
 		auto contents = FileMap::getVFolderContents("SOUND");
 		auto soundFiles = FileMap::filterFiles(contents, "CAT");
@@ -4562,8 +5038,7 @@ void Mod::loadVanillaResources()
 					if (FileMap::fileExists(fname))
 					{
 						Log(LOG_VERBOSE) << catsId[i] << ": loading sound "<<fname;
-						CatFile catfile(fname);
-						sound->loadCat(catfile);
+						sound->loadCat(std::make_shared<CatFile>(fname));
 						Options::currentSound = (wav) ? SOUND_14 : SOUND_10;
 						break;
 					} else {
@@ -4590,7 +5065,7 @@ void Mod::loadVanillaResources()
 				std::string fname = "SOUND/" + i.second->getCATFile();
 				if (FileMap::fileExists(fname))
 				{
-					CatFile catfile(fname);
+					auto catfile = std::make_shared<CatFile>(fname);
 					for (auto j : i.second->getSoundList())
 					{
 						_sounds[i.first]->loadCatByIndex(catfile, j, true);
@@ -4607,19 +5082,29 @@ void Mod::loadVanillaResources()
 		auto file = soundFiles.find("intro.cat");
 		if (file != soundFiles.end())
 		{
-			auto catfile = CatFile("SOUND/INTRO.CAT");
-			_sounds["INTRO.CAT"]->loadCat(catfile);
+			_sounds["INTRO.CAT"]->loadCat(std::make_shared<CatFile>("SOUND/INTRO.CAT"));
 		}
 
 		file = soundFiles.find("sample3.cat");
 		if (file != soundFiles.end())
 		{
-			auto catfile = CatFile("SOUND/SAMPLE3.CAT");
-			_sounds["SAMPLE3.CAT"]->loadCat(catfile);
+			_sounds["SAMPLE3.CAT"]->loadCat(std::make_shared<CatFile>("SOUND/SAMPLE3.CAT"));
 		}
 	}
 
-	loadBattlescapeResources(); // TODO load this at battlescape start, unload at battlescape end?
+	markResourceScope(RESOURCE_GEOSCAPE);
+
+	loadBattlescapePalettes();
+	loadBattlescapeResources();
+	// these are also used by the inventory and ufopaedia, so they stay
+	_resourceScopes["BIGOBS.PCK"] = RESOURCE_GLOBAL;
+	_resourceScopes["FLOOROB.PCK"] = RESOURCE_GLOBAL;
+	_resourceScopes["HANDOB.PCK"] = RESOURCE_GLOBAL;
+	// the battlescape sound sets stay too, only their decoded sounds are released
+	_resourceScopes["BATTLE.CAT"] = RESOURCE_BATTLESCAPE;
+	_resourceScopes["BATTLE2.CAT"] = RESOURCE_BATTLESCAPE;
+	markResourceScope(RESOURCE_BATTLESCAPE);
+	_battlescapeLoaded = true;
 
 
 	//update number of shared indexes in surface sets and sound sets
@@ -4694,51 +5179,11 @@ void Mod::loadVanillaResources()
 }
 
 /**
- * Loads the resources required by the Battlescape.
+ * Loads the battlescape palettes and the voxel data. Unlike the
+ * other battlescape resources, these are kept for the whole game.
  */
-void Mod::loadBattlescapeResources()
+void Mod::loadBattlescapePalettes()
 {
-	// Load Battlescape ICONS
-	_sets["SPICONS.DAT"] = new SurfaceSet(32, 24);
-	_sets["SPICONS.DAT"]->loadDat("UFOGRAPH/SPICONS.DAT");
-	_sets["CURSOR.PCK"] = new SurfaceSet(32, 40);
-	_sets["CURSOR.PCK"]->loadPck("UFOGRAPH/CURSOR.PCK", "UFOGRAPH/CURSOR.TAB");
-	_sets["SMOKE.PCK"] = new SurfaceSet(32, 40);
-	_sets["SMOKE.PCK"]->loadPck("UFOGRAPH/SMOKE.PCK", "UFOGRAPH/SMOKE.TAB");
-	_sets["HIT.PCK"] = new SurfaceSet(32, 40);
-	_sets["HIT.PCK"]->loadPck("UFOGRAPH/HIT.PCK", "UFOGRAPH/HIT.TAB");
-	_sets["X1.PCK"] = new SurfaceSet(128, 64);
-	_sets["X1.PCK"]->loadPck("UFOGRAPH/X1.PCK", "UFOGRAPH/X1.TAB");
-	_sets["MEDIBITS.DAT"] = new SurfaceSet(52, 58);
-	_sets["MEDIBITS.DAT"]->loadDat("UFOGRAPH/MEDIBITS.DAT");
-	_sets["DETBLOB.DAT"] = new SurfaceSet(16, 16);
-	_sets["DETBLOB.DAT"]->loadDat("UFOGRAPH/DETBLOB.DAT");
-	_sets["Projectiles"] = new SurfaceSet(3, 3);
-	_sets["UnderwaterProjectiles"] = new SurfaceSet(3, 3);
-
-	// Load Battlescape Terrain (only blanks are loaded, others are loaded just in time)
-	_sets["BLANKS.PCK"] = new SurfaceSet(32, 40);
-	_sets["BLANKS.PCK"]->loadPck("TERRAIN/BLANKS.PCK", "TERRAIN/BLANKS.TAB");
-
-	// Load Battlescape units
-	auto unitsContents = FileMap::getVFolderContents("UNITS");
-	auto usets = FileMap::filterFiles(unitsContents, "PCK");
-	for (auto i = usets.begin(); i != usets.end(); ++i)
-	{
-		std::string fname = *i;
-		std::transform(i->begin(), i->end(), fname.begin(), toupper);
-		if (fname != "BIGOBS.PCK")
-			_sets[fname] = new SurfaceSet(32, 40);
-		else
-			_sets[fname] = new SurfaceSet(32, 48);
-		_sets[fname]->loadPck("UNITS/" + *i, "UNITS/" + CrossPlatform::noExt(*i) + ".TAB");
-	}
-	// incomplete chryssalid set: 1.0 data: stop loading.
-	if (_sets.find("CHRYS.PCK") != _sets.end() && !_sets["CHRYS.PCK"]->getFrame(225))
-	{
-		Log(LOG_FATAL) << "Version 1.0 data detected";
-		throw Exception("Invalid CHRYS.PCK, please patch your X-COM data to the latest version");
-	}
 	// TFTD uses the loftemps dat from the terrain folder, but still has enemy unknown's version in the geodata folder, which is short by 2 entries.
 	auto terrainContents = FileMap::getVFolderContents("TERRAIN");
 	if (terrainContents.find("loftemps.dat") != terrainContents.end())
@@ -4750,14 +5195,6 @@ void Mod::loadBattlescapeResources()
 		MapDataSet::loadLOFTEMPS("GEODATA/LOFTEMPS.DAT", &_voxelData);
 	}
 
-	std::string scrs[] = { "TAC00.SCR" };
-
-	for (size_t i = 0; i < ARRAYLEN(scrs); ++i)
-	{
-		_surfaces[scrs[i]] = new Surface(320, 200);
-		_surfaces[scrs[i]]->loadScr("UFOGRAPH/" + scrs[i]);
-	}
-
 	// lower case so we can find them in the contents map
 	std::string lbms[] = { "d0.lbm",
 		"d1.lbm",
@@ -4795,6 +5232,85 @@ void Mod::loadBattlescapeResources()
 		createTransparencyLUT(_palettes[pals[i]]);
 		delete tempSurface;
 	}
+}
+
+/**
+ * Loads the resources required by the Battlescape. Each one gets
+ * a loader, so it can be loaded again after it was released.
+ */
+void Mod::loadBattlescapeResources()
+{
+	auto addDat = [this](const std::string &name, int width, int height, const std::string &file)
+	{
+		_scopeLoaders[name] = [=]()
+		{
+			_sets[name] = new SurfaceSet(width, height);
+			_sets[name]->loadDat(file);
+		};
+	};
+	auto addPck = [this](const std::string &name, int width, int height, const std::string &pck, const std::string &tab)
+	{
+		_scopeLoaders[name] = [=]()
+		{
+			_sets[name] = new SurfaceSet(width, height);
+			_sets[name]->loadPck(pck, tab);
+			if (Options::battleHairBleach)
+			{
+				bleachSoldierHair(name);
+			}
+		};
+	};
+	auto addEmpty = [this](const std::string &name, int width, int height)
+	{
+		_scopeLoaders[name] = [=]()
+		{
+			_sets[name] = new SurfaceSet(width, height);
+		};
+	};
+	auto addScreen = [this](const std::string &name, void (Surface::*load)(const std::string&), const std::string &file)
+	{
+		_scopeLoaders[name] = [=]()
+		{
+			_surfaces[name] = new Surface(320, 200);
+			(_surfaces[name]->*load)(file);
+		};
+	};
+
+	// Load Battlescape ICONS
+	addDat("SPICONS.DAT", 32, 24, "UFOGRAPH/SPICONS.DAT");
+	addPck("CURSOR.PCK", 32, 40, "UFOGRAPH/CURSOR.PCK", "UFOGRAPH/CURSOR.TAB");
+	addPck("SMOKE.PCK", 32, 40, "UFOGRAPH/SMOKE.PCK", "UFOGRAPH/SMOKE.TAB");
+	addPck("HIT.PCK", 32, 40, "UFOGRAPH/HIT.PCK", "UFOGRAPH/HIT.TAB");
+	addPck("X1.PCK", 128, 64, "UFOGRAPH/X1.PCK", "UFOGRAPH/X1.TAB");
+	addDat("MEDIBITS.DAT", 52, 58, "UFOGRAPH/MEDIBITS.DAT");
+	addDat("DETBLOB.DAT", 16, 16, "UFOGRAPH/DETBLOB.DAT");
+	addEmpty("Projectiles", 3, 3);
+	addEmpty("UnderwaterProjectiles", 3, 3);
+
+	// Load Battlescape Terrain (only blanks are loaded, others are loaded just in time)
+	addPck("BLANKS.PCK", 32, 40, "TERRAIN/BLANKS.PCK", "TERRAIN/BLANKS.TAB");
+
+	// Load Battlescape units
+	auto unitsContents = FileMap::getVFolderContents("UNITS");
+	auto usets = FileMap::filterFiles(unitsContents, "PCK");
+	for (auto i = usets.begin(); i != usets.end(); ++i)
+	{
+		std::string fname = *i;
+		std::transform(i->begin(), i->end(), fname.begin(), toupper);
+		if (fname != "BIGOBS.PCK")
+			addPck(fname, 32, 40, "UNITS/" + *i, "UNITS/" + CrossPlatform::noExt(*i) + ".TAB");
+		else
+			addPck(fname, 32, 48, "UNITS/" + *i, "UNITS/" + CrossPlatform::noExt(*i) + ".TAB");
+	}
+
+	std::string scrs[] = { "TAC00.SCR" };
+
+	for (size_t i = 0; i < ARRAYLEN(scrs); ++i)
+	{
+		addScreen(scrs[i], &Surface::loadScr, "UFOGRAPH/" + scrs[i]);
+	}
+
+	auto ufographContents = FileMap::getVFolderContents("UFOGRAPH");
 
 	std::string spks[] = { "TAC01.SCR",
 		"DETBORD.PCK",
@@ -4813,8 +5329,7 @@ void Mod::loadBattlescapeResources()
 			continue;
 		}
 
-		_surfaces[spks[i]] = new Surface(320, 200);
-		_surfaces[spks[i]]->loadSpk("UFOGRAPH/" + spks[i]);
+		addScreen(spks[i], &Surface::loadSpk, "UFOGRAPH/" + spks[i]);
 	}
 
 	auto bdys = FileMap::filterFiles(ufographContents, "BDY");
@@ -4835,8 +5350,7 @@ void Mod::loadBattlescapeResources()
 		{
 			idxName = idxName + "PCK";
 		}
-		_surfaces[idxName] = new Surface(320, 200);
-		_surfaces[idxName]->loadBdy("UFOGRAPH/" + *i);
+		addScreen(idxName, &Surface::loadBdy, "UFOGRAPH/" + *i);
 	}
 
 	// Load Battlescape inventory
@@ -4845,139 +5359,154 @@ void Mod::loadBattlescapeResources()
 	{
 		std::string fname = *i;
 		std::transform(i->begin(), i->end(), fname.begin(), toupper);
-		_surfaces[fname] = new Surface(320, 200);
-		_surfaces[fname]->loadSpk("UFOGRAPH/" + fname);
+		addScreen(fname, &Surface::loadSpk, "UFOGRAPH/" + fname);
 	}
 
-	//"fix" of color index in original solders sprites
-	if (Options::battleHairBleach)
+	for (const auto &i : _scopeLoaders)
 	{
-		std::string name;
+		i.second();
+	}
 
-		//personal armor
-		name = "XCOM_1.PCK";
-		if (_sets.find(name) != _sets.end())
+	// incomplete chryssalid set: 1.0 data: stop loading.
+	if (_sets.find("CHRYS.PCK") != _sets.end() && !_sets["CHRYS.PCK"]->getFrame(225))
+	{
+		Log(LOG_FATAL) << "Version 1.0 data detected";
+		throw Exception("Invalid CHRYS.PCK, please patch your X-COM data to the latest version");
+	}
+}
+
+/**
+ * "Fixes" the color indexes in the original soldier sprites,
+ * if the set is one of them.
+ * @param setName Name of the surface set.
+ */
+void Mod::bleachSoldierHair(const std::string &setName)
+{
+	std::string name;
+
+	//personal armor
+	name = "XCOM_1.PCK";
+	if (name == setName)
+	{
+		SurfaceSet *xcom_1 = _sets[name];
+
+		for (int i = 0; i < 8; ++i)
+		{
+			//chest frame
+			Surface *surf = xcom_1->getFrame(4 * 8 + i);
+			ShaderMove<Uint8> head = ShaderMove<Uint8>(surf);
+			GraphSubset dim = head.getBaseDomain();
+			surf->lock();
+			dim.beg_y = 6;
+			dim.end_y = 9;
+			head.setDomain(dim);
+			ShaderDraw<HairXCOM1>(head, ShaderScalar<Uint8>(HairXCOM1::Face + 5));
+			dim.beg_y = 9;
+			dim.end_y = 10;
+			head.setDomain(dim);
+			ShaderDraw<HairXCOM1>(head, ShaderScalar<Uint8>(HairXCOM1::Face + 6));
+			surf->unlock();
+		}
+
+		for (int i = 0; i < 3; ++i)
 		{
-			SurfaceSet *xcom_1 = _sets[name];
+			//fall frame
+			Surface *surf = xcom_1->getFrame(264 + i);
+			ShaderMove<Uint8> head = ShaderMove<Uint8>(surf);
+			GraphSubset dim = head.getBaseDomain();
+			dim.beg_y = 0;
+			dim.end_y = 24;
+			dim.beg_x = 11;
+			dim.end_x = 20;
+			head.setDomain(dim);
+			surf->lock();
+			ShaderDraw<HairXCOM1>(head, ShaderScalar<Uint8>(HairXCOM1::Face + 6));
+			surf->unlock();
+		}
+	}
 
-			for (int i = 0; i < 8; ++i)
+	//all TFTD armors
+	name = "TDXCOM_?.PCK";
+	for (int j = 0; j < 3; ++j)
+	{
+		name[7] = '0' + j;
+		if (name == setName)
+		{
+			SurfaceSet *xcom_2 = _sets[name];
+			for (int i = 0; i < 16; ++i)
 			{
-				//chest frame
-				Surface *surf = xcom_1->getFrame(4 * 8 + i);
-				ShaderMove<Uint8> head = ShaderMove<Uint8>(surf);
-				GraphSubset dim = head.getBaseDomain();
+				//chest frame without helm
+				Surface *surf = xcom_2->getFrame(262 + i);
 				surf->lock();
-				dim.beg_y = 6;
-				dim.end_y = 9;
-				head.setDomain(dim);
-				ShaderDraw<HairXCOM1>(head, ShaderScalar<Uint8>(HairXCOM1::Face + 5));
-				dim.beg_y = 9;
-				dim.end_y = 10;
-				head.setDomain(dim);
-				ShaderDraw<HairXCOM1>(head, ShaderScalar<Uint8>(HairXCOM1::Face + 6));
+				if (i < 8)
+				{
+					//female chest frame
+					ShaderMove<Uint8> head = ShaderMove<Uint8>(surf);
+					GraphSubset dim = head.getBaseDomain();
+					dim.beg_y = 6;
+					dim.end_y = 18;
+					head.setDomain(dim);
+					ShaderDraw<HairXCOM2>(head);
+
+					if (j == 2)
+					{
+						//fix some pixels in ION armor that was overwrite by previous function
+						if (i == 0)
+						{
+							surf->setPixel(18, 14, 16);
+						}
+						else if (i == 3)
+						{
+							surf->setPixel(19, 12, 20);
+						}
+						else if (i == 6)
+						{
+							surf->setPixel(13, 14, 16);
+						}
+					}
+				}
+
+				//we change face to pink, to prevent mixup with ION armor backpack that have same color group.
+				ShaderDraw<FaceXCOM2>(ShaderMove<Uint8>(surf));
 				surf->unlock();
 			}
 
-			for (int i = 0; i < 3; ++i)
+			for (int i = 0; i < 2; ++i)
 			{
-				//fall frame
-				Surface *surf = xcom_1->getFrame(264 + i);
+				//fall frame (first and second)
+				Surface *surf = xcom_2->getFrame(256 + i);
+				surf->lock();
+
 				ShaderMove<Uint8> head = ShaderMove<Uint8>(surf);
 				GraphSubset dim = head.getBaseDomain();
 				dim.beg_y = 0;
-				dim.end_y = 24;
-				dim.beg_x = 11;
-				dim.end_x = 20;
+				if (j == 3)
+				{
+					dim.end_y = 11 + 5 * i;
+				}
+				else
+				{
+					dim.end_y = 17;
+				}
 				head.setDomain(dim);
-				surf->lock();
-				ShaderDraw<HairXCOM1>(head, ShaderScalar<Uint8>(HairXCOM1::Face + 6));
+				ShaderDraw<FallXCOM2>(head);
+
+				//we change face to pink, to prevent mixup with ION armor backpack that have same color group.
+				ShaderDraw<FaceXCOM2>(ShaderMove<Uint8>(surf));
 				surf->unlock();
 			}
-		}
 
-		//all TFTD armors
-		name = "TDXCOM_?.PCK";
-		for (int j = 0; j < 3; ++j)
-		{
-			name[7] = '0' + j;
-			if (_sets.find(name) != _sets.end())
+			//Palette fix for ION armor
+			if (j == 2)
 			{
-				SurfaceSet *xcom_2 = _sets[name];
-				for (int i = 0; i < 16; ++i)
+				int size = xcom_2->getTotalFrames();
+				for (int i = 0; i < size; ++i)
 				{
-					//chest frame without helm
-					Surface *surf = xcom_2->getFrame(262 + i);
+					Surface *surf = xcom_2->getFrame(i);
 					surf->lock();
-					if (i < 8)
-					{
-						//female chest frame
-						ShaderMove<Uint8> head = ShaderMove<Uint8>(surf);
-						GraphSubset dim = head.getBaseDomain();
-						dim.beg_y = 6;
-						dim.end_y = 18;
-						head.setDomain(dim);
-						ShaderDraw<HairXCOM2>(head);
-
-						if (j == 2)
-						{
-							//fix some pixels in ION armor that was overwrite by previous function
-							if (i == 0)
-							{
-								surf->setPixel(18, 14, 16);
-							}
-							else if (i == 3)
-							{
-								surf->setPixel(19, 12, 20);
-							}
-							else if (i == 6)
-							{
-								surf->setPixel(13, 14, 16);
-							}
-						}
-					}
-
-					//we change face to pink, to prevent mixup with ION armor backpack that have same color group.
-					ShaderDraw<FaceXCOM2>(ShaderMove<Uint8>(surf));
+					ShaderDraw<BodyXCOM2>(ShaderMove<Uint8>(surf));
 					surf->unlock();
 				}
-
-				for (int i = 0; i < 2; ++i)
-				{
-					//fall frame (first and second)
-					Surface *surf = xcom_2->getFrame(256 + i);
-					surf->lock();
-
-					ShaderMove<Uint8> head = ShaderMove<Uint8>(surf);
-					GraphSubset dim = head.getBaseDomain();
-					dim.beg_y = 0;
-					if (j == 3)
-					{
-						dim.end_y = 11 + 5 * i;
-					}
-					else
-					{
-						dim.end_y = 17;
-					}
-					head.setDomain(dim);
-					ShaderDraw<FallXCOM2>(head);
-
-					//we change face to pink, to prevent mixup with ION armor backpack that have same color group.
-					ShaderDraw<FaceXCOM2>(ShaderMove<Uint8>(surf));
-					surf->unlock();
-				}
-
-				//Palette fix for ION armor
-				if (j == 2)
-				{
-					int size = xcom_2->getTotalFrames();
-					for (int i = 0; i < size; ++i)
-					{
-						Surface *surf = xcom_2->getFrame(i);
-						surf->lock();
-						ShaderDraw<BodyXCOM2>(ShaderMove<Uint8>(surf));
-						surf->unlock();
-					}
-				}
 			}
 		}
 	}
@@ -5073,6 +5602,7 @@ void Mod::loadExtraResources()
 			{
 				set = j->second;
 			}
+			Profiler::ScopedTimer timer("Extra sounds: " + soundPack->getModOwner()->name);
 			_sounds[setName] = soundPack->loadSoundSet(set);
 		}
 	}
@@ -5167,6 +5697,8 @@ void Mod::loadExtraSprite(ExtraSprites *spritePack)
 	if (spritePack->isLoaded())
 		return;
 
+	Profiler::ScopedTimer timer("Extra sprites: " + spritePack->getModOwner()->name);
+
 	if (spritePack->getSingleImage())
 	{
 		Surface *surface = 0;
@@ -5216,7 +5748,6 @@ void Mod::modResources()
 	getSurface("BACK07.SCR");
 	getSurface("ALTBACK07.SCR", false);
 	getSurface("BACK06.SCR");
-	getSurface("UNIBORD.PCK");
 	getSurfaceSet("HANDOB.PCK");
 	getSurfaceSet("FLOOROB.PCK");
 	getSurfaceSet("BIGOBS.PCK");
@@ -5287,6 +5818,18 @@ void Mod::modResources()
 			}
 	}
 
+	modBattlescapeResources();
+}
+
+/**
+ * Applies necessary modifications to vanilla battlescape resources,
+ * every time they're loaded.
+ */
+void Mod::modBattlescapeResources()
+{
+	// we're gonna need these
+	getSurface("UNIBORD.PCK");
+
 	// now, let's adjust the battlescape info screen.
 	int startHere = _manaEnabled ? 191 : 190;
 	int stopHere = _manaEnabled ? 28 : 37;
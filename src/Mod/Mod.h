@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <map>
+#include <functional>
 #include <vector>
 #include <string>
 #include <bitset>
@@ -48,6 +49,7 @@ class GMCatFile;
 class Music;
 class Palette;
 class SavedGame;
+class SavedBattleGame;
 class Soldier;
 class RuleCountry;
 class RuleRegion;
@@ -105,6 +107,13 @@ struct StatAdjustment;
 
 enum GameDifficulty : int;
 
+/**
+ * Lifetime of a vanilla resource: battlescape resources are only
+ * kept in memory while a battle needs them, terrain ones while
+ * their battle is loaded, the rest for the whole game.
+ */
+enum ResourceScope { RESOURCE_GLOBAL, RESOURCE_GEOSCAPE, RESOURCE_BATTLESCAPE, RESOURCE_TERRAIN, RESOURCE_SCOPE_MAX };
+
 /**
  * Mod data used when loading resources
  */
@@ -148,6 +157,13 @@ private:
 	std::map<std::string, SurfaceSet*> _sets;
 	std::map<std::string, SoundSet*> _sounds;
 	std::map<std::string, Music*> _musics;
+	/// Scope of the vanilla resources that aren't global, by name.
+	std::map<std::string, ResourceScope> _resourceScopes;
+	/// How to load each battlescape resource again after it was released.
+	std::map<std::string, std::function<void()> > _scopeLoaders;
+	/// Shared frames of the battlescape sets, kept while they're released.
+	std::map<std::string, int> _scopeSharedFrames;
+	bool _battlescapeLoaded;
 	std::vector<Uint16> _voxelData;
 	std::vector<std::vector<Uint8> > _transparencyLUTs;
 
@@ -286,6 +302,7 @@ private:
 	std::vector<const Armor*> _armorsForSoldiersCache;
 	std::vector<const RuleItem*> _armorStorageItemsCache;
 	std::vector<const RuleItem*> _craftWeaponStorageItemsCache;
+	std::vector<RuleItem*> _itemsByIndexCache;
 
 	size_t _surfaceOffsetBigobs = 0;
 	size_t _surfaceOffsetFloorob = 0;
@@ -300,7 +317,7 @@ private:
 	void loadResourceConfigFile(const FileMap::FileRecord &filerec);
 	void loadConstants(const YAML::Node &node);
 	/// Loads a ruleset from a YAML file.
-	void loadFile(const FileMap::FileRecord &filerec, ModScript &parsers);
+	void loadFile(YAML::Node doc, ModScript &parsers);
 	/// Loads a ruleset element.
 	template <typename T>
 	T *loadRule(const YAML::Node &node, std::map<std::string, T*> *map, std::vector<std::string> *index = 0, const std::string &key = "type") const;
@@ -313,12 +330,28 @@ private:
 	SoundSet *getSoundSet(const std::string &name, bool error = true) const;
 	/// Loads battlescape specific resources.
 	void loadBattlescapeResources();
+	/// Loads battlescape specific palettes and voxel data.
+	void loadBattlescapePalettes();
+	/// Fixes the hair colors of a soldier sprite set.
+	void bleachSoldierHair(const std::string &setName);
+	/// Loads a battlescape resource again, if it was released.
+	void loadScopeResource(const std::string &name);
+	/// Marks the vanilla resources without a scope yet.
+	void markResourceScope(ResourceScope scope);
+	/// Gets the scope of a resource.
+	ResourceScope getResourceScope(const std::string &name) const;
 	/// Loads a specified music file.
 	Music* loadMusic(MusicFormat fmt, const std::string& file, size_t track, float volume, CatFile* adlibcat, CatFile* aintrocat, GMCatFile* gmcat) const;
 	/// Creates a transparency lookup table for a given palette.
 	void createTransparencyLUT(Palette *pal);
 	/// Loads a specified mod content.
 	void loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers);
+	/// Gets the ruleset cache file of the current mod.
+	std::string getRulesetCacheFile(const std::vector<FileMap::FileRecord> &rulesetFiles, std::string &key) const;
+	/// Loads the rulesets of the current mod from the cache.
+	bool loadRulesetCache(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers);
+	/// Parses the rulesets of the current mod and caches them.
+	void parseRulesets(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers);
 	/// Loads resources from vanilla.
 	void loadVanillaResources();
 	/// Loads resources from extra rulesets.
@@ -329,6 +362,8 @@ private:
 	void loadExtraSprite(ExtraSprites *spritePack);
 	/// Applies mods to vanilla resources.
 	void modResources();
+	/// Applies mods to vanilla battlescape resources.
+	void modBattlescapeResources();
 	/// Sorts all our lists according to their weight.
 	void sortLists();
 public:
@@ -394,6 +429,12 @@ public:
 	Surface *getSurface(const std::string &name, bool error = true);
 	/// Gets a particular surface set.
 	SurfaceSet *getSurfaceSet(const std::string &name, bool error = true);
+	/// Loads the battlescape resources, if they were released.
+	void loadBattlescapeScope();
+	/// Releases the battlescape resources until they're needed again.
+	void unloadBattlescapeScope();
+	/// Writes the memory used by each resource scope to the log.
+	void reportResourceMemory() const;
 	/// Gets a particular music.
 	Music *getMusic(const std::string &name, bool error = true) const;
 	/// Gets the available music tracks.
@@ -410,6 +451,8 @@ public:
 	std::vector<Uint16> *getVoxelData();
 	/// Returns a specific sound from either the land or underwater sound set.
 	Sound *getSoundByDepth(unsigned int depth, unsigned int sound, bool error = true) const;
+	/// Decodes the sounds used by the armors and items of a battle.
+	void preloadBattleSounds(SavedBattleGame *battle) const;
 	/// Gets list of LUT data.
 	const std::vector<std::vector<Uint8> > *getLUTs() const;
 
@@ -573,6 +616,8 @@ public:
 	RuleItem *getItem(const std::string &id, bool error = false) const;
 	/// Gets the available items.
 	const std::vector<std::string> &getItemsList() const;
+	/// Gets all items ordered by their index.
+	const std::vector<RuleItem*> &getItemsByIndex() const { return _itemsByIndexCache; }
 	/// Gets the ruleset for a UFO type.
 	RuleUfo *getUfo(const std::string &id, bool error = false) const;
 	/// Gets the available UFOs.
@@ -33,7 +33,7 @@ namespace OpenXcom
 /**
  * Creates a blank ruleset for globe contents.
  */
-RuleGlobe::RuleGlobe()
+RuleGlobe::RuleGlobe() : _polygonGridValid(false)
 {
 }
 
@@ -69,6 +69,7 @@ void RuleGlobe::load(const YAML::Node &node)
 			delete *i;
 		}
 		_polygons.clear();
+		_polygonGridValid = false;
 		loadDat(node["data"].as<std::string>());
 	}
 	if (node["polygons"])
@@ -78,6 +79,7 @@ void RuleGlobe::load(const YAML::Node &node)
 			delete *i;
 		}
 		_polygons.clear();
+		_polygonGridValid = false;
 		for (YAML::const_iterator i = node["polygons"].begin(); i != node["polygons"].end(); ++i)
 		{
 			Polygon *polygon = new Polygon(3);
@@ -148,6 +150,62 @@ std::list<Polygon*> *RuleGlobe::getPolygons()
 	return &_polygons;
 }
 
+/**
+ * Returns the polygons that can contain a point, in the same
+ * order as the list of polygons. Points are only tested against
+ * polygons near them instead of every polygon in the globe.
+ * @param lon Longitude of the point.
+ * @param lat Latitude of the point.
+ * @return Candidate polygons.
+ */
+const std::vector<Polygon*> &RuleGlobe::getPolygonsNear(double lon, double lat)
+{
+	if (!_polygonGridValid)
+	{
+		buildPolygonGrid();
+	}
+	return _polygonGrid.get(lon, lat);
+}
+
+/**
+ * Adds every polygon to the spatial index with a box around its edges.
+ * Edges are sampled along their arc since they can bend away
+ * from the straight line between their corners in longitude and latitude.
+ */
+void RuleGlobe::buildPolygonGrid()
+{
+	const int edgeSamples = 4;
+	std::vector<double> lon, lat;
+	_polygonGrid.clear();
+	for (std::list<Polygon*>::iterator i = _polygons.begin(); i != _polygons.end(); ++i)
+	{
+		lon.clear();
+		lat.clear();
+		int points = (*i)->getPoints();
+		for (int j = 0; j < points; ++j)
+		{
+			int k = (j + 1) % points;
+			double x1 = cos((*i)->getLatitude(j)) * cos((*i)->getLongitude(j));
+			double y1 = cos((*i)->getLatitude(j)) * sin((*i)->getLongitude(j));
+			double z1 = sin((*i)->getLatitude(j));
+			double x2 = cos((*i)->getLatitude(k)) * cos((*i)->getLongitude(k));
+			double y2 = cos((*i)->getLatitude(k)) * sin((*i)->getLongitude(k));
+			double z2 = sin((*i)->getLatitude(k));
+			for (int s = 0; s < edgeSamples; ++s)
+			{
+				double t = (double)s / edgeSamples;
+				double x = x1 + (x2 - x1) * t;
+				double y = y1 + (y2 - y1) * t;
+				double z = z1 + (z2 - z1) * t;
+				lon.push_back(atan2(y, x));
+				lat.push_back(atan2(z, sqrt(x * x + y * y)));
+			}
+		}
+		_polygonGrid.addPoints(*i, lon, lat, Deg2Rad(5.0));
+	}
+	_polygonGridValid = true;
+}
+
 /**
  * Returns the list of polylines in the globe.
  * @return Pointer to the list of polylines.
@@ -201,6 +259,7 @@ void RuleGlobe::loadDat(const std::string &filename)
 
 		_polygons.push_back(poly);
 	}
+	_polygonGridValid = false;
 
 	if (!mapFile->eof())
 	{
@@ -20,6 +20,7 @@
 #include <list>
 #include <string>
 #include <yaml-cpp/yaml.h>
+#include "LonLatGrid.h"
 
 namespace OpenXcom
 {
@@ -39,6 +40,11 @@ private:
 	std::list<Polygon*> _polygons;
 	std::list<Polyline*> _polylines;
 	std::map<int, Texture*> _textures;
+	LonLatGrid<Polygon*> _polygonGrid;
+	bool _polygonGridValid;
+
+	/// Fills the spatial index of world polygons.
+	void buildPolygonGrid();
 public:
 	/// Creates a blank globe ruleset.
 	RuleGlobe();
@@ -48,6 +54,8 @@ public:
 	void load(const YAML::Node& node);
 	/// Gets the list of world polygons.
 	std::list<Polygon*> *getPolygons();
+	/// Gets the world polygons that can contain a point.
+	const std::vector<Polygon*> &getPolygonsNear(double lon, double lat);
 	/// Gets the list of world polylines.
 	std::list<Polyline*> *getPolylines();
 	/// Loads a set of polygons from a DAT file.
@@ -53,6 +53,7 @@ class RuleResearch
 	std::map<const RuleResearch*, std::vector<const RuleResearch*> > _getOneFreeProtected;
 	bool _needItem, _destroyItem;
 	int _listOrder;
+	int _index;
 
 	ScriptValues<RuleResearch> _scriptValues;
 public:
@@ -103,6 +104,10 @@ public:
 	RuleBaseFacilityFunctions getRequireBaseFunc() const { return _requiresBaseFunc; }
 	/// Gets the list weight for this research item.
 	int getListOrder() const;
+	/// Gets the dense index of this research, same order as names.
+	int getIndex() const { return _index; }
+	/// Sets the dense index of this research.
+	void setIndex(int index) { _index = index; }
 	/// Gets the cutscene to play when this item is researched
 	const std::string & getCutscene() const;
 	/// Gets the item to spawn in the base stores when this topic is researched.
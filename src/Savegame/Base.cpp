@@ -56,7 +56,7 @@ namespace OpenXcom
  */
 Base::Base(const Mod *mod) : Target(), _mod(mod), _scientists(0), _engineers(0), _inBattlescape(false), _retaliationTarget(false), _fakeUnderwater(false)
 {
-	_items = new ItemContainer();
+	_items = new ItemContainer(_mod);
 }
 
 /**
@@ -126,7 +126,7 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 		std::string type = (*i)["type"].as<std::string>();
 		if (_mod->getCraft(type))
 		{
-			Craft *c = new Craft(_mod->getCraft(type), this);
+			Craft *c = new Craft(_mod->getCraft(type), _mod, this);
 			c->load(*i, _mod->getScriptGlobal(), _mod, save);
 			_crafts.push_back(c);
 		}
@@ -164,20 +164,8 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 		}
 	}
 
+	// Some old saves have bad items, the container skips them to avoid further bugs
 	_items->load(node["items"]);
-	// Some old saves have bad items, better get rid of them to avoid further bugs
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end();)
-	{
-		if (_mod->getItem(i->first) == 0)
-		{
-			Log(LOG_ERROR) << "Failed to load item " << i->first;
-			_items->getContents()->erase(i++);
-		}
-		else
-		{
-			++i;
-		}
-	}
 
 	_scientists = node["scientists"].as<int>(_scientists);
 	_engineers = node["engineers"].as<int>(_engineers);
@@ -678,9 +666,9 @@ int Base::getTotalOtherStaffAndInventoryCost(int& staffCount, int& inventoryCoun
 			}
 		}
 	}
-	for (const auto& storeItem : *_items->getContents())
+	for (const auto& storeItem : _items->getContents())
 	{
-		auto ruleItem = _mod->getItem(storeItem.first, true);
+		auto ruleItem = storeItem.first;
 		if (ruleItem->getMonthlySalary() != 0)
 		{
 			staffCount += storeItem.second;
@@ -694,9 +682,9 @@ int Base::getTotalOtherStaffAndInventoryCost(int& staffCount, int& inventoryCoun
 	}
 	for (auto craft : _crafts)
 	{
-		for (const auto &craftItem : *craft->getItems()->getContents())
+		for (const auto &craftItem : craft->getItems()->getContents())
 		{
-			auto ruleItem = _mod->getItem(craftItem.first, true);
+			auto ruleItem = craftItem.first;
 			if (ruleItem->getMonthlySalary() != 0)
 			{
 				staffCount += craftItem.second;
@@ -1425,12 +1413,12 @@ int Base::getUsedContainment(int prisonType) const
 {
 	int total = 0;
 	RuleItem *rule = 0;
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end(); ++i)
+	for (auto& i : _items->getContents())
 	{
-		rule = _mod->getItem((i)->first, true);
+		rule = i.first;
 		if (rule->isAlien() && rule->getPrisonType() == prisonType)
 		{
-			total += (i)->second;
+			total += i.second;
 		}
 	}
 	for (std::vector<Transfer*>::const_iterator i = _transfers.begin(); i != _transfers.end(); ++i)
@@ -1577,12 +1565,12 @@ void Base::setupDefenses()
 	}
 
 	// add vehicles left on the base
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end(); )
+	// iterate over a snapshot, quantities are re-read because vehicles can share ammo
+	for (auto& i : _items->getContents())
 	{
-		std::string itemId = (i)->first;
-		int itemQty = (i)->second;
-		RuleItem *rule = _mod->getItem(itemId, true);
-		if (rule->getVehicleUnit())
+		RuleItem *rule = i.first;
+		int itemQty = _items->getItem(rule);
+		if (rule->getVehicleUnit() && itemQty > 0)
 		{
 			int size = rule->getVehicleUnit()->getArmor()->getTotalSize();
 			if (rule->getVehicleClipAmmo() == nullptr) // so this vehicle does not need ammo
@@ -1593,7 +1581,7 @@ void Base::setupDefenses()
 					_vehicles.push_back(vehicle);
 					_vehiclesFromBase.push_back(vehicle);
 				}
-				_items->removeItem(itemId, itemQty);
+				_items->removeItem(rule, itemQty);
 			}
 			else // so this vehicle needs ammo
 			{
@@ -1603,7 +1591,6 @@ void Base::setupDefenses()
 				int baseQty = _items->getItem(ammo) / ammoPerVehicle;
 				if (!baseQty)
 				{
-					++i;
 					continue;
 				}
 				int canBeAdded = std::min(itemQty, baseQty);
@@ -1614,12 +1601,9 @@ void Base::setupDefenses()
 					_vehiclesFromBase.push_back(vehicle);
 					_items->removeItem(ammo, ammoPerVehicle);
 				}
-				_items->removeItem(itemId, canBeAdded);
+				_items->removeItem(rule, canBeAdded);
 			}
-
-			i = _items->getContents()->begin(); // we have to start over because iterator is broken because of the removeItem
 		}
-		else ++i;
 	}
 }
 
@@ -1857,12 +1841,11 @@ void Base::destroyFacility(std::vector<BaseFacility*>::iterator facility)
 			}
 
 			// remove all items
-			while (!(*facility)->getCraftForDrawing()->getItems()->getContents()->empty())
+			for (auto& i : (*facility)->getCraftForDrawing()->getItems()->getContents())
 			{
-				std::map<std::string, int>::iterator i = (*facility)->getCraftForDrawing()->getItems()->getContents()->begin();
-				_items->addItem(i->first, i->second);
-				(*facility)->getCraftForDrawing()->getItems()->removeItem(i->first, i->second);
+				_items->addItem(i.first, i.second);
 			}
+			(*facility)->getCraftForDrawing()->getItems()->clear();
 			Collections::deleteIf(_crafts, 1,
 				[&](Craft* c)
 				{
@@ -32,6 +32,7 @@
 #include "../Engine/Script.h"
 #include "../Engine/ScriptBind.h"
 #include "../Engine/RNG.h"
+#include "../Battlescape/SpriteCache.h"
 #include "../fmath.h"
 
 namespace OpenXcom
@@ -1618,4 +1619,28 @@ void BattleItem::ScriptFill(ScriptWorkerBlit* w, BattleItem* item, int part, int
 	}
 }
 
+/**
+ * Hashes the item state that changes during a turn and that recolor
+ * scripts commonly read: owner, ammo, fuse and tags. Corpses without
+ * their own script are recolored by their unit, so its state is added.
+ * @return State hash.
+ */
+Uint64 BattleItem::getSpriteState() const
+{
+	SpriteCache::StateHash hash;
+	hash.add(_owner);
+	hash.add(_inventorySlot);
+	hash.add(std::begin(_ammoItem), std::end(_ammoItem));
+	hash.add(_ammoQuantity);
+	hash.add(_fuseTimer);
+	hash.add(_fuseEnabled);
+	const auto &tags = _scriptValues.getValuesRaw();
+	hash.add(tags.data(), tags.data() + tags.size());
+	if (_unit)
+	{
+		hash.add(_unit->getSpriteState());
+	}
+	return hash.get();
+}
+
 }
@@ -73,6 +73,8 @@ public:
 	static void ScriptRegister(ScriptParserBase* parser);
 	/// Init all required data in script using object data.
 	static void ScriptFill(ScriptWorkerBlit* w, BattleItem* item, int part, int anim_frame, int shade);
+	/// Gets a hash of the item state the recolor script can read.
+	Uint64 getSpriteState() const;
 
 	/// Creates a item of the specified type.
 	BattleItem(const RuleItem *rules, int *id);
@@ -32,6 +32,7 @@
 #include "../Battlescape/AIModule.h"
 #include "../Battlescape/Inventory.h"
 #include "../Battlescape/TileEngine.h"
+#include "../Battlescape/SpriteCache.h"
 #include "../Mod/Mod.h"
 #include "../Mod/Armor.h"
 #include "../Mod/Unit.h"
@@ -2930,6 +2931,11 @@ void BattleUnit::setTile(Tile *tile, SavedBattleGame *saveBattleGame)
 	}
 
 	_tile = tile;
+	if (saveBattleGame && saveBattleGame->getPathfinding())
+	{
+		// other units can't walk through the tiles we left or entered anymore
+		saveBattleGame->getPathfinding()->invalidateReachable();
+	}
 	if (!_tile)
 	{
 		_floating = false;
@@ -5726,6 +5732,37 @@ void BattleUnit::ScriptFill(ScriptWorkerBlit* w, BattleUnit* unit, int body_part
 	}
 }
 
+/**
+ * Hashes the unit state that changes during a turn and that recolor
+ * scripts commonly read: stats spent or lost, wounds, fire, armor,
+ * items in hand and tags. Cached sprites with another state are
+ * recolored again.
+ * @return State hash.
+ */
+Uint64 BattleUnit::getSpriteState() const
+{
+	SpriteCache::StateHash hash;
+	hash.add(_armor);
+	hash.add(_faction);
+	hash.add(_status);
+	hash.add(_tu);
+	hash.add(_energy);
+	hash.add(_health);
+	hash.add(_morale);
+	hash.add(_stunlevel);
+	hash.add(_mana);
+	hash.add(_fire);
+	hash.add(_kneeled);
+	hash.add(_floating);
+	hash.add(std::begin(_currentArmor), std::end(_currentArmor));
+	hash.add(std::begin(_fatalWounds), std::end(_fatalWounds));
+	hash.add(getRightHandWeapon());
+	hash.add(getLeftHandWeapon());
+	const auto &tags = _scriptValues.getValuesRaw();
+	hash.add(tags.data(), tags.data() + tags.size());
+	return hash.get();
+}
+
 ModScript::DamageUnitParser::DamageUnitParser(ScriptGlobal* shared, const std::string& name, Mod* mod) : ScriptParserEvents{ shared, name,
 	"to_health",
 	"to_armor",
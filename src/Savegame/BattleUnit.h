@@ -197,6 +197,8 @@ public:
 	static void ScriptRegister(ScriptParserBase* parser);
 	/// Init all required data in script using object data.
 	static void ScriptFill(ScriptWorkerBlit* w, BattleUnit* unit, int body_part, int anim_frame, int shade, int burn);
+	/// Gets a hash of the unit state the recolor script can read.
+	Uint64 getSpriteState() const;
 
 	/// Creates a BattleUnit from solder.
 	BattleUnit(const Mod *mod, Soldier *soldier, int depth);
@@ -52,10 +52,11 @@ namespace OpenXcom
  * Initializes a craft of the specified type and
  * assigns it the latest craft ID available.
  * @param rules Pointer to ruleset.
+ * @param mod Pointer to mod.
  * @param base Pointer to base of origin.
  * @param id ID to assign to the craft (0 to not assign).
  */
-Craft::Craft(const RuleCraft *rules, Base *base, int id) : MovingTarget(),
+Craft::Craft(const RuleCraft *rules, const Mod *mod, Base *base, int id) : MovingTarget(),
 	_rules(rules), _base(base), _fuel(0), _damage(0), _shield(0),
 	_interceptionOrder(0), _takeoff(0), _weapons(),
 	_status("STR_READY"), _lowFuel(false), _mission(false),
@@ -64,7 +65,7 @@ Craft::Craft(const RuleCraft *rules, Base *base, int id) : MovingTarget(),
 	_skinIndex(0)
 {
 	_stats = rules->getStats();
-	_items = new ItemContainer();
+	_items = new ItemContainer(mod);
 	if (id != 0)
 	{
 		_id = id;
@@ -143,20 +144,8 @@ void Craft::load(const YAML::Node &node, const ScriptGlobal *shared, const Mod *
 		}
 	}
 
+	// Some old saves have bad items, the container skips them to avoid further bugs
 	_items->load(node["items"]);
-	// Some old saves have bad items, better get rid of them to avoid further bugs
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end();)
-	{
-		if (mod->getItem(i->first) == 0)
-		{
-			Log(LOG_ERROR) << "Failed to load item " << i->first;
-			_items->getContents()->erase(i++);
-		}
-		else
-		{
-			++i;
-		}
-	}
 	for (YAML::const_iterator i = node["vehicles"].begin(); i != node["vehicles"].end(); ++i)
 	{
 		std::string type = (*i)["type"].as<std::string>();
@@ -1284,6 +1273,15 @@ bool Craft::isDestroyed() const
 	return (_damage >= _stats.damageMax);
 }
 
+/**
+ * Returns if the craft is still waiting to take off from its base.
+ * @return Is the craft taking off?
+ */
+bool Craft::isTakingOff() const
+{
+	return _takeoff != 0;
+}
+
 /**
  * Returns the amount of space available for
  * soldiers and vehicles.
@@ -1638,9 +1636,9 @@ void Craft::unload()
 	}
 
 	// Remove items
-	for (std::map<std::string, int>::iterator it = _items->getContents()->begin(); it != _items->getContents()->end(); ++it)
+	for (auto& i : _items->getContents())
 	{
-		_base->getStorageItems()->addItem(it->first, it->second);
+		_base->getStorageItems()->addItem(i.first, i.second);
 	}
 
 	// Remove vehicles
@@ -81,7 +81,7 @@ private:
 	using MovingTarget::load;
 public:
 	/// Creates a craft of the specified type.
-	Craft(const RuleCraft *rules, Base *base, int id = 0);
+	Craft(const RuleCraft *rules, const Mod *mod, Base *base, int id = 0);
 	/// Cleans up the craft.
 	~Craft();
 	/// Loads the craft from YAML.
@@ -222,6 +222,8 @@ public:
 	bool isInBattlescape() const;
 	/// Gets if craft is destroyed during dogfights.
 	bool isDestroyed() const;
+	/// Checks if the craft is still taking off.
+	bool isTakingOff() const;
 	/// Gets the amount of space available inside a craft.
 	int getSpaceAvailable() const;
 	/// Gets the amount of space used inside a craft.
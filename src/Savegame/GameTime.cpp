@@ -145,6 +145,16 @@ TimeTrigger GameTime::advance()
 	return trigger;
 }
 
+/**
+ * Returns how many times the time has to advance until it sends
+ * out a trigger bigger than TIME_5SEC, counting the advance that does.
+ * @return Number of 5 second steps (1-120).
+ */
+int GameTime::getStepsToNextTrigger() const
+{
+	return ((9 - _minute % 10) * 60 + (60 - _second) + 4) / 5;
+}
+
 /**
  * Returns the current ingame second.
  * @return Second (0-59).
@@ -52,6 +52,8 @@ public:
 	bool isLastDayOfMonth();
 	/// Advances the time by 5 seconds.
 	TimeTrigger advance();
+	/// Gets the number of advances until the next 10 minute trigger.
+	int getStepsToNextTrigger() const;
 	/// Gets the ingame second.
 	int getSecond() const;
 	/// Gets the ingame minute.
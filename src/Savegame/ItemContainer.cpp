@@ -17,6 +17,9 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "ItemContainer.h"
+#include <map>
+#include <algorithm>
+#include "../Engine/Logger.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
 
@@ -25,8 +28,9 @@ namespace OpenXcom
 
 /**
  * Initializes an item container with no contents.
+ * @param mod Pointer to mod, used to look up items by name.
  */
-ItemContainer::ItemContainer()
+ItemContainer::ItemContainer(const Mod *mod) : _mod(mod), _totalQuantity(0), _totalSize(0), _totalSizeValid(true)
 {
 }
 
@@ -39,11 +43,24 @@ ItemContainer::~ItemContainer()
 
 /**
  * Loads the item container from a YAML file.
+ * Unknown items (eg. from old saves) are skipped.
  * @param node YAML node.
  */
 void ItemContainer::load(const YAML::Node &node)
 {
-	_qty = node.as< std::map<std::string, int> >(_qty);
+	std::map<std::string, int> qty = node.as< std::map<std::string, int> >(std::map<std::string, int>());
+	for (std::map<std::string, int>::const_iterator i = qty.begin(); i != qty.end(); ++i)
+	{
+		const RuleItem *item = _mod->getItem(i->first);
+		if (item)
+		{
+			addItem(item, i->second);
+		}
+		else
+		{
+			Log(LOG_ERROR) << "Failed to load item " << i->first;
+		}
+	}
 }
 
 /**
@@ -52,13 +69,48 @@ void ItemContainer::load(const YAML::Node &node)
  */
 YAML::Node ItemContainer::save() const
 {
+	std::map<std::string, int> qty;
+	for (size_t i = 0; i < _qty.size(); ++i)
+	{
+		if (_qty[i] != 0)
+		{
+			qty[_mod->getItemsByIndex()[i]->getType()] = _qty[i];
+		}
+	}
 	YAML::Node node;
-	node = _qty;
+	node = qty;
 	return node;
 }
 
+/**
+ * Changes the quantity of an item, keeping the list
+ * of items in the container and the totals up to date.
+ * @param index Item rule index, within the quantities.
+ * @param qty New item quantity.
+ */
+void ItemContainer::setQuantity(size_t index, int qty)
+{
+	const int old = _qty[index];
+	if (qty == old)
+	{
+		return;
+	}
+	if (old == 0)
+	{
+		_used.insert(std::lower_bound(_used.begin(), _used.end(), index), index);
+	}
+	else if (qty == 0)
+	{
+		_used.erase(std::lower_bound(_used.begin(), _used.end(), index));
+	}
+	_qty[index] = qty;
+	_totalQuantity += qty - old;
+	_totalSizeValid = false;
+}
+
 /**
  * Adds an item amount to the container.
+ * Unknown items are logged and skipped.
  * @param id Item ID.
  * @param qty Item quantity.
  */
@@ -68,7 +120,13 @@ void ItemContainer::addItem(const std::string &id, int qty)
 	{
 		return;
 	}
-	_qty[id] += qty;
+	const RuleItem *item = _mod->getItem(id);
+	if (item == 0)
+	{
+		Log(LOG_ERROR) << "Failed to add unknown item " << id;
+		return;
+	}
+	addItem(item, qty);
 }
 
 /**
@@ -80,7 +138,12 @@ void ItemContainer::addItem(const RuleItem* item, int qty)
 {
 	if (item)
 	{
-		addItem(item->getType(), qty);
+		const size_t index = item->getIndex();
+		if (index >= _qty.size())
+		{
+			_qty.resize(_mod->getItemsByIndex().size());
+		}
+		setQuantity(index, _qty[index] + qty);
 	}
 }
 
@@ -95,20 +158,7 @@ void ItemContainer::removeItem(const std::string &id, int qty)
 	{
 		return;
 	}
-	auto it = _qty.find(id);
-	if (it == _qty.end())
-	{
-		return;
-	}
-
-	if (qty < it->second)
-	{
-		it->second -= qty;
-	}
-	else
-	{
-		_qty.erase(it);
-	}
+	removeItem(_mod->getItem(id), qty);
 }
 
 /**
@@ -120,7 +170,20 @@ void ItemContainer::removeItem(const RuleItem* item, int qty)
 {
 	if (item)
 	{
-		removeItem(item->getType(), qty);
+		const size_t index = item->getIndex();
+		if (index >= _qty.size())
+		{
+			return;
+		}
+
+		if (qty < _qty[index])
+		{
+			setQuantity(index, _qty[index] - qty);
+		}
+		else
+		{
+			setQuantity(index, 0);
+		}
 	}
 }
 
@@ -135,16 +198,7 @@ int ItemContainer::getItem(const std::string &id) const
 	{
 		return 0;
 	}
-
-	auto it = _qty.find(id);
-	if (it == _qty.end())
-	{
-		return 0;
-	}
-	else
-	{
-		return it->second;
-	}
+	return getItem(_mod->getItem(id));
 }
 
 /**
@@ -154,9 +208,9 @@ int ItemContainer::getItem(const std::string &id) const
  */
 int ItemContainer::getItem(const RuleItem* item) const
 {
-	if (item)
+	if (item && (size_t)item->getIndex() < _qty.size())
 	{
-		return getItem(item->getType());
+		return _qty[item->getIndex()];
 	}
 	else
 	{
@@ -170,36 +224,65 @@ int ItemContainer::getItem(const RuleItem* item) const
  */
 int ItemContainer::getTotalQuantity() const
 {
-	int total = 0;
-	for (std::map<std::string, int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
-	{
-		total += i->second;
-	}
-	return total;
+	return _totalQuantity;
 }
 
 /**
  * Returns the total size of the items in the container.
+ * It is only added up again after the contents change.
  * @param mod Pointer to mod.
  * @return Total item size.
  */
 double ItemContainer::getTotalSize(const Mod *mod) const
 {
-	double total = 0;
-	for (std::map<std::string, int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
+	if (!_totalSizeValid)
 	{
-		total += mod->getItem(i->first, true)->getSize() * i->second;
+		_totalSize = 0;
+		for (size_t i : _used)
+		{
+			_totalSize += mod->getItemsByIndex()[i]->getSize() * _qty[i];
+		}
+		_totalSizeValid = true;
 	}
-	return total;
+	return _totalSize;
 }
 
 /**
- * Returns all the items currently contained within.
+ * Checks if there is anything in the container.
+ * @return True if the container is empty.
+ */
+bool ItemContainer::isEmpty() const
+{
+	return _used.empty();
+}
+
+/**
+ * Removes all the items from the container.
+ */
+void ItemContainer::clear()
+{
+	_qty.clear();
+	_used.clear();
+	_totalQuantity = 0;
+	_totalSize = 0;
+	_totalSizeValid = true;
+}
+
+/**
+ * Returns all the items currently contained within, in the
+ * same order as their names. Changing the container while
+ * going through the list does not affect it.
  * @return List of contents.
  */
-std::map<std::string, int> *ItemContainer::getContents()
+std::vector<std::pair<RuleItem*, int>> ItemContainer::getContents() const
 {
-	return &_qty;
+	std::vector<std::pair<RuleItem*, int>> contents;
+	contents.reserve(_used.size());
+	for (size_t i : _used)
+	{
+		contents.push_back(std::make_pair(_mod->getItemsByIndex()[i], _qty[i]));
+	}
+	return contents;
 }
 
 }
@@ -18,7 +18,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string>
-#include <map>
+#include <vector>
+#include <utility>
 #include <yaml-cpp/yaml.h>
 
 namespace OpenXcom
@@ -31,14 +32,26 @@ class RuleItem;
  * Represents the items contained by a certain entity,
  * like base stores, craft equipment, etc.
  * Handles all necessary item management tasks.
+ * Quantities are stored in a flat array indexed by item rule index,
+ * item names are only used to load and save it. The indexes of the
+ * items in the container and the totals are kept alongside, so they
+ * don't need a pass over every item rule.
  */
 class ItemContainer
 {
 private:
-	std::map<std::string, int> _qty;
+	const Mod *_mod;
+	std::vector<int> _qty;
+	std::vector<size_t> _used;
+	int _totalQuantity;
+	mutable double _totalSize;
+	mutable bool _totalSizeValid;
+
+	/// Changes the quantity of an item and updates the totals.
+	void setQuantity(size_t index, int qty);
 public:
 	/// Creates an empty item container.
-	ItemContainer();
+	ItemContainer(const Mod *mod);
 	/// Cleans up the item container.
 	~ItemContainer();
 	/// Loads the item container from YAML.
@@ -61,8 +74,12 @@ public:
 	int getTotalQuantity() const;
 	/// Gets the total size of items in the container.
 	double getTotalSize(const Mod *mod) const;
+	/// Checks if the container is empty.
+	bool isEmpty() const;
+	/// Removes all items from the container.
+	void clear();
 	/// Gets all the items in the container.
-	std::map<std::string, int> *getContents();
+	std::vector<std::pair<RuleItem*, int>> getContents() const;
 };
 
 }
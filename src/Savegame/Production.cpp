@@ -147,7 +147,7 @@ productionProgress_e Production::step(Base * b, SavedGame * g, const Mod *m, Lan
 			auto ruleCraft = _rules->getProducedCraft();
 			if (ruleCraft)
 			{
-				Craft *craft = new Craft(ruleCraft, b, g->getId(ruleCraft->getType()));
+				Craft *craft = new Craft(ruleCraft, m, b, g->getId(ruleCraft->getType()));
 				craft->setStatus("STR_REFUELLING");
 				b->getCrafts()->push_back(craft);
 			}
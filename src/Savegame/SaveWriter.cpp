@@ -0,0 +1,170 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SaveWriter.h"
+#include "SavedGame.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Options.h"
+#include "../Engine/CrossPlatform.h"
+
+namespace OpenXcom
+{
+
+SDL_Thread *SaveWriter::_thread = 0;
+SDL_mutex *SaveWriter::_mutex = 0;
+bool SaveWriter::_finished = false;
+std::string SaveWriter::_filename, SaveWriter::_error;
+std::vector<YAML::Node> SaveWriter::_docs;
+SaveWriter::Callback SaveWriter::_callback;
+
+/**
+ * Writes the pending save into a backup file first and then
+ * moves it over the old save, so a crash mid-write never
+ * leaves a broken save behind.
+ * @param data Unused.
+ * @return Always zero.
+ */
+int SaveWriter::run(void *)
+{
+	std::string error;
+	try
+	{
+		std::string backup = _filename + ".bak";
+		SavedGame::writeDocuments(backup, _docs);
+		std::string fullPath = Options::getMasterUserFolder() + _filename;
+		std::string bakPath = Options::getMasterUserFolder() + backup;
+		if (!CrossPlatform::moveFile(bakPath, fullPath))
+		{
+			throw Exception("Save backed up in " + backup);
+		}
+	}
+	catch (Exception &e)
+	{
+		error = e.what();
+	}
+	catch (YAML::Exception &e)
+	{
+		error = e.what();
+	}
+	if (!error.empty())
+	{
+		Log(LOG_ERROR) << _filename << ": " << error;
+	}
+
+	SDL_mutexP(_mutex);
+	_error = error;
+	_finished = true;
+	SDL_mutexV(_mutex);
+	return 0;
+}
+
+/**
+ * Adds a save that was written and moved to its real name
+ * to the save index. Only done on the main thread, so the
+ * index is never written by two threads at once.
+ */
+void SaveWriter::updateIndex()
+{
+	if (!_docs.empty() && _error.empty())
+	{
+		SavedGame::updateSaveIndex(_filename, _docs[0]);
+	}
+	_docs.clear();
+}
+
+/**
+ * Starts writing a save in the background.
+ * @param filename Save filename.
+ * @param docs Serialized saved game.
+ * @param callback Function to call on the main thread when done.
+ */
+void SaveWriter::start(const std::string &filename, const std::vector<YAML::Node> &docs, Callback callback)
+{
+	wait();
+	poll();
+	if (_mutex == 0)
+	{
+		_mutex = SDL_CreateMutex();
+	}
+	_filename = filename;
+	// deep copy, so nothing is shared with nodes the game still holds
+	_docs.clear();
+	for (std::vector<YAML::Node>::const_iterator i = docs.begin(); i != docs.end(); ++i)
+	{
+		_docs.push_back(YAML::Clone(*i));
+	}
+	_callback = callback;
+	_error.clear();
+	_finished = false;
+	_thread = SDL_CreateThread(run, 0);
+	if (_thread == 0)
+	{
+		// no threads, write it right away
+		Log(LOG_WARNING) << "Failed to start save thread: " << SDL_GetError();
+		run(0);
+	}
+}
+
+/**
+ * Runs the completion callback of a finished save.
+ * Called by the game loop on the main thread.
+ */
+void SaveWriter::poll()
+{
+	if (_mutex == 0)
+	{
+		return;
+	}
+	SDL_mutexP(_mutex);
+	bool finished = _finished;
+	_finished = false;
+	SDL_mutexV(_mutex);
+	if (!finished)
+	{
+		return;
+	}
+	if (_thread != 0)
+	{
+		SDL_WaitThread(_thread, 0);
+		_thread = 0;
+	}
+	updateIndex();
+	Callback callback;
+	std::swap(callback, _callback);
+	if (callback)
+	{
+		callback(_error);
+	}
+}
+
+/**
+ * Waits for the pending save to be written,
+ * eg. before quitting or touching the save files.
+ */
+void SaveWriter::wait()
+{
+	if (_thread != 0)
+	{
+		SDL_WaitThread(_thread, 0);
+		_thread = 0;
+		updateIndex();
+	}
+}
+
+}
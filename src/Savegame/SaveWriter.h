@@ -0,0 +1,60 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <functional>
+#include <yaml-cpp/yaml.h>
+#include <SDL_thread.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Writes a snapshot of a saved game to disk on a background thread,
+ * so autosaves don't freeze the game. Only one save is written
+ * at a time, a new one waits for the previous one to finish.
+ */
+class SaveWriter
+{
+public:
+	/// Called on the main thread when a save finished, with an empty string on success.
+	typedef std::function<void(const std::string &error)> Callback;
+private:
+	static SDL_Thread *_thread;
+	static SDL_mutex *_mutex;
+	static bool _finished;
+	static std::string _filename, _error;
+	static std::vector<YAML::Node> _docs;
+	static Callback _callback;
+
+	/// Writes the pending save.
+	static int run(void *data);
+	/// Adds the written save to the save index.
+	static void updateIndex();
+public:
+	/// Starts writing a save in the background.
+	static void start(const std::string &filename, const std::vector<YAML::Node> &docs, Callback callback);
+	/// Notifies about a finished save.
+	static void poll();
+	/// Waits for the pending save to be written.
+	static void wait();
+};
+
+}
@@ -41,6 +41,7 @@
 #include "../Battlescape/AIModule.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Options.h"
+#include "../Engine/FrameProfiler.h"
 #include "../Engine/Logger.h"
 #include "../Engine/ScriptBind.h"
 #include "SerializationHelper.h"
@@ -75,7 +76,7 @@ SavedBattleGame::SavedBattleGame(Mod *rule, Language *lang) :
 		_tileSearch[i].x = ((i%11) - 5);
 		_tileSearch[i].y = ((i/11) - 5);
 	}
-	_baseItems = new ItemContainer();
+	_baseItems = new ItemContainer(rule);
 	_hitLog = new HitLog(lang);
 
 	setRandomHiddenMovementBackground(0);
@@ -1172,6 +1173,11 @@ void SavedBattleGame::newTurnUpdateScripts()
  */
 void SavedBattleGame::endTurn()
 {
+	if (FrameProfiler::isEnabled())
+	{
+		FrameProfiler::endTurn(_turn, _side == FACTION_PLAYER ? "player" : _side == FACTION_HOSTILE ? "hostile" : "neutral");
+	}
+
 	// reset turret direction for all hostile and neutral units (as it may have been changed during reaction fire)
 	for (std::vector<BattleUnit*>::iterator i = _units.begin(); i != _units.end(); ++i)
 	{
@@ -1935,6 +1941,7 @@ void SavedBattleGame::prepareNewTurn()
 					}
 				}
 				getTileEngine()->applyGravity(*i);
+				getPathfinding()->invalidateReachable();
 			}
 		}
 	}
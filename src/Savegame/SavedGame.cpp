@@ -31,9 +31,11 @@
 #include "../Engine/Exception.h"
 #include "../Engine/Options.h"
 #include "../Engine/CrossPlatform.h"
+#include "../Engine/BinaryYaml.h"
 #include "../Engine/ScriptBind.h"
 #include "SavedBattleGame.h"
 #include "SerializationHelper.h"
+#include "SaveWriter.h"
 #include "GameTime.h"
 #include "Country.h"
 #include "Base.h"
@@ -71,7 +73,8 @@ namespace OpenXcom
 
 const std::string SavedGame::AUTOSAVE_GEOSCAPE = "_autogeo_.asav",
 				  SavedGame::AUTOSAVE_BATTLESCAPE = "_autobattle_.asav",
-				  SavedGame::QUICKSAVE = "_quick_.asav";
+				  SavedGame::QUICKSAVE = "_quick_.asav",
+				  SavedGame::SAVE_INDEX = "savelist.idx";
 
 namespace
 {
@@ -125,25 +128,14 @@ void sortReserchVector(std::vector<T> &vec)
 	std::sort(vec.begin(), vec.end(), researchLess);
 }
 
-bool haveReserchVector(const std::vector<const RuleResearch*> &vec, const RuleResearch *res)
-{
-	auto find = std::lower_bound(vec.begin(), vec.end(), res, researchLess);
-	return find != vec.end() && *find == res;
-}
-
-bool haveReserchVector(const std::vector<const RuleResearch*> &vec,  const std::string &res)
-{
-	auto find = std::find_if(vec.begin(), vec.end(), [&](const RuleResearch* r){ return r->getName() == res; });
-	return find != vec.end();
-}
-
 }
 
 /**
  * Initializes a brand new saved game according to the specified difficulty.
+ * @param mod Game mod, used to look up research by name.
  */
-SavedGame::SavedGame() : _difficulty(DIFF_BEGINNER), _end(END_NONE), _ironman(false), _globeLon(0.0),
-						 _globeLat(0.0), _globeZoom(0), _battleGame(0), _debug(false),
+SavedGame::SavedGame(const Mod *mod) : _difficulty(DIFF_BEGINNER), _end(END_NONE), _ironman(false), _globeLon(0.0),
+						 _globeLat(0.0), _globeZoom(0), _battleGame(0), _mod(mod), _availableResearchValid(false), _availableManufactureValid(false), _debug(false),
 						 _warned(false), _monthsPassed(-1), _selectedBase(0), _autosales(), _disableSoldierEquipment(false), _alienContainmentChecked(false)
 {
 	_time = new GameTime(6, 1, 1, 1999, 12, 0, 0);
@@ -157,8 +149,10 @@ SavedGame::SavedGame() : _difficulty(DIFF_BEGINNER), _end(END_NONE), _ironman(fa
 
 	for (int j = 0; j < MAX_CRAFT_LOADOUT_TEMPLATES; ++j)
 	{
-		_globalCraftLoadout[j] = new ItemContainer();
+		_globalCraftLoadout[j] = new ItemContainer(mod);
 	}
+
+	rebuildResearchState();
 }
 
 /**
@@ -277,27 +271,69 @@ static bool _isCurrentGameType(const SaveInfo &saveInfo, const std::string &curM
 
 /**
  * Gets all the info of the saves found in the user folder.
+ * The save headers are remembered in an index file, so only
+ * saves that were changed since the last scan need to be read.
  * @param lang Loaded language.
  * @param autoquick Include autosaves and quicksaves.
  * @return List of saves info.
  */
 std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 {
+	SaveWriter::wait();
 	std::vector<SaveInfo> info;
 	std::string curMaster = Options::getActiveMaster();
-	auto saves = CrossPlatform::getFolderContents(Options::getMasterUserFolder(), "sav");
+	std::string folder = Options::getMasterUserFolder();
+	auto saves = CrossPlatform::getFolderContents(folder, "sav");
 
 	if (autoquick)
 	{
-		auto asaves = CrossPlatform::getFolderContents(Options::getMasterUserFolder(), "asav");
+		auto asaves = CrossPlatform::getFolderContents(folder, "asav");
 		saves.insert(saves.begin(), asaves.begin(), asaves.end());
 	}
+
+	YAML::Node index;
+	try
+	{
+		if (CrossPlatform::fileExists(folder + SAVE_INDEX))
+		{
+			index = BinaryYaml::loadFile(folder + SAVE_INDEX, 1).at(0);
+		}
+	}
+	catch (std::exception &e)
+	{
+		Log(LOG_WARNING) << SAVE_INDEX << ": " << e.what();
+	}
+	if (!index.IsMap())
+	{
+		index = YAML::Node(YAML::NodeType::Map);
+	}
+	bool indexChanged = false;
+
 	for (auto i = saves.begin(); i != saves.end(); ++i)
 	{
 		auto filename = std::get<0>(*i);
+		time_t timestamp = std::get<2>(*i);
 		try
 		{
-			SaveInfo saveInfo = getSaveInfo(filename, lang);
+			Sint64 size = CrossPlatform::getFileSize(folder + filename);
+			const YAML::Node &entries = index;
+			YAML::Node cached = entries[filename];
+			YAML::Node doc;
+			if (cached && cached["mtime"].as<int64_t>(0) == (int64_t)timestamp && cached["size"].as<int64_t>(-1) == size)
+			{
+				doc = cached["header"];
+			}
+			else
+			{
+				doc = getSaveHeader(folder + filename);
+				YAML::Node entry;
+				entry["mtime"] = (int64_t)timestamp;
+				entry["size"] = size;
+				entry["header"] = doc;
+				index[filename] = entry;
+				indexChanged = true;
+			}
+			SaveInfo saveInfo = getSaveInfo(filename, doc, timestamp, lang);
 			if (!_isCurrentGameType(saveInfo, curMaster))
 			{
 				continue;
@@ -316,18 +352,82 @@ std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 		}
 	}
 
+	// forget the saves that are gone, the list is only complete with the autosaves
+	if (autoquick && index.size() > saves.size())
+	{
+		const YAML::Node &entries = index;
+		YAML::Node cleaned(YAML::NodeType::Map);
+		for (auto i = saves.begin(); i != saves.end(); ++i)
+		{
+			if (entries[std::get<0>(*i)])
+			{
+				cleaned[std::get<0>(*i)] = entries[std::get<0>(*i)];
+			}
+		}
+		index = cleaned;
+		indexChanged = true;
+	}
+	if (indexChanged)
+	{
+		BinaryYaml::saveFile(folder + SAVE_INDEX, std::vector<YAML::Node>(1, index), true);
+	}
+
 	return info;
 }
 
+/**
+ * Reads the brief info at the start of a save file.
+ * @param fullname Full path to the save.
+ * @return Header node.
+ */
+YAML::Node SavedGame::getSaveHeader(const std::string &fullname)
+{
+	if (BinaryYaml::isBinaryFile(fullname))
+	{
+		return BinaryYaml::loadFile(fullname, 1).at(0);
+	}
+	return YAML::Load(*CrossPlatform::getYamlSaveHeader(fullname));
+}
+
+/**
+ * Remembers the brief info of a freshly written save
+ * in the save index, so the saves list doesn't have to read it.
+ * @param file Save filename.
+ * @param doc Header node.
+ */
+void SavedGame::updateSaveIndex(const std::string &file, const YAML::Node &doc)
+{
+	std::string folder = Options::getMasterUserFolder();
+	if (!CrossPlatform::fileExists(folder + SAVE_INDEX))
+	{
+		// the first scan of the saves list builds it
+		return;
+	}
+	try
+	{
+		YAML::Node index = BinaryYaml::loadFile(folder + SAVE_INDEX, 1).at(0);
+		YAML::Node entry;
+		entry["mtime"] = (int64_t)CrossPlatform::getDateModified(folder + file);
+		entry["size"] = CrossPlatform::getFileSize(folder + file);
+		entry["header"] = doc;
+		index[file] = entry;
+		BinaryYaml::saveFile(folder + SAVE_INDEX, std::vector<YAML::Node>(1, index), true);
+	}
+	catch (std::exception &e)
+	{
+		Log(LOG_WARNING) << SAVE_INDEX << ": " << e.what();
+	}
+}
+
 /**
  * Gets the info of a specific save file.
  * @param file Save filename.
+ * @param doc Brief info from the save.
+ * @param timestamp Last modified date of the save.
  * @param lang Loaded language.
  */
-SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
+SaveInfo SavedGame::getSaveInfo(const std::string &file, const YAML::Node &doc, time_t timestamp, Language *lang)
 {
-	std::string fullname = Options::getMasterUserFolder() + file;
-	YAML::Node doc = YAML::Load(*CrossPlatform::getYamlSaveHeader(fullname));
 	SaveInfo save;
 
 	save.fileName = file;
@@ -360,7 +460,7 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
 		save.reserved = false;
 	}
 
-	save.timestamp = CrossPlatform::getDateModified(fullname);
+	save.timestamp = timestamp;
 	std::pair<std::string, std::string> str = CrossPlatform::timeToString(save.timestamp);
 	save.isoDate = str.first;
 	save.isoTime = str.second;
@@ -398,8 +498,17 @@ SaveInfo SavedGame::getSaveInfo(const std::string &file, Language *lang)
  */
 void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 {
+	SaveWriter::wait();
 	std::string filepath = Options::getMasterUserFolder() + filename;
-	std::vector<YAML::Node> file = YAML::LoadAll(*CrossPlatform::readFile(filepath));
+	std::vector<YAML::Node> file;
+	if (BinaryYaml::isBinaryFile(filepath))
+	{
+		file = BinaryYaml::loadFile(filepath);
+	}
+	else
+	{
+		file = YAML::LoadAll(*CrossPlatform::readFile(filepath));
+	}
 	// Get brief save info
 	YAML::Node brief = file[0];
 	_time->load(brief["time"]);
@@ -586,11 +695,14 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		}
 	}
 	sortReserchVector(_discovered);
+	_discovered.erase(std::unique(_discovered.begin(), _discovered.end()), _discovered.end());
 
 	_generatedEvents = doc["generatedEvents"].as< std::map<std::string, int> >(_generatedEvents);
 	_ufopediaRuleStatus = doc["ufopediaRuleStatus"].as< std::map<std::string, int> >(_ufopediaRuleStatus);
 	_manufactureRuleStatus = doc["manufactureRuleStatus"].as< std::map<std::string, int> >(_manufactureRuleStatus);
 	_researchRuleStatus = doc["researchRuleStatus"].as< std::map<std::string, int> >(_researchRuleStatus);
+	_mod = mod;
+	rebuildResearchState();
 	_hiddenPurchaseItemsMap = doc["hiddenPurchaseItems"].as< std::map<std::string, bool> >(_hiddenPurchaseItemsMap);
 
 	for (YAML::const_iterator i = doc["bases"].begin(); i != doc["bases"].end(); ++i)
@@ -782,11 +894,27 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 /**
  * Saves a saved game's contents to a YAML file.
  * @param filename YAML filename.
+ * @param mod Mod for the saved game.
  */
 void SavedGame::save(const std::string &filename, Mod *mod) const
 {
-	YAML::Emitter out;
+	// don't race a background save
+	SaveWriter::wait();
+	std::vector<YAML::Node> docs = saveDocuments(mod);
+	writeDocuments(filename, docs);
+	updateSaveIndex(filename, docs[0]);
+}
 
+/**
+ * Serializes a saved game's contents into YAML documents:
+ * the brief info used in the saves list and the full game data.
+ * The documents don't share anything with the game state,
+ * so they can be written out on another thread.
+ * @param mod Mod for the saved game.
+ * @return Serialized documents.
+ */
+std::vector<YAML::Node> SavedGame::saveDocuments(Mod *mod) const
+{
 	// Saves the brief game info used in the saves list
 	YAML::Node brief;
 	brief["name"] = _name;
@@ -816,9 +944,7 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	brief["mods"] = modsList;
 	if (_ironman)
 		brief["ironman"] = _ironman;
-	out << brief;
 	// Saves the full game data to the save
-	out << YAML::BeginDoc;
 	YAML::Node node;
 	node["difficulty"] = (int)_difficulty;
 	node["end"] = (int)_end;
@@ -925,7 +1051,7 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 		std::ostringstream oss;
 		oss << "globalCraftLoadout" << j;
 		std::string key = oss.str();
-		if (!_globalCraftLoadout[j]->getContents()->empty())
+		if (!_globalCraftLoadout[j]->isEmpty())
 		{
 			node[key] = _globalCraftLoadout[j]->save();
 		}
@@ -954,11 +1080,40 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	}
 	_scriptValues.save(node, mod->getScriptGlobal());
 
-	out << node;
-
+	std::vector<YAML::Node> docs;
+	docs.push_back(brief);
+	docs.push_back(node);
+	return docs;
+}
 
+/**
+ * Writes serialized saved game documents to a file,
+ * in the binary or the YAML format depending on the options.
+ * @param filename Save filename.
+ * @param docs Serialized saved game.
+ */
+void SavedGame::writeDocuments(const std::string &filename, const std::vector<YAML::Node> &docs)
+{
 	std::string filepath = Options::getMasterUserFolder() + filename;
-	if (!CrossPlatform::writeFile(filepath, out.c_str()))
+	bool saved;
+	if (Options::oxceBinarySaves)
+	{
+		saved = BinaryYaml::saveFile(filepath, docs, true);
+	}
+	else
+	{
+		YAML::Emitter out;
+		for (size_t i = 0; i < docs.size(); ++i)
+		{
+			if (i > 0)
+			{
+				out << YAML::BeginDoc;
+			}
+			out << docs[i];
+		}
+		saved = CrossPlatform::writeFile(filepath, out.c_str());
+	}
+	if (!saved)
 	{
 		throw Exception("Failed to save " + filepath);
 	}
@@ -1394,6 +1549,13 @@ void SavedGame::setManufactureRuleStatus(const std::string &manufactureRule, int
 void SavedGame::setResearchRuleStatus(const std::string &researchRule, int newStatus)
 {
 	_researchRuleStatus[researchRule] = newStatus;
+
+	const RuleResearch *research = _mod->getResearch(researchRule);
+	if (research && _disabledBits[research->getIndex()] != (newStatus == RuleResearch::RESEARCH_STATUS_DISABLED))
+	{
+		_disabledBits[research->getIndex()] = (newStatus == RuleResearch::RESEARCH_STATUS_DISABLED);
+		_availableResearchValid = false;
+	}
 }
 
 /**
@@ -1427,7 +1589,7 @@ const RuleResearch* SavedGame::selectGetOneFree(const RuleResearch* research)
 		std::vector<const RuleResearch*> possibilities;
 		for (auto& free : research->getGetOneFree())
 		{
-			if (isResearchRuleStatusDisabled(free->getName()))
+			if (isResearchRuleStatusDisabled(free))
 			{
 				continue; // skip disabled topics
 			}
@@ -1442,7 +1604,7 @@ const RuleResearch* SavedGame::selectGetOneFree(const RuleResearch* research)
 			{
 				for (auto& itVector : itMap.second)
 				{
-					if (isResearchRuleStatusDisabled(itVector->getName()))
+					if (isResearchRuleStatusDisabled(itVector))
 					{
 						continue; // skip disabled topics
 					}
@@ -1473,11 +1635,7 @@ const RuleResearch* SavedGame::selectGetOneFree(const RuleResearch* research)
  */
 void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
 {
-	std::vector<const RuleResearch*>::iterator r = std::find(_discovered.begin(), _discovered.end(), research);
-	if (r != _discovered.end())
-	{
-		_discovered.erase(r);
-	}
+	setResearchDiscovered(research, false);
 }
 
 /**
@@ -1486,8 +1644,69 @@ void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
  */
 void SavedGame::addFinishedResearchSimple(const RuleResearch * research)
 {
-	_discovered.push_back(research);
-	sortReserchVector(_discovered);
+	setResearchDiscovered(research, true);
+}
+
+/**
+ * Rebuilds the discovered and disabled bitsets and the count of discovered
+ * topics unlocking each topic, after the discovered list or rule status are replaced.
+ */
+void SavedGame::rebuildResearchState()
+{
+	const size_t count = _mod->getResearchMap().size();
+	_discoveredBits.assign(count, false);
+	_disabledBits.assign(count, false);
+	_unlockedCount.assign(count, 0);
+	for (const RuleResearch *research : _discovered)
+	{
+		_discoveredBits[research->getIndex()] = true;
+		for (auto& unlock : research->getUnlocked())
+		{
+			++_unlockedCount[unlock->getIndex()];
+		}
+	}
+	for (auto& status : _researchRuleStatus)
+	{
+		const RuleResearch *research = _mod->getResearch(status.first);
+		if (research && status.second == RuleResearch::RESEARCH_STATUS_DISABLED)
+		{
+			_disabledBits[research->getIndex()] = true;
+		}
+	}
+	_availableResearchValid = false;
+	_availableManufactureValid = false;
+}
+
+/**
+ * Adds or removes a research topic in the discovered list,
+ * updating the bitsets and invalidating the available topics.
+ * @param research Research topic.
+ * @param discovered Whether the topic is discovered.
+ */
+void SavedGame::setResearchDiscovered(const RuleResearch *research, bool discovered)
+{
+	const int index = research->getIndex();
+	if (_discoveredBits[index] == discovered)
+	{
+		return;
+	}
+	_discoveredBits[index] = discovered;
+
+	auto pos = std::lower_bound(_discovered.begin(), _discovered.end(), research, researchLess);
+	if (discovered)
+	{
+		_discovered.insert(pos, research);
+	}
+	else
+	{
+		_discovered.erase(pos);
+	}
+	for (auto& unlock : research->getUnlocked())
+	{
+		_unlockedCount[unlock->getIndex()] += discovered ? 1 : -1;
+	}
+	_availableResearchValid = false;
+	_availableManufactureValid = false;
 }
 
 /**
@@ -1502,13 +1721,13 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 	// process "re-enables"
 	for (auto& ree : research->getReenabled())
 	{
-		if (isResearchRuleStatusDisabled(ree->getName()))
+		if (isResearchRuleStatusDisabled(ree))
 		{
 			setResearchRuleStatus(ree->getName(), RuleResearch::RESEARCH_STATUS_NEW); // reset status
 		}
 	}
 
-	if (isResearchRuleStatusDisabled(research->getName()))
+	if (isResearchRuleStatusDisabled(research))
 	{
 		return;
 	}
@@ -1530,8 +1749,7 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 		bool checkRelatedZeroCostTopics = true;
 		if (!isResearched(currentQueueItem, false))
 		{
-			_discovered.push_back(currentQueueItem);
-			sortReserchVector(_discovered);
+			setResearchDiscovered(currentQueueItem, true);
 			if (!hasUndiscoveredProtectedUnlocks && !hasAnyUndiscoveredGetOneFrees)
 			{
 				// If the currentQueueItem can't tell you anything anymore, remove it from popped research
@@ -1637,6 +1855,7 @@ const std::vector<const RuleResearch *> & SavedGame::getDiscoveredResearch() con
 
 /**
  * Get the list of RuleResearch which can be researched in a Base.
+ * Topics available in any base are cached until the research state changes.
  * @param projects the list of ResearchProject which are available.
  * @param mod the game Mod
  * @param base a pointer to a Base
@@ -1644,30 +1863,79 @@ const std::vector<const RuleResearch *> & SavedGame::getDiscoveredResearch() con
  */
 void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projects, const Mod *mod, Base *base, bool considerDebugMode) const
 {
-	// This list is used for topics that can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
-	// Note: all requirements of such topics *have to* be discovered though! This will be handled elsewhere.
-	std::vector<const RuleResearch *> unlocked;
-	for (const RuleResearch *research : _discovered)
+	std::vector<RuleResearch *> debugCandidates;
+	const std::vector<RuleResearch *> *candidates = &_availableResearchCache;
+	if (considerDebugMode && _debug)
+	{
+		getAvailableResearchCandidates(debugCandidates, mod, considerDebugMode);
+		candidates = &debugCandidates;
+	}
+	else if (!_availableResearchValid)
+	{
+		_availableResearchCache.clear();
+		getAvailableResearchCandidates(_availableResearchCache, mod, considerDebugMode);
+		_availableResearchValid = true;
+	}
+
+	for (RuleResearch *research : *candidates)
 	{
-		for (auto& itUnlocked : research->getUnlocked())
+		if (base)
+		{
+			// Check if this topic is already being researched in the given base
+			const std::vector<ResearchProject *> & baseResearchProjects = base->getResearch();
+			if (std::find_if(baseResearchProjects.begin(), baseResearchProjects.end(), findRuleResearch(research)) != baseResearchProjects.end())
+			{
+				continue;
+			}
+
+			// Check for needed item in the given base
+			if (research->needItem() && base->getStorageItems()->getItem(research->getName()) == 0)
+			{
+				continue;
+			}
+
+			// Check for required buildings/functions in the given base
+			if ((~base->getProvidedBaseFunc({}) & research->getRequireBaseFunc()).any())
+			{
+				continue;
+			}
+		}
+		else
 		{
-			unlocked.push_back(itUnlocked);
+			// Used in vanilla save converter only
+			if (research->needItem() && research->getCost() == 0)
+			{
+				continue;
+			}
 		}
-		sortReserchVector(unlocked);
+
+		// Hallelujah, all checks passed, add the research topic to the list
+		projects.push_back(research);
 	}
+}
 
-	// Create a list of research topics available for research in the given base
+/**
+ * Get the list of RuleResearch which can be researched, ignoring base specific checks.
+ * @param projects the list of ResearchProject which are available.
+ * @param mod the game Mod
+ * @param considerDebugMode Should debug mode be considered or not.
+ */
+void SavedGame::getAvailableResearchCandidates(std::vector<RuleResearch *> &projects, const Mod *mod, bool considerDebugMode) const
+{
+	// Create a list of research topics available for research
 	for (auto& pair : mod->getResearchMap())
 	{
+		RuleResearch *research = pair.second;
+
 		// This research topic is permanently disabled, ignore it!
-		if (isResearchRuleStatusDisabled(pair.first))
+		if (isResearchRuleStatusDisabled(research))
 		{
 			continue;
 		}
 
-		RuleResearch *research = pair.second;
-
-		if ((considerDebugMode && _debug) || haveReserchVector(unlocked, research))
+		// Topics unlocked by any discovered topic can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
+		// Note: all requirements of such topics *have to* be discovered though! This will be handled below.
+		if ((considerDebugMode && _debug) || _unlockedCount[research->getIndex()] > 0)
 		{
 			// Empty, these research topics are on the "unlocked list", *don't* check the dependencies!
 		}
@@ -1692,7 +1960,7 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projec
 		}
 
 		// Remove the already researched topics from the list *UNLESS* they can still give you something more
-		if (isResearched(research->getName(), false))
+		if (isResearched(research, false))
 		{
 			if (hasUndiscoveredGetOneFree(research, true))
 			{
@@ -1709,37 +1977,6 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projec
 			}
 		}
 
-		if (base)
-		{
-			// Check if this topic is already being researched in the given base
-			const std::vector<ResearchProject *> & baseResearchProjects = base->getResearch();
-			if (std::find_if(baseResearchProjects.begin(), baseResearchProjects.end(), findRuleResearch(research)) != baseResearchProjects.end())
-			{
-				continue;
-			}
-
-			// Check for needed item in the given base
-			if (research->needItem() && base->getStorageItems()->getItem(research->getName()) == 0)
-			{
-				continue;
-			}
-
-			// Check for required buildings/functions in the given base
-			if ((~base->getProvidedBaseFunc({}) & research->getRequireBaseFunc()).any())
-			{
-				continue;
-			}
-		}
-		else
-		{
-			// Used in vanilla save converter only
-			if (research->needItem() && research->getCost() == 0)
-			{
-				continue;
-			}
-		}
-
-		// Hallelujah, all checks passed, add the research topic to the list
 		projects.push_back(research);
 	}
 }
@@ -1775,19 +2012,36 @@ void SavedGame::getNewlyAvailableResearchProjects(std::vector<RuleResearch *> &
  */
 void SavedGame::getAvailableProductions (std::vector<RuleManufacture *> & productions, const Mod * mod, Base * base, ManufacturingFilterType filter) const
 {
-	const std::vector<std::string> &items = mod->getManufactureList();
 	const std::vector<Production *> &baseProductions = base->getProductions();
 	auto baseFunc = base->getProvidedBaseFunc({});
 
-	for (std::vector<std::string>::const_iterator iter = items.begin();
-		iter != items.end();
-		++iter)
+	// researched manufacture is cached until the research state changes, debug mode researches everything
+	std::vector<RuleManufacture *> debugCandidates;
+	const std::vector<RuleManufacture *> *candidates = &_availableManufactureCache;
+	if (_debug || !_availableManufactureValid)
 	{
-		RuleManufacture *m = mod->getManufacture(*iter);
-		if (!isResearched(m->getRequirements()))
+		std::vector<RuleManufacture *> &researched = _debug ? debugCandidates : _availableManufactureCache;
+		researched.clear();
+		for (const std::string &name : mod->getManufactureList())
 		{
-			continue;
+			RuleManufacture *m = mod->getManufacture(name);
+			if (isResearched(m->getRequirements()))
+			{
+				researched.push_back(m);
+			}
 		}
+		if (_debug)
+		{
+			candidates = &debugCandidates;
+		}
+		else
+		{
+			_availableManufactureValid = true;
+		}
+	}
+
+	for (RuleManufacture *m : *candidates)
+	{
 		if (std::find_if (baseProductions.begin(), baseProductions.end(), equalProduction(m)) != baseProductions.end())
 		{
 			continue;
@@ -1986,6 +2240,11 @@ bool SavedGame::isResearchRuleStatusNew(const std::string &researchRule) const
  */
 bool SavedGame::isResearchRuleStatusDisabled(const std::string &researchRule) const
 {
+	const RuleResearch *research = _mod->getResearch(researchRule);
+	if (research)
+	{
+		return isResearchRuleStatusDisabled(research);
+	}
 	auto it = _researchRuleStatus.find(researchRule);
 	if (it != _researchRuleStatus.end())
 	{
@@ -1997,6 +2256,16 @@ bool SavedGame::isResearchRuleStatusDisabled(const std::string &researchRule) co
 	return false;
 }
 
+/**
+ * Is the research permanently disabled?
+ * @param researchRule Research rule.
+ * @return True, if the research rule status is disabled.
+ */
+bool SavedGame::isResearchRuleStatusDisabled(const RuleResearch *researchRule) const
+{
+	return _disabledBits[researchRule->getIndex()];
+}
+
 /**
  * Returns if a research still has undiscovered non-disabled "getOneFree".
  * @param r Research to check.
@@ -2041,7 +2310,7 @@ bool SavedGame::hasUndiscoveredProtectedUnlock(const RuleResearch * r, const Mod
 	// Note: checking for not yet discovered unlocks protected by "requires" (which also implies cost = 0)
 	for (auto& unlock : r->getUnlocked())
 	{
-		if (isResearchRuleStatusDisabled(unlock->getName()))
+		if (isResearchRuleStatusDisabled(unlock))
 		{
 			// ignore all disabled topics (as if they didn't exist)
 			continue;
@@ -2070,7 +2339,7 @@ bool SavedGame::isResearched(const std::string &research, bool considerDebugMode
 	if (considerDebugMode && _debug)
 		return true;
 
-	return haveReserchVector(_discovered, research);
+	return isResearched(_mod->getResearch(research), false);
 }
 
 bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMode) const
@@ -2080,7 +2349,7 @@ bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMod
 	if (considerDebugMode && _debug)
 		return true;
 
-	return haveReserchVector(_discovered, research);
+	return research && _discoveredBits[research->getIndex()];
 }
 
 bool SavedGame::isResearched(const std::vector<std::string> &research, bool considerDebugMode) const
@@ -2092,7 +2361,7 @@ bool SavedGame::isResearched(const std::vector<std::string> &research, bool cons
 
 	for (const std::string &r : research)
 	{
-		if (!haveReserchVector(_discovered, r))
+		if (!isResearched(r, false))
 		{
 			return false;
 		}
@@ -2114,26 +2383,15 @@ bool SavedGame::isResearched(const std::vector<const RuleResearch *> &research,
 		return true;
 	if (considerDebugMode && _debug)
 		return true;
-	std::vector<const RuleResearch *> matches = research;
-	if (skipDisabled)
+
+	for (auto& r : research)
 	{
 		// ignore all disabled topics (as if they didn't exist)
-		for (std::vector<const RuleResearch *>::iterator j = matches.begin(); j != matches.end();)
+		if (skipDisabled && isResearchRuleStatusDisabled(r))
 		{
-			if (isResearchRuleStatusDisabled((*j)->getName()))
-			{
-				j = matches.erase(j);
-			}
-			else
-			{
-				++j;
-			}
+			continue;
 		}
-	}
-
-	for (auto& r : matches)
-	{
-		if (!haveReserchVector(_discovered, r))
+		if (!isResearched(r, false))
 		{
 			return false;
 		}
@@ -145,7 +145,13 @@ private:
 	std::vector<AlienBase*> _alienBases;
 	AlienStrategy *_alienStrategy;
 	SavedBattleGame *_battleGame;
+	const Mod *_mod;
 	std::vector<const RuleResearch*> _discovered;
+	std::vector<bool> _discoveredBits, _disabledBits;
+	std::vector<int> _unlockedCount;
+	mutable std::vector<RuleResearch*> _availableResearchCache;
+	mutable std::vector<RuleManufacture*> _availableManufactureCache;
+	mutable bool _availableResearchValid, _availableManufactureValid;
 	std::map<std::string, int> _generatedEvents;
 	std::map<std::string, int> _ufopediaRuleStatus;
 	std::map<std::string, int> _manufactureRuleStatus;
@@ -174,11 +180,18 @@ private:
 	bool _alienContainmentChecked;
 	ScriptValues<SavedGame> _scriptValues;
 
-	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
+	static SaveInfo getSaveInfo(const std::string &file, const YAML::Node &doc, time_t timestamp, Language *lang);
+	static YAML::Node getSaveHeader(const std::string &fullname);
+	/// Rebuilds research bitsets from the discovered list and rule status.
+	void rebuildResearchState();
+	/// Adds or removes a research in the discovered list.
+	void setResearchDiscovered(const RuleResearch *research, bool discovered);
+	/// Gets research topics available in any base.
+	void getAvailableResearchCandidates(std::vector<RuleResearch*> & projects, const Mod *mod, bool considerDebugMode) const;
 public:
-	static const std::string AUTOSAVE_GEOSCAPE, AUTOSAVE_BATTLESCAPE, QUICKSAVE;
+	static const std::string AUTOSAVE_GEOSCAPE, AUTOSAVE_BATTLESCAPE, QUICKSAVE, SAVE_INDEX;
 	/// Creates a new saved game.
-	SavedGame();
+	SavedGame(const Mod *mod);
 	/// Cleans up the saved game.
 	~SavedGame();
 	/// Sanitizes a mod name in a save.
@@ -189,6 +202,12 @@ public:
 	void load(const std::string &filename, Mod *mod, Language *lang);
 	/// Saves a saved game to YAML.
 	void save(const std::string &filename, Mod *mod) const;
+	/// Serializes a saved game into YAML documents.
+	std::vector<YAML::Node> saveDocuments(Mod *mod) const;
+	/// Writes serialized YAML documents to a save file.
+	static void writeDocuments(const std::string &filename, const std::vector<YAML::Node> &docs);
+	/// Remembers the brief info of a save in the save index.
+	static void updateSaveIndex(const std::string &file, const YAML::Node &doc);
 	/// Gets the game name.
 	std::string getName() const;
 	/// Sets the game name.
@@ -307,6 +326,8 @@ public:
 	bool isResearchRuleStatusNew(const std::string &researchRule) const;
 	/// Is the research permanently disabled?
 	bool isResearchRuleStatusDisabled(const std::string &researchRule) const;
+	/// Is the research permanently disabled?
+	bool isResearchRuleStatusDisabled(const RuleResearch *researchRule) const;
 	/// Gets if a research still has undiscovered non-disabled "getOneFree".
 	bool hasUndiscoveredGetOneFree(const RuleResearch * r, bool checkOnlyAvailableTopics) const;
 	/// Gets if a research still has undiscovered non-disabled "protected unlocks".